@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/batch_kernels.h"
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+/** Number of elements each benchmark iteration works over. */
+constexpr std::size_t batch_size = 4096u;
+
+/**
+ * Create a batch of random points.
+ *
+ * @returns
+ *   Random points.
+ */
+std::vector<iris::Vector3> random_points()
+{
+    std::mt19937 rng{42u};
+    std::uniform_real_distribution<float> dist{-10.0f, 10.0f};
+    std::vector<iris::Vector3> points{};
+
+    for (auto i = 0u; i < batch_size; ++i)
+    {
+        points.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+
+    return points;
+}
+
+/**
+ * Create a batch of random unit quaternions.
+ *
+ * @param seed
+ *   Seed for random number generator.
+ *
+ * @returns
+ *   Random quaternions.
+ */
+std::vector<iris::Quaternion> random_quaternions(std::uint32_t seed)
+{
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    std::vector<iris::Quaternion> quaternions{};
+
+    for (auto i = 0u; i < batch_size; ++i)
+    {
+        quaternions.emplace_back(iris::Quaternion{dist(rng), dist(rng), dist(rng), dist(rng)}.normalise());
+    }
+
+    return quaternions;
+}
+
+const iris::Matrix4 matrix =
+    iris::Matrix4::make_translate({1.0f, 2.0f, 3.0f}) * iris::Matrix4{iris::Quaternion{{0.0f, 1.0f, 0.0f}, 0.5f}};
+
+}
+
+static void BM_transform_points_loop(benchmark::State &state)
+{
+    const auto points = random_points();
+    std::vector<iris::Vector3> out(batch_size);
+
+    for (auto _ : state)
+    {
+        for (auto i = 0u; i < batch_size; ++i)
+        {
+            out[i] = matrix * points[i];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_transform_points_batch(benchmark::State &state)
+{
+    const auto points = random_points();
+    std::vector<iris::Vector3> out(batch_size);
+
+    for (auto _ : state)
+    {
+        iris::transform_points(matrix, points, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_transform_points_batch_soa(benchmark::State &state)
+{
+    const auto points = random_points();
+    std::vector<float> x{};
+    std::vector<float> y{};
+    std::vector<float> z{};
+
+    for (const auto &point : points)
+    {
+        x.emplace_back(point.x);
+        y.emplace_back(point.y);
+        z.emplace_back(point.z);
+    }
+
+    std::vector<float> out_x(batch_size);
+    std::vector<float> out_y(batch_size);
+    std::vector<float> out_z(batch_size);
+
+    for (auto _ : state)
+    {
+        iris::transform_points(matrix, {x, y, z}, {out_x, out_y, out_z});
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_normalise_quaternions_loop(benchmark::State &state)
+{
+    auto quaternions = random_quaternions(1u);
+
+    for (auto _ : state)
+    {
+        for (auto &q : quaternions)
+        {
+            q.normalise();
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_normalise_quaternions_batch(benchmark::State &state)
+{
+    auto quaternions = random_quaternions(1u);
+
+    for (auto _ : state)
+    {
+        iris::normalise_quaternions(quaternions);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_slerp_quaternions_loop(benchmark::State &state)
+{
+    const auto from = random_quaternions(1u);
+    const auto to = random_quaternions(2u);
+    std::vector<iris::Quaternion> out(batch_size);
+
+    for (auto _ : state)
+    {
+        for (auto i = 0u; i < batch_size; ++i)
+        {
+            out[i] = from[i];
+            out[i].slerp(to[i], 0.3f);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_slerp_quaternions_batch(benchmark::State &state)
+{
+    const auto from = random_quaternions(1u);
+    const auto to = random_quaternions(2u);
+    std::vector<iris::Quaternion> out(batch_size);
+
+    for (auto _ : state)
+    {
+        iris::slerp_quaternions(from, to, 0.3f, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_transform_points_loop);
+BENCHMARK(BM_transform_points_batch);
+BENCHMARK(BM_transform_points_batch_soa);
+BENCHMARK(BM_normalise_quaternions_loop);
+BENCHMARK(BM_normalise_quaternions_batch);
+BENCHMARK(BM_slerp_quaternions_loop);
+BENCHMARK(BM_slerp_quaternions_batch);
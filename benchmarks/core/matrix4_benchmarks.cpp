@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/matrix4_kernels.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+/** Number of matrices each benchmark iteration works over. */
+constexpr std::size_t batch_size = 256u;
+
+/**
+ * Create a batch of random matrices.
+ *
+ * @returns
+ *   Random matrices.
+ */
+std::vector<iris::matrix4_kernels::Elements> random_matrices()
+{
+    std::mt19937 rng{42u};
+    std::uniform_real_distribution<float> dist{-10.0f, 10.0f};
+    std::vector<iris::matrix4_kernels::Elements> matrices(batch_size);
+
+    for (auto &m : matrices)
+    {
+        for (auto &e : m)
+        {
+            e = dist(rng);
+        }
+    }
+
+    return matrices;
+}
+
+struct Scalar
+{
+    static auto multiply(const auto &a, const auto &b)
+    {
+        return iris::matrix4_kernels::multiply_scalar(a, b);
+    }
+
+    static auto invert(const auto &m)
+    {
+        return iris::matrix4_kernels::invert_scalar(m);
+    }
+
+    static auto transpose(const auto &m)
+    {
+        return iris::matrix4_kernels::transpose_scalar(m);
+    }
+
+    static auto transform(const auto &m, const auto &v)
+    {
+        return iris::matrix4_kernels::transform_scalar(m, v);
+    }
+};
+
+#if defined(IRIS_SIMD)
+
+struct Simd
+{
+    static auto multiply(const auto &a, const auto &b)
+    {
+        return iris::matrix4_kernels::multiply_simd(a, b);
+    }
+
+    static auto invert(const auto &m)
+    {
+        return iris::matrix4_kernels::invert_simd(m);
+    }
+
+    static auto transpose(const auto &m)
+    {
+        return iris::matrix4_kernels::transpose_simd(m);
+    }
+
+    static auto transform(const auto &m, const auto &v)
+    {
+        return iris::matrix4_kernels::transform_simd(m, v);
+    }
+};
+
+#endif
+
+}
+
+template <class K>
+static void BM_matrix4_multiply(benchmark::State &state)
+{
+    const auto matrices = random_matrices();
+
+    for (auto _ : state)
+    {
+        for (auto i = 0u; i < batch_size; ++i)
+        {
+            benchmark::DoNotOptimize(K::multiply(matrices[i], matrices[batch_size - 1u - i]));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+template <class K>
+static void BM_matrix4_invert(benchmark::State &state)
+{
+    const auto matrices = random_matrices();
+
+    for (auto _ : state)
+    {
+        for (const auto &m : matrices)
+        {
+            benchmark::DoNotOptimize(K::invert(m));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+template <class K>
+static void BM_matrix4_transpose(benchmark::State &state)
+{
+    const auto matrices = random_matrices();
+
+    for (auto _ : state)
+    {
+        for (const auto &m : matrices)
+        {
+            benchmark::DoNotOptimize(K::transpose(m));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+template <class K>
+static void BM_matrix4_transform(benchmark::State &state)
+{
+    const auto matrices = random_matrices();
+
+    for (auto _ : state)
+    {
+        for (const auto &m : matrices)
+        {
+            benchmark::DoNotOptimize(K::transform(m, iris::Vector3{m[15], m[14], m[13]}));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK_TEMPLATE(BM_matrix4_multiply, Scalar);
+BENCHMARK_TEMPLATE(BM_matrix4_invert, Scalar);
+BENCHMARK_TEMPLATE(BM_matrix4_transpose, Scalar);
+BENCHMARK_TEMPLATE(BM_matrix4_transform, Scalar);
+
+#if defined(IRIS_SIMD)
+BENCHMARK_TEMPLATE(BM_matrix4_multiply, Simd);
+BENCHMARK_TEMPLATE(BM_matrix4_invert, Simd);
+BENCHMARK_TEMPLATE(BM_matrix4_transpose, Simd);
+BENCHMARK_TEMPLATE(BM_matrix4_transform, Simd);
+#endif
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include "core/object_pool.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+/** Number of objects each thread holds at once. */
+constexpr std::size_t batch_size = 16u;
+
+/**
+ * Allocates objects from an ObjectPool shared by all benchmark threads.
+ */
+struct PoolAllocator
+{
+    static iris::Vector3 *create(float value)
+    {
+        return pool().next(value, value, value);
+    }
+
+    static void destroy(iris::Vector3 *object)
+    {
+        pool().release(object);
+    }
+
+    static iris::ObjectPool<iris::Vector3> &pool()
+    {
+        static iris::ObjectPool<iris::Vector3> pool{};
+        return pool;
+    }
+};
+
+/**
+ * Allocates objects with new/delete.
+ */
+struct NewDeleteAllocator
+{
+    static iris::Vector3 *create(float value)
+    {
+        return new iris::Vector3{value, value, value};
+    }
+
+    static void destroy(iris::Vector3 *object)
+    {
+        delete object;
+    }
+};
+
+}
+
+// every thread repeatedly creates a small batch of objects and then destroys them in a different order, which is
+// roughly the pattern of the lua interop types
+template <class A>
+static void BM_object_pool_churn(benchmark::State &state)
+{
+    std::array<iris::Vector3 *, batch_size> objects{};
+
+    for (auto _ : state)
+    {
+        for (auto i = 0u; i < batch_size; ++i)
+        {
+            objects[i] = A::create(static_cast<float>(i));
+        }
+
+        benchmark::DoNotOptimize(objects.data());
+
+        for (auto i = 0u; i < batch_size; i += 2u)
+        {
+            A::destroy(objects[i]);
+        }
+        for (auto i = 1u; i < batch_size; i += 2u)
+        {
+            A::destroy(objects[i]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK_TEMPLATE(BM_object_pool_churn, PoolAllocator)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_object_pool_churn, NewDeleteAllocator)->ThreadRange(1, 16)->UseRealTime();
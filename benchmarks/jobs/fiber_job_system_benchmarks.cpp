@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/job_system_benchmarks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_job_system_manager.h"
+#include "jobs/job.h"
+
+BENCHMARK_TEMPLATE(BM_job_system_fan_out, iris::FiberJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_fan_out_inline, iris::FiberJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_wait_latency, iris::FiberJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_external_wait, iris::FiberJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_task_chain, iris::FiberJobSystemManager)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_run_chunks, iris::FiberJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_idle_wake, iris::FiberJobSystem)->Apply(idle_policy_args)->UseManualTime();
+
+// same as fan out but with a fixed number of workers and varying fiber pool size, a pool size of zero means every job
+// creates a new fiber (and stack)
+static void BM_fiber_job_system_fan_out_pool_size(benchmark::State &state)
+{
+    static constexpr auto job_count = 1000u;
+
+    const auto worker_count = std::max(1u, std::thread::hardware_concurrency() - 1u);
+    iris::FiberJobSystem js{worker_count, static_cast<std::size_t>(state.range(0))};
+    std::atomic<std::uint32_t> sink = 0u;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0u; i < job_count; ++i)
+    {
+        jobs.emplace_back([i, &sink]() { sink.fetch_add(small_work(i), std::memory_order_relaxed); });
+    }
+
+    for (auto _ : state)
+    {
+        js.wait_for_jobs({[&js, &jobs]() { js.wait_for_jobs(jobs); }});
+    }
+
+    const auto stats = js.fiber_pool_stats();
+
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * job_count);
+    state.counters["pool_hits"] = static_cast<double>(stats.hits);
+    state.counters["pool_misses"] = static_cast<double>(stats.misses);
+    state.counters["peak_live_fibers"] = static_cast<double>(stats.peak_live);
+}
+BENCHMARK(BM_fiber_job_system_fan_out_pool_size)->Arg(0)->Arg(256)->Arg(1024)->UseRealTime();
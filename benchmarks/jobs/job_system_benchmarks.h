@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// workloads shared by all JobSystem implementations, so backends can be compared like for like
+// each backend instantiates these with BENCHMARK_TEMPLATE
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+#include "jobs/job_system_manager.h"
+#include "jobs/task.h"
+
+namespace
+{
+
+/**
+ * Register a range of worker counts, from one up to the number of cores.
+ *
+ * @param bm
+ *   Benchmark to register arguments for.
+ */
+void worker_counts(benchmark::internal::Benchmark *bm)
+{
+    const auto cores = std::max(1u, std::thread::hardware_concurrency());
+
+    for (auto workers = 1u; workers < cores; workers *= 2u)
+    {
+        bm->Arg(workers);
+    }
+
+    bm->Arg(cores);
+}
+
+/**
+ * Small amount of work for each job, enough that scheduling overhead dominates.
+ *
+ * @param seed
+ *   Value to start from.
+ *
+ * @returns
+ *   Some number.
+ */
+std::uint32_t small_work(std::uint32_t seed)
+{
+    for (auto i = 0u; i < 256u; ++i)
+    {
+        seed = (seed * 1664525u) + 1013904223u;
+    }
+
+    return seed;
+}
+
+/**
+ * Register every idle policy (by index into idle_policies) with a range of gaps between jobs, in microseconds.
+ *
+ * @param bm
+ *   Benchmark to register arguments for.
+ */
+void idle_policy_args(benchmark::internal::Benchmark *bm)
+{
+    bm->ArgNames({"policy", "gap_us"});
+
+    for (auto policy = 0; policy < 3; ++policy)
+    {
+        for (const auto gap : {10, 100, 1000})
+        {
+            bm->Args({policy, gap});
+        }
+    }
+}
+
+/** Policies compared by BM_job_system_idle_wake. */
+constexpr std::array<iris::IdlePolicy, 3u> idle_policies{
+    {iris::IdlePolicy::low_power(), iris::IdlePolicy::balanced(), iris::IdlePolicy::low_latency()}};
+
+}
+
+// fan out a large number of small jobs from inside a job, this exercises the paths used when jobs create more jobs
+template <class T>
+static void BM_job_system_fan_out(benchmark::State &state)
+{
+    static constexpr auto job_count = 1000u;
+
+    T js{static_cast<std::uint32_t>(state.range(0))};
+    std::atomic<std::uint32_t> sink = 0u;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0u; i < job_count; ++i)
+    {
+        jobs.emplace_back([i, &sink]() { sink.fetch_add(small_work(i), std::memory_order_relaxed); });
+    }
+
+    for (auto _ : state)
+    {
+        js.wait_for_jobs({[&js, &jobs]() { js.wait_for_jobs(jobs); }});
+    }
+
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * job_count);
+}
+
+// same as fan out but using InlineJob, so no allocations are made per job
+template <class T>
+static void BM_job_system_fan_out_inline(benchmark::State &state)
+{
+    static constexpr auto job_count = 1000u;
+
+    T js{static_cast<std::uint32_t>(state.range(0))};
+    std::atomic<std::uint32_t> sink = 0u;
+    std::array<iris::InlineJob, job_count> jobs{};
+
+    for (auto _ : state)
+    {
+        js.wait_for_jobs({[&js, &jobs, &sink]() {
+            // jobs are consumed, so they have to be recreated each iteration
+            for (auto i = 0u; i < job_count; ++i)
+            {
+                jobs[i] = [i, &sink]() { sink.fetch_add(small_work(i), std::memory_order_relaxed); };
+            }
+
+            js.wait_for_jobs(jobs);
+        }});
+    }
+
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * job_count);
+}
+
+// a job repeatedly waiting on a single child, this measures the round trip from the child finishing to the parent
+// continuing
+template <class T>
+static void BM_job_system_wait_latency(benchmark::State &state)
+{
+    static constexpr auto wait_count = 1000u;
+
+    T js{static_cast<std::uint32_t>(state.range(0))};
+    std::atomic<std::uint32_t> sink = 0u;
+
+    for (auto _ : state)
+    {
+        js.wait_for_jobs({[&js, &sink]() {
+            for (auto i = 0u; i < wait_count; ++i)
+            {
+                js.wait_for_jobs({[&sink]() { sink.fetch_add(1u, std::memory_order_relaxed); }});
+            }
+        }});
+    }
+
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * wait_count);
+}
+
+// a coroutine repeatedly hopping onto a worker, this is the same round trip as BM_job_system_wait_latency but with
+// nothing blocked (and no stack held) whilst waiting, templated on a JobSystemManager
+template <class T>
+static void BM_job_system_task_chain(benchmark::State &state)
+{
+    static constexpr auto hop_count = 1000u;
+
+    T jsm{};
+    jsm.create_job_system();
+    std::atomic<std::uint32_t> sink = 0u;
+
+    const auto chain = [](iris::JobSystemManager &jobs, std::atomic<std::uint32_t> &sink) -> iris::Task<>
+    {
+        for (auto i = 0u; i < hop_count; ++i)
+        {
+            co_await iris::schedule_on(jobs);
+            sink.fetch_add(1u, std::memory_order_relaxed);
+        }
+    };
+
+    for (auto _ : state)
+    {
+        iris::sync_wait(jsm, chain(jsm, sink));
+    }
+
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * hop_count);
+}
+
+// add jobs from outside of the job system
+template <class T>
+static void BM_job_system_external_wait(benchmark::State &state)
+{
+    static constexpr auto job_count = 1000u;
+
+    T js{static_cast<std::uint32_t>(state.range(0))};
+    std::atomic<std::uint32_t> sink = 0u;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0u; i < job_count; ++i)
+    {
+        jobs.emplace_back([i, &sink]() { sink.fetch_add(small_work(i), std::memory_order_relaxed); });
+    }
+
+    for (auto _ : state)
+    {
+        js.wait_for_jobs(jobs);
+    }
+
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * job_count);
+}
+
+// split a loop into a few chunks per worker, as parallel_for does
+template <class T>
+static void BM_job_system_run_chunks(benchmark::State &state)
+{
+    static constexpr auto item_count = 100000u;
+
+    T js{static_cast<std::uint32_t>(state.range(0))};
+    std::atomic<std::uint32_t> sink = 0u;
+
+    const auto chunk_count = std::size_t{js.worker_count()} * 4u;
+    const auto chunk_size = (item_count + chunk_count - 1u) / chunk_count;
+
+    for (auto _ : state)
+    {
+        js.run_chunks(
+            chunk_count,
+            [chunk_size, &sink](std::size_t chunk)
+            {
+                const auto begin = chunk * chunk_size;
+                const auto end = std::min(begin + chunk_size, std::size_t{item_count});
+                auto value = 0u;
+
+                for (auto i = begin; i < end; ++i)
+                {
+                    value += small_work(static_cast<std::uint32_t>(i));
+                }
+
+                sink.fetch_add(value, std::memory_order_relaxed);
+            });
+    }
+
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * item_count);
+}
+
+// submit a single job after the workers have been idle for a while and time how long it takes to start, this is the
+// wake up latency of the idle policy
+// cpu_utilisation is process CPU time over wall time (including the submitting thread), so shows what the policy costs
+// whilst idle
+template <class T>
+static void BM_job_system_idle_wake(benchmark::State &state)
+{
+    const auto worker_count = std::max(1u, std::thread::hardware_concurrency() - 1u);
+    const auto gap = std::chrono::microseconds(state.range(1));
+
+    T js{worker_count};
+    js.set_idle_policy(idle_policies[static_cast<std::size_t>(state.range(0))]);
+
+    std::atomic<std::chrono::steady_clock::rep> started = 0;
+
+    const auto cpu_start = std::clock();
+    const auto wall_start = std::chrono::steady_clock::now();
+
+    for (auto _ : state)
+    {
+        std::this_thread::sleep_for(gap);
+
+        started = 0;
+        const auto submitted = std::chrono::steady_clock::now();
+
+        std::array<iris::InlineJob, 1u> jobs{
+            {[&started]() { started = std::chrono::steady_clock::now().time_since_epoch().count(); }}};
+        js.add_jobs(jobs);
+
+        while (started == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        const auto latency =
+            std::chrono::steady_clock::duration(started.load()) - submitted.time_since_epoch();
+        state.SetIterationTime(std::chrono::duration<double>(latency).count());
+    }
+
+    const auto cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    const auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    state.counters["cpu_utilisation"] = cpu / wall;
+}
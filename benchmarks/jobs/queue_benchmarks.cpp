@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "jobs/concurrent_queue.h"
+#include "jobs/mpmc_queue.h"
+
+namespace
+{
+
+/**
+ * Get the queue shared by all benchmark threads.
+ *
+ * @returns
+ *   Shared queue.
+ */
+template <class Q>
+Q &shared_queue()
+{
+    static Q queue{};
+    return queue;
+}
+
+}
+
+// every thread repeatedly enqueues a value and then dequeues one, so all threads are contending on both ends of the
+// same queue, dequeues can fail if another thread got there first so keep trying until we get a value
+template <class Q>
+static void BM_queue_contention(benchmark::State &state)
+{
+    auto &queue = shared_queue<Q>();
+    int value = 0;
+
+    for (auto _ : state)
+    {
+        queue.enqueue(state.thread_index());
+
+        while (!queue.try_dequeue(value))
+        {
+            std::this_thread::yield();
+        }
+
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_queue_contention, iris::ConcurrentQueue<int>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_queue_contention, iris::MpmcQueue<int>)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/job_system_benchmarks.h"
+
+#include "jobs/thread/thread_job_system.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+BENCHMARK_TEMPLATE(BM_job_system_fan_out, iris::ThreadJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_fan_out_inline, iris::ThreadJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_wait_latency, iris::ThreadJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_external_wait, iris::ThreadJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_task_chain, iris::ThreadJobSystemManager)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_run_chunks, iris::ThreadJobSystem)->Apply(worker_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_job_system_idle_wake, iris::ThreadJobSystem)->Apply(idle_policy_args)->UseManualTime();
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include "core/resource_archive.h"
+#include "core/resource_manager.h"
+#include "core/resource_view.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of ResourceManager which loads resources from a single packed archive (see ResourceArchive), rather
+ * than opening a file per resource. Resources are named as they were when the archive was packed, the root directory
+ * is ignored.
+ */
+class ArchiveResourceManager : public ResourceManager
+{
+  public:
+    /**
+     * Construct a new ArchiveResourceManager.
+     *
+     * @param archive
+     *   Path of archive to load resources from.
+     */
+    explicit ArchiveResourceManager(const std::filesystem::path &archive);
+
+  protected:
+    /**
+     * Read a resource from the archive.
+     *
+     * @param resource
+     *   Name of resource.
+     *
+     * @returns
+     *   View of resource data.
+     */
+    ResourceView do_load(std::string_view resource) override;
+
+  private:
+    /** Archive to load from. */
+    ResourceArchive archive_;
+};
+
+}
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/vector3.h"
+
+// kernels for applying the same operation to many elements at once, these process several elements per iteration
+// with SIMD (where available) so hot loops can make one call rather than use the per-object operators
+//
+// each kernel takes either spans of the usual types or structure-of-arrays views, the latter avoid having to shuffle
+// data in and out of registers so are the fastest option for data that is already stored that way
+//
+// unless stated otherwise outputs may alias inputs, and results match the per-object operators
+
+namespace iris
+{
+
+/**
+ * Structure-of-arrays view of Vector3 data, every span must be the same size.
+ */
+template <class T>
+struct BasicVector3SoaView
+{
+    /** x components. */
+    std::span<T> x;
+
+    /** y components. */
+    std::span<T> y;
+
+    /** z components. */
+    std::span<T> z;
+
+    /**
+     * Get number of elements in view.
+     *
+     * @returns
+     *   Number of elements.
+     */
+    std::size_t size() const
+    {
+        return x.size();
+    }
+};
+
+/**
+ * Structure-of-arrays view of Quaternion data, every span must be the same size.
+ */
+template <class T>
+struct BasicQuaternionSoaView
+{
+    /** w components. */
+    std::span<T> w;
+
+    /** x components. */
+    std::span<T> x;
+
+    /** y components. */
+    std::span<T> y;
+
+    /** z components. */
+    std::span<T> z;
+
+    /**
+     * Get number of elements in view.
+     *
+     * @returns
+     *   Number of elements.
+     */
+    std::size_t size() const
+    {
+        return w.size();
+    }
+};
+
+using Vector3SoaView = BasicVector3SoaView<float>;
+using ConstVector3SoaView = BasicVector3SoaView<const float>;
+using QuaternionSoaView = BasicQuaternionSoaView<float>;
+using ConstQuaternionSoaView = BasicQuaternionSoaView<const float>;
+
+/**
+ * Transform points by a matrix, equivalent to out[i] = matrix * in[i].
+ *
+ * @param matrix
+ *   Matrix to transform by.
+ *
+ * @param in
+ *   Points to transform.
+ *
+ * @param out
+ *   Where to write transformed points, must be the same size as in.
+ */
+void transform_points(const Matrix4 &matrix, std::span<const Vector3> in, std::span<Vector3> out);
+
+/**
+ * Transform points by a matrix, equivalent to out[i] = matrix * in[i].
+ *
+ * @param matrix
+ *   Matrix to transform by.
+ *
+ * @param in
+ *   Points to transform.
+ *
+ * @param out
+ *   Where to write transformed points, must be the same size as in.
+ */
+void transform_points(const Matrix4 &matrix, ConstVector3SoaView in, Vector3SoaView out);
+
+/**
+ * Multiply pairs of matrices, equivalent to out[i] = lhs[i] * rhs[i].
+ *
+ * @param lhs
+ *   Left hand matrices.
+ *
+ * @param rhs
+ *   Right hand matrices, must be the same size as lhs.
+ *
+ * @param out
+ *   Where to write results, must be the same size as lhs.
+ */
+void multiply_matrices(std::span<const Matrix4> lhs, std::span<const Matrix4> rhs, std::span<Matrix4> out);
+
+/**
+ * Multiply matrices by a common matrix, equivalent to out[i] = lhs * rhs[i]. Useful for e.g. applying a parent
+ * transform to many children.
+ *
+ * @param lhs
+ *   Left hand matrix.
+ *
+ * @param rhs
+ *   Right hand matrices.
+ *
+ * @param out
+ *   Where to write results, must be the same size as rhs.
+ */
+void multiply_matrices(const Matrix4 &lhs, std::span<const Matrix4> rhs, std::span<Matrix4> out);
+
+/**
+ * Normalise quaternions in place, equivalent to calling Quaternion::normalise on each.
+ *
+ * @param quaternions
+ *   Quaternions to normalise.
+ */
+void normalise_quaternions(std::span<Quaternion> quaternions);
+
+/**
+ * Normalise quaternions in place, equivalent to calling Quaternion::normalise on each.
+ *
+ * @param quaternions
+ *   Quaternions to normalise.
+ */
+void normalise_quaternions(QuaternionSoaView quaternions);
+
+/**
+ * Spherical linear interpolation of pairs of quaternions, equivalent to out[i] = from[i].slerp(to[i], amount).
+ *
+ * Results are within rounding of Quaternion::slerp, but not always identical.
+ *
+ * @param from
+ *   Quaternions to interpolate from.
+ *
+ * @param to
+ *   Quaternions to interpolate towards, must be the same size as from.
+ *
+ * @param amount
+ *   Amount to interpolate, must be in range [0.0, 1.0].
+ *
+ * @param out
+ *   Where to write results, must be the same size as from.
+ */
+void slerp_quaternions(
+    std::span<const Quaternion> from,
+    std::span<const Quaternion> to,
+    float amount,
+    std::span<Quaternion> out);
+
+/**
+ * Spherical linear interpolation of pairs of quaternions, equivalent to out[i] = from[i].slerp(to[i], amount).
+ *
+ * Results are within rounding of Quaternion::slerp, but not always identical.
+ *
+ * @param from
+ *   Quaternions to interpolate from.
+ *
+ * @param to
+ *   Quaternions to interpolate towards, must be the same size as from.
+ *
+ * @param amount
+ *   Amount to interpolate, must be in range [0.0, 1.0].
+ *
+ * @param out
+ *   Where to write results, must be the same size as from.
+ */
+void slerp_quaternions(ConstQuaternionSoaView from, ConstQuaternionSoaView to, float amount, QuaternionSoaView out);
+
+}
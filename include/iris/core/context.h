@@ -11,6 +11,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "jobs/job_system_config.h"
+
 namespace iris
 {
 
@@ -60,6 +62,14 @@ class Context
      */
     const std::vector<std::string> &args() const;
 
+    /**
+     * Get the config used for the job system, this is read from the program arguments (see parse_job_system_config).
+     *
+     * @returns
+     *   Job system config.
+     */
+    const JobSystemConfig &job_system_config() const;
+
     /**
      * Get the current WindowManager.
      *
@@ -294,6 +304,9 @@ class Context
 
     /** Collection of program arguments. */
     std::vector<std::string> args_;
+
+    /** Config for job system, read from args_. */
+    JobSystemConfig job_system_config_;
 };
 
 }
@@ -8,28 +8,29 @@
 
 #include <string_view>
 
-#include "core/data_buffer.h"
 #include "core/resource_manager.h"
+#include "core/resource_view.h"
 
 namespace iris
 {
 
 /**
- * Implementation of ResourceManager which loads resources off disk, relative to root.
+ * Implementation of ResourceManager which loads resources off disk, relative to root. Files are memory mapped, so
+ * their contents are only read when first accessed and are never copied.
  */
 class DefaultResourceManager : public ResourceManager
 {
   protected:
     /**
-     * Load data frm disk.
+     * Map a file from disk.
      *
      * @param resource
      *   Name of resource.
      *
      * @returns
-     *   Loaded data.
+     *   View of mapped file.
      */
-    DataBuffer do_load(std::string_view resource) override;
+    ResourceView do_load(std::string_view resource) override;
 };
 
 }
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+namespace iris
+{
+
+class FrameArena;
+
+/**
+ * Adapter exposing a FrameArena as a std::pmr::memory_resource, so pmr containers can opt in to arena allocation.
+ * Deallocation is a no-op, memory is only reclaimed when the arena is reset.
+ */
+class FrameArenaResource : public std::pmr::memory_resource
+{
+  public:
+    /**
+     * Construct a new FrameArenaResource.
+     *
+     * @param arena
+     *   Arena to allocate from, must outlive this object.
+     */
+    explicit FrameArenaResource(FrameArena &arena);
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void *, std::size_t, std::size_t) override;
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    /** Arena to allocate from. */
+    FrameArena &arena_;
+};
+
+/**
+ * Snapshot of the usage of a FrameArena.
+ */
+struct FrameArenaStats
+{
+    /** Bytes handed out since the last reset. */
+    std::size_t bytes_allocated;
+
+    /** Most bytes handed out between two resets. */
+    std::size_t high_water_mark;
+
+    /** Bytes currently reserved from the system. */
+    std::size_t capacity;
+};
+
+/**
+ * A bump allocator for short lived allocations. Allocating is a pointer increment, individual allocations are never
+ * freed, instead everything is released in one go by reset(). This makes it suitable for scratch memory that only
+ * lives for a frame.
+ *
+ * Memory is reserved in blocks, if an allocation does not fit then a new block is reserved. On reset any extra blocks
+ * are merged into a single block big enough for the high-water mark, so once warmed up a frame does not touch the
+ * system allocator at all.
+ *
+ * When poisoning is enabled (the default in debug builds) memory is filled with a pattern when it's handed out and
+ * again when it's reset, so uninitialised reads and use-after-reset show up quickly.
+ *
+ * A FrameArena is not thread safe, the stats may be read from any thread.
+ */
+class FrameArena
+{
+  public:
+    /** Byte written to memory when it is handed out. */
+    static constexpr std::uint8_t allocated_poison = 0xcd;
+
+    /** Byte written to memory when the arena is reset. */
+    static constexpr std::uint8_t reset_poison = 0xdd;
+
+    /**
+     * Construct a new FrameArena, poisoning is enabled in debug builds.
+     *
+     * @param block_size
+     *   Size of the initial block, and minimum size of any new block.
+     */
+    explicit FrameArena(std::size_t block_size = 64u * 1024u);
+
+    /**
+     * Construct a new FrameArena.
+     *
+     * @param block_size
+     *   Size of the initial block, and minimum size of any new block.
+     *
+     * @param poison
+     *   True if memory should be poisoned, false otherwise.
+     */
+    FrameArena(std::size_t block_size, bool poison);
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+    FrameArena(FrameArena &&) = delete;
+    FrameArena &operator=(FrameArena &&) = delete;
+
+    /**
+     * Allocate memory from the arena.
+     *
+     * @param size
+     *   Number of bytes to allocate.
+     *
+     * @param alignment
+     *   Alignment of memory, must be a power of two.
+     *
+     * @returns
+     *   Pointer to memory, valid until the next reset.
+     */
+    void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Release all allocations. Any memory previously handed out must not be used after this call.
+     */
+    void reset();
+
+    /**
+     * Get the arena as a pmr memory resource.
+     *
+     * @returns
+     *   Memory resource for this arena.
+     */
+    std::pmr::memory_resource *resource();
+
+    /**
+     * Get a snapshot of the arena usage.
+     *
+     * @returns
+     *   Arena stats.
+     */
+    FrameArenaStats stats() const;
+
+  private:
+    /**
+     * A single block of reserved memory.
+     */
+    struct Block
+    {
+        /** Memory for block. */
+        std::unique_ptr<std::byte[]> memory;
+
+        /** Size of block in bytes. */
+        std::size_t size;
+    };
+
+    /**
+     * Reserve a new block and make it the current one.
+     *
+     * @param size
+     *   Minimum size of block.
+     */
+    void add_block(std::size_t size);
+
+    /** Minimum size of a block. */
+    std::size_t block_size_;
+
+    /** Flag indicating if memory should be poisoned. */
+    bool poison_;
+
+    /** Reserved blocks, the last one is the one being allocated from. */
+    std::vector<Block> blocks_;
+
+    /** Offset of the next free byte in the current block. */
+    std::size_t offset_;
+
+    /** Bytes used in all blocks before the current one. */
+    std::size_t previous_blocks_used_;
+
+    /** Bytes handed out since last reset, includes alignment padding. */
+    std::atomic<std::size_t> bytes_allocated_;
+
+    /** Most bytes handed out between two resets. */
+    std::atomic<std::size_t> high_water_mark_;
+
+    /** Total size of all blocks. */
+    std::atomic<std::size_t> capacity_;
+
+    /** Adapter for pmr containers. */
+    FrameArenaResource resource_;
+};
+
+/**
+ * Stats for the frame arena of a single thread.
+ */
+struct ThreadFrameArenaStats
+{
+    /** Id of thread. */
+    std::thread::id thread;
+
+    /** Stats for thread's arena. */
+    FrameArenaStats stats;
+};
+
+/**
+ * Get the frame arena for the calling thread, creating it if needed. Memory from it is valid until the thread reaches
+ * a safe point (see reclaim_frame_arena) after the next call to advance_frame().
+ *
+ * Note that memory must not be held across anything that could move the caller to another thread (e.g. a fiber
+ * waiting on other jobs).
+ *
+ * @returns
+ *   Arena for calling thread.
+ */
+FrameArena &this_thread_frame_arena();
+
+/**
+ * Get the frame arena for the calling thread as a pmr memory resource, see this_thread_frame_arena.
+ *
+ * @returns
+ *   Memory resource for calling thread.
+ */
+std::pmr::memory_resource *frame_resource();
+
+/**
+ * Mark the end of a frame. The arena of the calling thread (which should be the main thread) is reset immediately,
+ * every other thread's arena is reset the next time it calls reclaim_frame_arena().
+ */
+void advance_frame();
+
+/**
+ * Reset the frame arena of the calling thread if advance_frame() has been called since it was last reset. Job system
+ * workers call this between jobs, any other long lived thread using its frame arena should call it at a point where
+ * it holds no arena memory.
+ */
+void reclaim_frame_arena();
+
+/**
+ * Get the stats for the frame arena of every thread that has one.
+ *
+ * @returns
+ *   Stats for each thread.
+ */
+std::vector<ThreadFrameArenaStats> frame_arena_stats();
+
+}
@@ -8,8 +8,8 @@
 
 #include <string_view>
 
-#include "core/data_buffer.h"
 #include "core/resource_manager.h"
+#include "core/resource_view.h"
 
 namespace iris
 {
@@ -27,9 +27,9 @@ class IOSResourceManager : public ResourceManager
      *   Name of resource.
      *
      * @returns
-     *   Loaded data.
+     *   View of mapped file.
      */
-    DataBuffer do_load(std::string_view resource) override;
+    ResourceView do_load(std::string_view resource) override;
 };
 
 }
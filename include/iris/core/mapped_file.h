@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace iris
+{
+
+/**
+ * A file mapped read-only into memory. Pages are only read from disk when they are first accessed and are shared with
+ * the OS file cache, so the contents can be used in place without copying them into a heap allocation.
+ *
+ * The mapping is released when the object is destroyed.
+ */
+class MappedFile
+{
+  public:
+    /**
+     * Map a file.
+     *
+     * @param path
+     *   Path of file to map.
+     */
+    explicit MappedFile(const std::filesystem::path &path);
+
+    /**
+     * Unmap the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+    MappedFile &operator=(MappedFile &&) = delete;
+
+    /**
+     * Get the contents of the file.
+     *
+     * @returns
+     *   View of the mapped file, valid for the lifetime of this object.
+     */
+    std::span<const std::byte> data() const;
+
+    /**
+     * Get the size of the file.
+     *
+     * @returns
+     *   Size of file in bytes.
+     */
+    std::size_t size() const;
+
+  private:
+    /** Pointer to implementation. */
+    struct implementation;
+    std::unique_ptr<implementation> impl_;
+};
+
+}
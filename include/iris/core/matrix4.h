@@ -10,6 +10,7 @@
 #include <cmath>
 #include <ostream>
 
+#include "core/matrix4_kernels.h"
 #include "core/quaternion.h"
 #include "core/utils.h"
 #include "core/vector3.h"
@@ -20,7 +21,8 @@ namespace iris
 /**
  * Class represents a 4x4 matrix.
  *
- * This is a header only class to allow for constexpr methods.
+ * This is a header only class to allow for constexpr methods. The heavier operations use SIMD at runtime, see
+ * matrix4_kernels.h.
  */
 class Matrix4
 {
@@ -279,69 +281,7 @@ class Matrix4
      */
     constexpr static Matrix4 invert(const Matrix4 &m)
     {
-        Matrix4 inv{};
-
-        inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] +
-                 m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
-
-        inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] -
-                 m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
-
-        inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] +
-                 m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
-
-        inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] -
-                  m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
-
-        inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] -
-                 m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
-
-        inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] +
-                 m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
-
-        inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] -
-                 m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
-
-        inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] +
-                  m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
-
-        inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] +
-                 m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
-
-        inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] -
-                 m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
-
-        inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] +
-                  m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
-
-        inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] -
-                  m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
-
-        inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] -
-                 m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
-
-        inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] +
-                 m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
-
-        inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] -
-                  m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
-
-        inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] +
-                  m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
-
-        auto det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
-
-        if (det != 0.0f)
-        {
-            det = 1.0f / det;
-
-            for (auto i = 0; i < 16; i++)
-            {
-                inv[i] *= det;
-            }
-        }
-
-        return inv;
+        return Matrix4{matrix4_kernels::invert(m.elements_)};
     }
 
     /**
@@ -355,16 +295,29 @@ class Matrix4
      */
     constexpr static Matrix4 transpose(const Matrix4 &matrix)
     {
-        auto m{matrix};
+        return Matrix4{matrix4_kernels::transpose(matrix.elements_)};
+    }
+
+    /**
+     * Static method to create a normal transformation matrix from a model matrix, i.e. the inverse transpose with
+     * the translation removed.
+     *
+     * @param model
+     *   The model matrix to calculate from.
+     *
+     * @returns
+     *   Normal transformation matrix.
+     */
+    constexpr static Matrix4 make_normal_transform(const Matrix4 &model)
+    {
+        auto normal = transpose(invert(model));
 
-        std::swap(m[1], m[4]);
-        std::swap(m[2], m[8]);
-        std::swap(m[3], m[12]);
-        std::swap(m[6], m[9]);
-        std::swap(m[7], m[13]);
-        std::swap(m[11], m[14]);
+        // remove the translation components
+        normal[3] = 0.0f;
+        normal[7] = 0.0f;
+        normal[11] = 0.0f;
 
-        return m;
+        return normal;
     }
 
     /**
@@ -378,32 +331,7 @@ class Matrix4
      */
     constexpr Matrix4 &operator*=(const Matrix4 &matrix)
     {
-        const auto e = elements_;
-
-        const auto calculate_cell = [&e, &matrix](std::size_t row_num, std::size_t col_num) {
-            return (e[row_num + 0u] * matrix[col_num + 0u]) + (e[row_num + 1u] * matrix[col_num + 4u]) +
-                   (e[row_num + 2u] * matrix[col_num + 8u]) + (e[row_num + 3u] * matrix[col_num + 12u]);
-        };
-
-        elements_[0u] = calculate_cell(0u, 0u);
-        elements_[1u] = calculate_cell(0u, 1u);
-        elements_[2u] = calculate_cell(0u, 2u);
-        elements_[3u] = calculate_cell(0u, 3u);
-
-        elements_[4u] = calculate_cell(4u, 0u);
-        elements_[5u] = calculate_cell(4u, 1u);
-        elements_[6u] = calculate_cell(4u, 2u);
-        elements_[7u] = calculate_cell(4u, 3u);
-
-        elements_[8u] = calculate_cell(8u, 0u);
-        elements_[9u] = calculate_cell(8u, 1u);
-        elements_[10u] = calculate_cell(8u, 2u);
-        elements_[11u] = calculate_cell(8u, 3u);
-
-        elements_[12u] = calculate_cell(12u, 0u);
-        elements_[13u] = calculate_cell(12u, 1u);
-        elements_[14u] = calculate_cell(12u, 2u);
-        elements_[15u] = calculate_cell(12u, 3u);
+        elements_ = matrix4_kernels::multiply(elements_, matrix.elements_);
 
         return *this;
     }
@@ -436,13 +364,7 @@ class Matrix4
      */
     constexpr Vector3 operator*(const Vector3 &vector) const
     {
-        return {
-            vector.x * elements_[0] + vector.y * elements_[1] + vector.z * elements_[2] + elements_[3],
-
-            vector.x * elements_[4] + vector.y * elements_[5] + vector.z * elements_[6] + elements_[7],
-
-            vector.x * elements_[8] + vector.y * elements_[9] + vector.z * elements_[10] + elements_[11],
-        };
+        return matrix4_kernels::transform(elements_, vector);
     }
 
     /**
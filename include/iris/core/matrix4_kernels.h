@@ -0,0 +1,443 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "core/simd.h"
+#include "core/vector3.h"
+
+// the maths behind Matrix4, all matrices are 16 floats in row-major order
+//
+// each operation has a constexpr scalar version and (if IRIS_SIMD is defined) a SIMD version, the unsuffixed function
+// picks the SIMD version at runtime and the scalar version during constant evaluation, so Matrix4 can stay constexpr
+//
+// both versions are exposed so they can be tested and benchmarked against each other
+
+namespace iris::matrix4_kernels
+{
+
+/** Row-major 4x4 matrix. */
+using Elements = std::array<float, 16u>;
+
+/**
+ * Multiply two matrices.
+ *
+ * @param a
+ *   Left hand matrix.
+ *
+ * @param b
+ *   Right hand matrix.
+ *
+ * @returns
+ *   a * b
+ */
+constexpr Elements multiply_scalar(const Elements &a, const Elements &b)
+{
+    const auto calculate_cell = [&a, &b](std::size_t row_num, std::size_t col_num)
+    {
+        return (a[row_num + 0u] * b[col_num + 0u]) + (a[row_num + 1u] * b[col_num + 4u]) +
+               (a[row_num + 2u] * b[col_num + 8u]) + (a[row_num + 3u] * b[col_num + 12u]);
+    };
+
+    Elements e{};
+
+    e[0u] = calculate_cell(0u, 0u);
+    e[1u] = calculate_cell(0u, 1u);
+    e[2u] = calculate_cell(0u, 2u);
+    e[3u] = calculate_cell(0u, 3u);
+
+    e[4u] = calculate_cell(4u, 0u);
+    e[5u] = calculate_cell(4u, 1u);
+    e[6u] = calculate_cell(4u, 2u);
+    e[7u] = calculate_cell(4u, 3u);
+
+    e[8u] = calculate_cell(8u, 0u);
+    e[9u] = calculate_cell(8u, 1u);
+    e[10u] = calculate_cell(8u, 2u);
+    e[11u] = calculate_cell(8u, 3u);
+
+    e[12u] = calculate_cell(12u, 0u);
+    e[13u] = calculate_cell(12u, 1u);
+    e[14u] = calculate_cell(12u, 2u);
+    e[15u] = calculate_cell(12u, 3u);
+
+    return e;
+}
+
+/**
+ * Transpose a matrix.
+ *
+ * @param m
+ *   Matrix to transpose.
+ *
+ * @returns
+ *   Transposed matrix.
+ */
+constexpr Elements transpose_scalar(const Elements &m)
+{
+    auto e{m};
+
+    std::swap(e[1], e[4]);
+    std::swap(e[2], e[8]);
+    std::swap(e[3], e[12]);
+    std::swap(e[6], e[9]);
+    std::swap(e[7], e[13]);
+    std::swap(e[11], e[14]);
+
+    return e;
+}
+
+/**
+ * Invert a matrix. If the matrix is singular the adjugate is returned.
+ *
+ * @param m
+ *   Matrix to invert.
+ *
+ * @returns
+ *   Inverted matrix.
+ */
+constexpr Elements invert_scalar(const Elements &m)
+{
+    Elements inv{};
+
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] +
+             m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] -
+             m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] +
+             m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] -
+              m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] -
+             m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] +
+             m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] -
+             m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] +
+              m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] +
+             m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] -
+             m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] +
+              m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] -
+              m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] -
+             m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] +
+             m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] -
+              m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] +
+              m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    auto det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+
+    if (det != 0.0f)
+    {
+        det = 1.0f / det;
+
+        for (auto i = 0; i < 16; i++)
+        {
+            inv[i] *= det;
+        }
+    }
+
+    return inv;
+}
+
+/**
+ * Transform a point, i.e. multiply a matrix by (x, y, z, 1).
+ *
+ * @param m
+ *   Matrix to multiply.
+ *
+ * @param vector
+ *   Point to transform.
+ *
+ * @returns
+ *   Transformed point (w is discarded).
+ */
+constexpr Vector3 transform_scalar(const Elements &m, const Vector3 &vector)
+{
+    return {
+        vector.x * m[0] + vector.y * m[1] + vector.z * m[2] + m[3],
+
+        vector.x * m[4] + vector.y * m[5] + vector.z * m[6] + m[7],
+
+        vector.x * m[8] + vector.y * m[9] + vector.z * m[10] + m[11],
+    };
+}
+
+#if defined(IRIS_SIMD)
+
+/**
+ * SIMD version of multiply_scalar, gives identical results.
+ *
+ * Each row of the result is a linear combination of the rows of b, weighted by the corresponding row of a.
+ */
+inline Elements multiply_simd(const Elements &a, const Elements &b)
+{
+    const auto b0 = simd::load(b.data() + 0u);
+    const auto b1 = simd::load(b.data() + 4u);
+    const auto b2 = simd::load(b.data() + 8u);
+    const auto b3 = simd::load(b.data() + 12u);
+
+    Elements e;
+
+    for (auto row = 0u; row < 16u; row += 4u)
+    {
+        const auto r = simd::load(a.data() + row);
+
+        auto c = simd::mul(simd::splat<0>(r), b0);
+        c = simd::madd(simd::splat<1>(r), b1, c);
+        c = simd::madd(simd::splat<2>(r), b2, c);
+        c = simd::madd(simd::splat<3>(r), b3, c);
+
+        simd::store(e.data() + row, c);
+    }
+
+    return e;
+}
+
+/**
+ * SIMD version of transpose_scalar.
+ */
+inline Elements transpose_simd(const Elements &m)
+{
+    auto r0 = simd::load(m.data() + 0u);
+    auto r1 = simd::load(m.data() + 4u);
+    auto r2 = simd::load(m.data() + 8u);
+    auto r3 = simd::load(m.data() + 12u);
+
+    simd::transpose(r0, r1, r2, r3);
+
+    Elements e;
+    simd::store(e.data() + 0u, r0);
+    simd::store(e.data() + 4u, r1);
+    simd::store(e.data() + 8u, r2);
+    simd::store(e.data() + 12u, r3);
+
+    return e;
+}
+
+/**
+ * SIMD version of invert_scalar. This uses the same cofactor expansion but shares the 2x2 minors of the top and
+ * bottom pairs of rows, so results may differ from the scalar version by rounding.
+ */
+inline Elements invert_simd(const Elements &m)
+{
+    const auto r0 = simd::load(m.data() + 0u);
+    const auto r1 = simd::load(m.data() + 4u);
+    const auto r2 = simd::load(m.data() + 8u);
+    const auto r3 = simd::load(m.data() + 12u);
+
+    // the six 2x2 minors from a pair of rows (columns 01, 02, 03, 12, 13, 23), split over two registers
+    const auto minors = [](simd::f32x4 top, simd::f32x4 bottom)
+    {
+        const auto low = simd::sub(
+            simd::mul(simd::shuffle<0, 0, 0, 1>(top), simd::shuffle<1, 2, 3, 2>(bottom)),
+            simd::mul(simd::shuffle<0, 0, 0, 1>(bottom), simd::shuffle<1, 2, 3, 2>(top)));
+        const auto high = simd::sub(
+            simd::mul(simd::shuffle<1, 2, 1, 2>(top), simd::splat<3>(bottom)),
+            simd::mul(simd::shuffle<1, 2, 1, 2>(bottom), simd::splat<3>(top)));
+
+        return std::make_pair(low, high);
+    };
+
+    const auto [s_low, s_high] = minors(r0, r1);
+    const auto [c_low, c_high] = minors(r2, r3);
+
+    // pair each bottom minor with the complementary top minor, (c, c, s, s)
+    const auto k0 = simd::shuffle<0, 0, 0, 0>(c_low, s_low);
+    const auto k1 = simd::shuffle<1, 1, 1, 1>(c_low, s_low);
+    const auto k2 = simd::shuffle<2, 2, 2, 2>(c_low, s_low);
+    const auto k3 = simd::shuffle<3, 3, 3, 3>(c_low, s_low);
+    const auto k4 = simd::shuffle<0, 0, 0, 0>(c_high, s_high);
+    const auto k5 = simd::shuffle<1, 1, 1, 1>(c_high, s_high);
+
+    // columns of the matrix with each pair of lanes swapped
+    auto c0 = r0;
+    auto c1 = r1;
+    auto c2 = r2;
+    auto c3 = r3;
+    simd::transpose(c0, c1, c2, c3);
+    c0 = simd::shuffle<1, 0, 3, 2>(c0);
+    c1 = simd::shuffle<1, 0, 3, 2>(c1);
+    c2 = simd::shuffle<1, 0, 3, 2>(c2);
+    c3 = simd::shuffle<1, 0, 3, 2>(c3);
+
+    const auto sign = simd::set(1.0f, -1.0f, 1.0f, -1.0f);
+    const auto negated_sign = simd::set(-1.0f, 1.0f, -1.0f, 1.0f);
+
+    // rows of the adjugate
+    auto i0 = simd::mul(simd::add(simd::sub(simd::mul(c1, k5), simd::mul(c2, k4)), simd::mul(c3, k3)), sign);
+    auto i1 = simd::mul(simd::add(simd::sub(simd::mul(c0, k5), simd::mul(c2, k2)), simd::mul(c3, k1)), negated_sign);
+    auto i2 = simd::mul(simd::add(simd::sub(simd::mul(c0, k4), simd::mul(c1, k2)), simd::mul(c3, k0)), sign);
+    auto i3 = simd::mul(simd::add(simd::sub(simd::mul(c0, k3), simd::mul(c1, k1)), simd::mul(c2, k0)), negated_sign);
+
+    // determinant is the first row of the matrix dotted with the first column of the adjugate
+    const auto column = simd::shuffle<0, 2, 0, 2>(simd::shuffle<0, 0, 0, 0>(i0, i1), simd::shuffle<0, 0, 0, 0>(i2, i3));
+    auto dot = simd::mul(r0, column);
+    dot = simd::add(dot, simd::shuffle<1, 0, 3, 2>(dot));
+    dot = simd::add(dot, simd::shuffle<2, 3, 0, 1>(dot));
+    const auto det = simd::first(dot);
+
+    if (det != 0.0f)
+    {
+        const auto scale = simd::splat(1.0f / det);
+
+        i0 = simd::mul(i0, scale);
+        i1 = simd::mul(i1, scale);
+        i2 = simd::mul(i2, scale);
+        i3 = simd::mul(i3, scale);
+    }
+
+    Elements e;
+    simd::store(e.data() + 0u, i0);
+    simd::store(e.data() + 4u, i1);
+    simd::store(e.data() + 8u, i2);
+    simd::store(e.data() + 12u, i3);
+
+    return e;
+}
+
+/**
+ * SIMD version of transform_scalar, gives identical results.
+ */
+inline Vector3 transform_simd(const Elements &m, const Vector3 &vector)
+{
+    const auto point = simd::set(vector.x, vector.y, vector.z, 1.0f);
+
+    auto r0 = simd::mul(simd::load(m.data() + 0u), point);
+    auto r1 = simd::mul(simd::load(m.data() + 4u), point);
+    auto r2 = simd::mul(simd::load(m.data() + 8u), point);
+    auto r3 = simd::mul(simd::load(m.data() + 12u), point);
+
+    // transpose so each lane of the sum is the dot product of one row
+    simd::transpose(r0, r1, r2, r3);
+
+    std::array<float, 4u> result;
+    simd::store(result.data(), simd::add(simd::add(simd::add(r0, r1), r2), r3));
+
+    return {result[0], result[1], result[2]};
+}
+
+#endif
+
+/**
+ * Multiply two matrices, using SIMD if available.
+ *
+ * @param a
+ *   Left hand matrix.
+ *
+ * @param b
+ *   Right hand matrix.
+ *
+ * @returns
+ *   a * b
+ */
+constexpr Elements multiply(const Elements &a, const Elements &b)
+{
+#if defined(IRIS_SIMD)
+    if (!std::is_constant_evaluated())
+    {
+        return multiply_simd(a, b);
+    }
+#endif
+
+    return multiply_scalar(a, b);
+}
+
+/**
+ * Transpose a matrix, using SIMD if available.
+ *
+ * @param m
+ *   Matrix to transpose.
+ *
+ * @returns
+ *   Transposed matrix.
+ */
+constexpr Elements transpose(const Elements &m)
+{
+#if defined(IRIS_SIMD)
+    if (!std::is_constant_evaluated())
+    {
+        return transpose_simd(m);
+    }
+#endif
+
+    return transpose_scalar(m);
+}
+
+/**
+ * Invert a matrix, using SIMD if available. If the matrix is singular the adjugate is returned.
+ *
+ * @param m
+ *   Matrix to invert.
+ *
+ * @returns
+ *   Inverted matrix.
+ */
+constexpr Elements invert(const Elements &m)
+{
+#if defined(IRIS_SIMD)
+    if (!std::is_constant_evaluated())
+    {
+        return invert_simd(m);
+    }
+#endif
+
+    return invert_scalar(m);
+}
+
+/**
+ * Transform a point, using SIMD if available.
+ *
+ * @param m
+ *   Matrix to multiply.
+ *
+ * @param vector
+ *   Point to transform.
+ *
+ * @returns
+ *   Transformed point.
+ */
+constexpr Vector3 transform(const Elements &m, const Vector3 &vector)
+{
+#if defined(IRIS_SIMD)
+    if (!std::is_constant_evaluated())
+    {
+        return transform_simd(m, vector);
+    }
+#endif
+
+    return transform_scalar(m, vector);
+}
+
+}
@@ -6,12 +6,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <mutex>
+#include <utility>
 
 #include "core/error_handling.h"
-#include "log/log.h"
 
 namespace iris
 {
@@ -19,7 +21,13 @@ namespace iris
 /**
  * Simple thread-safe generic object pool class.
  *
- * Internally this allocates a large continuous block for all objects and returns/releases objects from the start.
+ * Internally this allocates a large continuous block for all objects. Free objects are kept on a lock-free stack
+ * (a Treiber stack) threaded through an array of indices, so next() and release() are a single CAS in the uncontended
+ * case and objects can be released in any order.
+ *
+ * The head of the stack is an index paired with a tag that changes on every update, this stops the ABA problem
+ * where a thread reads the head, is preempted while another thread pops and pushes the same object, and then
+ * incorrectly succeeds with a stale next index.
  */
 template <class T, std::size_t N = 50000, class Allocator = std::allocator<T>>
 class ObjectPool
@@ -36,13 +44,14 @@ class ObjectPool
         , free_list_alloc_()
         , objects_(nullptr)
         , free_list_(nullptr)
-        , next_(nullptr)
+        , head_(make_head(0u, 0u))
     {
         static_assert(N > 0);
+        static_assert(N < empty_index, "object pool too large");
 
         // create the fixed array of objects and a free list
-        // the free list is an array of pointers where each element points to an object on the pool
-        // the next_ pointer tracks which will be the next object to be given out from the pool
+        // the free list is an array of indices where each element is the index of the next free object, so together
+        // with head_ it forms a singly linked list of free objects
         objects_ = alloc_.allocate(N);
 
         try
@@ -56,19 +65,11 @@ class ObjectPool
             throw;
         }
 
-        auto *obj_cursor = objects_;
-        auto **free_cursor = free_list_;
-
-        // wire up the free list so each pointer is pointing to an object in the pool
-        while (free_cursor != free_list_ + N)
+        // wire up the free list so each object points to the one after it, the last one marks the end of the list
+        for (auto i = 0u; i < N; ++i)
         {
-            *free_cursor = obj_cursor;
-            ++free_cursor;
-            ++obj_cursor;
+            std::construct_at(free_list_ + i, (i + 1u == N) ? empty_index : i + 1u);
         }
-
-        // start handing out objects from the start of the free list
-        next_ = free_list_;
     }
 
     /**
@@ -78,9 +79,15 @@ class ObjectPool
     ~ObjectPool()
     {
         alloc_.deallocate(objects_, N);
+        std::destroy_n(free_list_, N);
         free_list_alloc_.deallocate(free_list_, N);
     }
 
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+    ObjectPool(ObjectPool &&) = delete;
+    ObjectPool &operator=(ObjectPool &&) = delete;
+
     /**
      * Get the next object from the pool. Will construct it with the supplied args.
      *
@@ -93,18 +100,40 @@ class ObjectPool
     template <class... Args>
     T *next(Args &&...args)
     {
-        ensure(next_ != free_list_ + N, "object pool drained");
+        auto head = head_.load(std::memory_order_acquire);
+        std::uint32_t index = 0u;
 
-        T *object = nullptr;
-
-        // get the next object and update the next pointer
+        for (;;)
         {
-            std::unique_lock lock(mutex_);
-            object = *next_;
-            ++next_;
+            index = index_of(head);
+            ensure(index != empty_index, "object pool drained");
+
+            // if another thread takes this object before we do then this may be stale, but the tag will also have
+            // changed so the CAS will fail and we'll try again
+            const auto next_index = free_list_[index].load(std::memory_order_relaxed);
+
+            if (head_.compare_exchange_weak(
+                    head,
+                    make_head(next_index, tag_of(head) + 1u),
+                    std::memory_order_acquire,
+                    std::memory_order_acquire))
+            {
+                break;
+            }
         }
 
-        ::new (object) T(std::forward<Args>(args)...);
+        auto *object = objects_ + index;
+
+        try
+        {
+            std::construct_at(object, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            // don't lose the object if its constructor throws
+            push(index);
+            throw;
+        }
 
         return object;
     }
@@ -113,39 +142,99 @@ class ObjectPool
      * Returns an object to the pool.
      *
      * @param object
-     *   Object to return to pool.
+     *   Object to return to pool, must have come from next() on this pool.
      */
     void release(const T *object)
     {
+        expect((object >= objects_) && (object < objects_ + N), "object not from this pool");
+
         // call the destructor of the returned object
         std::destroy_at(object);
 
-        // return the object to the pool and move the next pointer back
-        {
-            std::unique_lock lock(mutex_);
-            --next_;
-            *next_ = const_cast<T *>(object);
-        }
+        push(static_cast<std::uint32_t>(object - objects_));
     }
 
   private:
+    /** Index used to mark the end of the free list. */
+    static constexpr auto empty_index = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * Pack an index and tag into a value for head_.
+     *
+     * @param index
+     *   Index of object at the top of the free list.
+     *
+     * @param tag
+     *   Tag for this version of the head.
+     *
+     * @returns
+     *   Packed head.
+     */
+    static constexpr std::uint64_t make_head(std::uint32_t index, std::uint32_t tag)
+    {
+        return (static_cast<std::uint64_t>(tag) << 32u) | index;
+    }
+
+    /**
+     * Get the index from a packed head.
+     *
+     * @param head
+     *   Packed head.
+     *
+     * @returns
+     *   Index of object at the top of the free list.
+     */
+    static constexpr std::uint32_t index_of(std::uint64_t head)
+    {
+        return static_cast<std::uint32_t>(head);
+    }
+
+    /**
+     * Get the tag from a packed head.
+     *
+     * @param head
+     *   Packed head.
+     *
+     * @returns
+     *   Tag of head.
+     */
+    static constexpr std::uint32_t tag_of(std::uint64_t head)
+    {
+        return static_cast<std::uint32_t>(head >> 32u);
+    }
+
+    /**
+     * Push an object back onto the free list.
+     *
+     * @param index
+     *   Index of object to push.
+     */
+    void push(std::uint32_t index)
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+
+        // release so the next thread to take this object sees its destruction and our write to the free list
+        do
+        {
+            free_list_[index].store(index_of(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(
+            head, make_head(index, tag_of(head) + 1u), std::memory_order_release, std::memory_order_relaxed));
+    }
+
     /** The allocator to use of T. */
     Allocator alloc_;
 
-    /** Rebound allocator for allocating T* */
-    typename std::allocator_traits<Allocator>::template rebind_alloc<T *> free_list_alloc_;
+    /** Rebound allocator for allocating the free list. */
+    typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<std::uint32_t>> free_list_alloc_;
 
     /** Pool of allocated objects. */
     T *objects_;
 
-    /** Array of pointers to allocated objects. */
-    T **free_list_;
-
-    /** Pointer into free list for next object to return. */
-    T **next_;
+    /** Array where each element is the index of the next free object after it. */
+    std::atomic<std::uint32_t> *free_list_;
 
-    /** Mutex to ensure thread safety. */
-    std::mutex mutex_;
+    /** Tagged index of the first free object. */
+    std::atomic<std::uint64_t> head_;
 };
 
 }
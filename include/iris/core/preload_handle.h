@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace iris
+{
+
+/**
+ * Handle to a batch of resources being loaded in the background by ResourceManager::preload. It can be polled each
+ * frame (e.g. to draw a loading bar) or waited on. Copies refer to the same batch.
+ *
+ * A failed load does not stop the batch, it is counted and the error will be thrown again if the resource is later
+ * loaded with ResourceManager::load.
+ */
+class PreloadHandle
+{
+  public:
+    /**
+     * State shared between the handle and the loading jobs.
+     */
+    struct State
+    {
+        /**
+         * Construct a new State.
+         *
+         * @param resources
+         *   Resources to load.
+         */
+        explicit State(std::vector<std::string> resources)
+            : resources(std::move(resources))
+            , completed(0u)
+            , failed(0u)
+            , bytes(0u)
+            , mutex()
+            , condition()
+        {
+        }
+
+        /**
+         * Record a resource as having finished loading.
+         *
+         * @param size
+         *   Size of loaded resource in bytes.
+         *
+         * @param success
+         *   True if the resource loaded, false if it failed.
+         */
+        void finish(std::size_t size, bool success)
+        {
+            bytes.fetch_add(size, std::memory_order_relaxed);
+
+            if (!success)
+            {
+                failed.fetch_add(1u, std::memory_order_relaxed);
+            }
+
+            // signal under the lock so a waiting thread cannot miss the final update
+            std::unique_lock lock(mutex);
+            if (completed.fetch_add(1u, std::memory_order_acq_rel) + 1u == resources.size())
+            {
+                condition.notify_all();
+            }
+        }
+
+        /** Resources being loaded. */
+        const std::vector<std::string> resources;
+
+        /** Number of resources finished (successfully or not). */
+        std::atomic<std::size_t> completed;
+
+        /** Number of resources that failed to load. */
+        std::atomic<std::size_t> failed;
+
+        /** Total size of loaded resources in bytes. */
+        std::atomic<std::size_t> bytes;
+
+        /** Mutex for waiting on. */
+        std::mutex mutex;
+
+        /** Signalled when the last resource finishes. */
+        std::condition_variable condition;
+    };
+
+    /**
+     * Construct a handle to a batch.
+     *
+     * @param state
+     *   State of batch.
+     */
+    explicit PreloadHandle(std::shared_ptr<State> state)
+        : state_(std::move(state))
+    {
+    }
+
+    /**
+     * Get the number of resources in the batch.
+     *
+     * @returns
+     *   Number of resources.
+     */
+    std::size_t total() const
+    {
+        return state_->resources.size();
+    }
+
+    /**
+     * Get the number of resources which have finished, successfully or not.
+     *
+     * @returns
+     *   Number of finished resources.
+     */
+    std::size_t completed() const
+    {
+        return state_->completed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the number of resources which failed to load.
+     *
+     * @returns
+     *   Number of failed resources.
+     */
+    std::size_t failed() const
+    {
+        return state_->failed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the total size of all resources loaded so far.
+     *
+     * @returns
+     *   Size in bytes.
+     */
+    std::size_t bytes_loaded() const
+    {
+        return state_->bytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the fraction of the batch which has finished.
+     *
+     * @returns
+     *   Progress in the range [0.0, 1.0], an empty batch is always 1.0.
+     */
+    float progress() const
+    {
+        return total() == 0u ? 1.0f : static_cast<float>(completed()) / static_cast<float>(total());
+    }
+
+    /**
+     * Check if every resource in the batch has finished.
+     *
+     * @returns
+     *   True if finished, false otherwise.
+     */
+    bool is_done() const
+    {
+        return completed() == total();
+    }
+
+    /**
+     * Block until every resource in the batch has finished.
+     */
+    void wait() const
+    {
+        std::unique_lock lock(state_->mutex);
+        state_->condition.wait(lock, [this]() { return is_done(); });
+    }
+
+  private:
+    /** Shared state of batch. */
+    std::shared_ptr<State> state_;
+};
+
+}
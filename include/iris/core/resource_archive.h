@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/data_buffer.h"
+#include "core/mapped_file.h"
+#include "core/resource_view.h"
+
+namespace iris
+{
+
+/**
+ * How an entry is stored in a resource archive.
+ */
+enum class ArchiveCompression : std::uint32_t
+{
+    /** Stored as is, reads are a view straight into the archive. */
+    NONE,
+
+    /** Compressed with zlib deflate, reads decompress into a new buffer. */
+    DEFLATE
+};
+
+/**
+ * A read-only archive of resources packed into a single file, see ResourceArchiveWriter for creating one.
+ *
+ * The layout is:
+ *   header:  magic "IRPK", version, entry count, size of names
+ *   index:   one fixed size record per entry (data offset, size, stored size, name offset, name size, compression),
+ *            sorted by name
+ *   names:   all entry names, concatenated
+ *   data:    entry data, each aligned to 16 bytes
+ *
+ * All values are little endian. The archive is memory mapped and the index read once when opened, after that finding
+ * an entry is a binary search and reading an uncompressed entry is a view of the mapping, so no system calls are made
+ * per resource.
+ */
+class ResourceArchive
+{
+  public:
+    /**
+     * Open an archive.
+     *
+     * @param path
+     *   Path of archive.
+     */
+    explicit ResourceArchive(const std::filesystem::path &path);
+
+    /**
+     * Check if the archive has an entry.
+     *
+     * @param name
+     *   Name of entry.
+     *
+     * @returns
+     *   True if entry exists, false otherwise.
+     */
+    bool contains(std::string_view name) const;
+
+    /**
+     * Read an entry. This is thread safe.
+     *
+     * @param name
+     *   Name of entry, must exist.
+     *
+     * @returns
+     *   View of entry data. For an uncompressed entry this refers to the archive mapping, which it keeps alive.
+     */
+    ResourceView read(std::string_view name) const;
+
+    /**
+     * Get the number of entries in the archive.
+     *
+     * @returns
+     *   Number of entries.
+     */
+    std::size_t size() const;
+
+  private:
+    /**
+     * An entry in the index.
+     */
+    struct Entry
+    {
+        /** Name of entry, a view into the mapping. */
+        std::string_view name;
+
+        /** Offset of data from start of archive. */
+        std::uint64_t offset;
+
+        /** Size of entry data. */
+        std::uint64_t size;
+
+        /** Size of data in the archive, which will be smaller than size if compressed. */
+        std::uint64_t stored_size;
+
+        /** How the data is stored. */
+        ArchiveCompression compression;
+    };
+
+    /**
+     * Find an entry.
+     *
+     * @param name
+     *   Name of entry.
+     *
+     * @returns
+     *   Pointer to entry, or nullptr if it does not exist.
+     */
+    const Entry *find(std::string_view name) const;
+
+    /** Mapped archive. */
+    std::shared_ptr<const MappedFile> file_;
+
+    /** Index, sorted by name. */
+    std::vector<Entry> entries_;
+};
+
+/**
+ * Builds a resource archive, see ResourceArchive for the format.
+ */
+class ResourceArchiveWriter
+{
+  public:
+    /**
+     * Construct an empty writer.
+     */
+    ResourceArchiveWriter();
+
+    /**
+     * Add an entry to the archive.
+     *
+     * @param name
+     *   Name of entry, which is what it will be loaded as. Must be unique.
+     *
+     * @param data
+     *   Entry data.
+     *
+     * @param compression
+     *   How to store the entry. If compression does not make the entry smaller then it is stored uncompressed.
+     */
+    void add(
+        std::string name,
+        std::span<const std::byte> data,
+        ArchiveCompression compression = ArchiveCompression::NONE);
+
+    /**
+     * Write the archive.
+     *
+     * @param path
+     *   Path to write archive to, will be overwritten if it exists.
+     */
+    void write(const std::filesystem::path &path);
+
+    /**
+     * Get the number of entries added.
+     *
+     * @returns
+     *   Number of entries.
+     */
+    std::size_t size() const;
+
+  private:
+    /**
+     * An entry to be written.
+     */
+    struct Entry
+    {
+        /** Name of entry. */
+        std::string name;
+
+        /** Data as it will be stored. */
+        DataBuffer data;
+
+        /** Uncompressed size of data. */
+        std::uint64_t size;
+
+        /** How the data is stored. */
+        ArchiveCompression compression;
+    };
+
+    /** Entries to write. */
+    std::vector<Entry> entries_;
+};
+
+}
@@ -0,0 +1,36 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Snapshot of the state of a ResourceManager cache.
+ */
+struct ResourceCacheStats
+{
+    /** Total size of all cached resources which own their data in bytes. */
+    std::size_t resident_bytes;
+
+    /** Number of cached resources. */
+    std::size_t resident_count;
+
+    /** Number of loads served from the cache. */
+    std::uint64_t hits;
+
+    /** Number of loads which had to fetch the resource. */
+    std::uint64_t misses;
+
+    /** Number of resources evicted to stay within the memory budget. */
+    std::uint64_t evictions;
+};
+
+}
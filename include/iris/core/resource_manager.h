@@ -6,39 +6,153 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
-#include "core/data_buffer.h"
+#include "core/preload_handle.h"
+#include "core/resource_cache_stats.h"
+#include "core/resource_view.h"
 #include "core/string_hash.h"
+#include "jobs/task.h"
 
 namespace iris
 {
 
+class ThreadJobSystemManager;
+
 /**
  * An abstract class for loading and caching resources.
+ *
+ * Loading is thread safe. As well as the blocking load() resources can be loaded on a small pool of I/O threads, owned
+ * by the manager and separate from the job system so that waiting on a disk never stalls a worker. The I/O threads
+ * read every page of a resource so that whoever decodes it afterwards does not stall on page faults.
+ *
+ * Loaded resources are cached. By default the cache is unbounded, but a memory budget can be set after which the
+ * least recently used resources are evicted. A resource is never evicted whilst it is pinned or whilst a view of it
+ * is still in use elsewhere (evicting it would free nothing), so the budget can be exceeded if everything cached is in
+ * use. Resources whose views do not own their data (e.g. uncompressed entries mapped straight out of an archive) are
+ * exempt, they don't count towards the budget and are never evicted.
+ *
+ * Any outstanding async loads or preloads must finish before the manager is destroyed.
  */
 class ResourceManager
 {
   public:
     ResourceManager();
 
-    virtual ~ResourceManager() = default;
+    virtual ~ResourceManager();
 
     /**
      * Load a resource. If this is the first load of resource then it is fetched (via the deriving classes
-     * implementation). Otherwise a cached copy is returned.
+     * implementation). Otherwise a view of the cached data is returned.
+     *
+     * If another thread is already loading the same resource then this waits for that load rather than starting a
+     * second one.
+     *
+     * @param resource
+     *   Name of resource.
+     *
+     * @returns
+     *   View of loaded data, which keeps the data alive for as long as it (or any copy) exists.
+     */
+    ResourceView load(std::string_view resource);
+
+    /**
+     * Load a resource on an I/O thread. If the resource is already cached the task completes without leaving the
+     * awaiting thread, otherwise it resumes on an I/O thread once the data is in memory. Decoding should then
+     * schedule_on a job system so the I/O threads stay free:
+     *
+     *   const auto data = co_await resource_manager.load_async("image.png");
+     *   co_await schedule_on(jobs);
+     *   auto image = decode(data);
      *
      * @param resource
      *   Name of resource.
      *
      * @returns
-     *   Const reference to loaded data.
+     *   Task producing a view of the loaded data, any error loading is rethrown when it is awaited.
+     */
+    Task<ResourceView> load_async(std::string resource);
+
+    /**
+     * Start loading a batch of resources in the background, spread across the I/O threads. This returns immediately
+     * and the resources are cached as they complete, so subsequent calls to load() are fast.
+     *
+     * @param resources
+     *   Names of resources to load.
+     *
+     * @returns
+     *   Handle to query progress of, or wait on, the batch.
+     */
+    PreloadHandle preload(std::span<const std::string> resources);
+
+    /**
+     * Load a resource and pin it in the cache, so it is never evicted until it is unpinned. Pins are counted, so each
+     * call must be matched by a call to unpin.
+     *
+     * @param resource
+     *   Name of resource.
+     *
+     * @returns
+     *   View of loaded data.
+     */
+    ResourceView pin(std::string_view resource);
+
+    /**
+     * Unpin a resource, allowing it to be evicted once it has no remaining pins.
+     *
+     * @param resource
+     *   Name of resource, does nothing if it is not cached.
+     */
+    void unpin(std::string_view resource);
+
+    /**
+     * Remove a resource from the cache, regardless of whether it is pinned. Any existing views remain valid but the
+     * next load will fetch it again.
+     *
+     * @param resource
+     *   Name of resource.
+     *
+     * @returns
+     *   True if the resource was removed, false if it was not cached (or is still loading).
+     */
+    bool release(std::string_view resource);
+
+    /**
+     * Set the maximum total size of cached resources, evicting the least recently used resources if it is exceeded.
+     * Only resources which own their data count, see ResourceView::owns_data.
+     *
+     * @param bytes
+     *   Memory budget in bytes.
+     */
+    void set_memory_budget(std::size_t bytes);
+
+    /**
+     * Get the memory budget.
+     *
+     * @returns
+     *   Memory budget in bytes, the maximum value of std::size_t if unbounded.
      */
-    const DataBuffer &load(std::string_view resource);
+    std::size_t memory_budget() const;
+
+    /**
+     * Get a snapshot of the cache statistics.
+     *
+     * @returns
+     *   Cache statistics.
+     */
+    ResourceCacheStats stats() const;
 
     /**
      * Set root resource location. Note that implementations may choose to ignore this.
@@ -56,16 +170,108 @@ class ResourceManager
      *   Name of resource.
      *
      * @returns
-     *   Loaded data.
+     *   View of loaded data, implementations should avoid copying data where possible.
      */
-    virtual DataBuffer do_load(std::string_view resource) = 0;
+    virtual ResourceView do_load(std::string_view resource) = 0;
 
     /** Resource root. */
     std::filesystem::path root_;
 
   private:
-    /** Cache of loaded resources. */
-    std::unordered_map<std::string, DataBuffer, StringHash, std::equal_to<>> resources_;
+    /**
+     * A cached resource.
+     */
+    struct CachedResource
+    {
+        /** Loaded resource, not ready whilst it is being fetched. */
+        std::shared_future<ResourceView> view;
+
+        /**
+         * Size of resource in bytes counted towards the budget, zero whilst it is being fetched or if it does not own
+         * its data.
+         */
+        std::size_t size;
+
+        /** Number of times resource has been pinned. */
+        std::uint32_t pin_count;
+
+        /** Whether the resource has finished loading, and so is in lru_. */
+        bool loaded;
+
+        /** Position in lru_. */
+        std::list<std::string_view>::iterator lru_position;
+    };
+
+    /**
+     * Get a cached resource, or add a placeholder for one. Must be called with mutex_ held.
+     *
+     * @param resource
+     *   Name of resource.
+     *
+     * @param promise
+     *   Promise to fulfil if a placeholder was added.
+     *
+     * @returns
+     *   Pair of <future for resource, true if a placeholder was added and the caller must fetch it>.
+     */
+    std::pair<std::shared_future<ResourceView>, bool> find_or_add_locked(
+        std::string_view resource,
+        std::promise<ResourceView> &promise);
+
+    /**
+     * Fetch a resource for a placeholder added by find_or_add_locked.
+     *
+     * @param resource
+     *   Name of resource.
+     *
+     * @param promise
+     *   Promise to fulfil with the resource (or the error fetching it).
+     */
+    void fetch(std::string_view resource, std::promise<ResourceView> &promise);
+
+    /**
+     * Evict least recently used resources until the cache is within budget, or there is nothing left to evict. Must be
+     * called with mutex_ held.
+     */
+    void evict_locked();
+
+    /**
+     * Remove a loaded resource from the cache. Must be called with mutex_ held.
+     *
+     * @param cached
+     *   Iterator to resource to remove.
+     */
+    void erase_locked(
+        std::unordered_map<std::string, CachedResource, StringHash, std::equal_to<>>::iterator cached);
+
+    /**
+     * Get the I/O threads, creating them on first use.
+     *
+     * @returns
+     *   I/O job system.
+     */
+    ThreadJobSystemManager &io_jobs();
+
+    /** Lock for the cache. */
+    mutable std::mutex mutex_;
+
+    /** Cache of loaded (or loading) resources. */
+    std::unordered_map<std::string, CachedResource, StringHash, std::equal_to<>> resources_;
+
+    /** Names of loaded resources, most recently used first. These are views of the keys in resources_. */
+    std::list<std::string_view> lru_;
+
+    /** Maximum size of cached resources. */
+    std::size_t memory_budget_;
+
+    /** Cache statistics. */
+    ResourceCacheStats stats_;
+
+    /** Ensures the I/O threads are only created once. */
+    std::once_flag io_jobs_created_;
+
+    /** I/O threads, nullptr until first async load. */
+    std::unique_ptr<ThreadJobSystemManager> io_jobs_;
 };
 
 }
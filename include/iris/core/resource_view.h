@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "core/data_buffer.h"
+
+namespace iris
+{
+
+/**
+ * A read-only view of a loaded resource. The view shares ownership of whatever backs the bytes (e.g. a MappedFile or
+ * a DataBuffer) so the data stays valid for as long as any copy of the view exists, regardless of what the
+ * ResourceManager does with its own copy. Copying a view is cheap and never copies the data.
+ */
+class ResourceView
+{
+  public:
+    /**
+     * Construct an empty view.
+     */
+    ResourceView()
+        : data_()
+        , owner_()
+        , owns_data_(true)
+    {
+    }
+
+    /**
+     * Construct a view over data kept alive by an owner.
+     *
+     * @param data
+     *   Bytes of resource, must remain valid for the lifetime of owner.
+     *
+     * @param owner
+     *   Object which owns data.
+     *
+     * @param owns_data
+     *   True if owner exists only to back this resource, false if it is shared with other resources or kept alive
+     *   elsewhere (e.g. a view into a larger archive) so releasing this view would not free its memory.
+     */
+    ResourceView(std::span<const std::byte> data, std::shared_ptr<const void> owner, bool owns_data = true)
+        : data_(data)
+        , owner_(std::move(owner))
+        , owns_data_(owns_data)
+    {
+    }
+
+    /**
+     * Construct a view which takes ownership of a buffer, for resources which cannot be used in place.
+     *
+     * @param buffer
+     *   Buffer to take ownership of.
+     */
+    explicit ResourceView(DataBuffer buffer)
+        : ResourceView()
+    {
+        auto owned = std::make_shared<const DataBuffer>(std::move(buffer));
+        data_ = *owned;
+        owner_ = std::move(owned);
+    }
+
+    /**
+     * Get pointer to start of data.
+     *
+     * @returns
+     *   Pointer to data.
+     */
+    const std::byte *data() const
+    {
+        return data_.data();
+    }
+
+    /**
+     * Get size of data.
+     *
+     * @returns
+     *   Number of bytes.
+     */
+    std::size_t size() const
+    {
+        return data_.size();
+    }
+
+    /**
+     * Check if the view is empty.
+     *
+     * @returns
+     *   True if there are no bytes, false otherwise.
+     */
+    bool empty() const
+    {
+        return data_.empty();
+    }
+
+    /**
+     * Check if this is the only view of its data, i.e. nothing else is keeping the data alive.
+     *
+     * @returns
+     *   True if no other view shares ownership of the data, false otherwise.
+     */
+    bool is_unique() const
+    {
+        return owner_.use_count() <= 1;
+    }
+
+    /**
+     * Check if the memory backing this view belongs to this resource alone, i.e. whether dropping every view of it
+     * would free its bytes.
+     *
+     * @returns
+     *   True if the view owns its data, false if it borrows from something shared.
+     */
+    bool owns_data() const
+    {
+        return owns_data_;
+    }
+
+    /**
+     * Get the data as a span, note that the span does not keep the data alive.
+     *
+     * @returns
+     *   Span of data.
+     */
+    std::span<const std::byte> bytes() const
+    {
+        return data_;
+    }
+
+    /**
+     * Implicit conversion to span, so views can be passed to functions which only need the bytes for the duration of
+     * the call.
+     */
+    operator std::span<const std::byte>() const
+    {
+        return data_;
+    }
+
+    /**
+     * Get iterator to start of data.
+     *
+     * @returns
+     *   Iterator to start of data.
+     */
+    std::span<const std::byte>::iterator begin() const
+    {
+        return data_.begin();
+    }
+
+    /**
+     * Get iterator to end of data.
+     *
+     * @returns
+     *   Iterator to end of data.
+     */
+    std::span<const std::byte>::iterator end() const
+    {
+        return data_.end();
+    }
+
+  private:
+    /** Bytes of resource. */
+    std::span<const std::byte> data_;
+
+    /** Keeps data_ alive. */
+    std::shared_ptr<const void> owner_;
+
+    /** Whether owner_ backs only this resource. */
+    bool owns_data_;
+};
+
+}
@@ -46,6 +46,14 @@ class Semaphore
      */
     void acquire();
 
+    /**
+     * Decrement counter if it can be done without blocking.
+     *
+     * @returns
+     *   True if counter was decremented, false otherwise.
+     */
+    bool try_acquire();
+
   private:
     /** Pointer to implementation. */
     struct implementation;
@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// a minimal wrapper over four wide float registers, so kernels can be written once and compiled to SSE on x86_64 and
+// NEON on arm64
+//
+// the implementation is chosen at compile time from the target architecture, if IRIS_SIMD is not defined after
+// including this file then there is no SIMD support and callers should use their scalar path
+//
+// define IRIS_DISABLE_SIMD to force the scalar paths
+
+#if !defined(IRIS_DISABLE_SIMD)
+#if defined(IRIS_ARCH_X86_64)
+#include <immintrin.h>
+#define IRIS_SIMD
+#elif defined(IRIS_ARCH_ARM64)
+#include <arm_neon.h>
+#define IRIS_SIMD
+#endif
+#endif
+
+#if defined(IRIS_SIMD)
+
+namespace iris::simd
+{
+
+#if defined(IRIS_ARCH_X86_64)
+
+/** Four floats in a SIMD register. */
+using f32x4 = __m128;
+
+/** Result of comparing two f32x4 registers, one mask per lane. */
+using mask4 = __m128;
+
+/**
+ * Load four floats, no alignment requirement.
+ *
+ * @param ptr
+ *   Pointer to floats.
+ *
+ * @returns
+ *   Loaded floats.
+ */
+inline f32x4 load(const float *ptr)
+{
+    return _mm_loadu_ps(ptr);
+}
+
+/**
+ * Store four floats, no alignment requirement.
+ *
+ * @param ptr
+ *   Pointer to write to.
+ *
+ * @param value
+ *   Floats to write.
+ */
+inline void store(float *ptr, f32x4 value)
+{
+    _mm_storeu_ps(ptr, value);
+}
+
+/**
+ * Set all lanes to a value.
+ *
+ * @param value
+ *   Value to set.
+ *
+ * @returns
+ *   Register with value in all lanes.
+ */
+inline f32x4 splat(float value)
+{
+    return _mm_set1_ps(value);
+}
+
+/**
+ * Set each lane.
+ *
+ * @returns
+ *   Register with supplied values.
+ */
+inline f32x4 set(float a, float b, float c, float d)
+{
+    return _mm_setr_ps(a, b, c, d);
+}
+
+inline f32x4 add(f32x4 a, f32x4 b)
+{
+    return _mm_add_ps(a, b);
+}
+
+inline f32x4 sub(f32x4 a, f32x4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+inline f32x4 mul(f32x4 a, f32x4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+inline f32x4 div(f32x4 a, f32x4 b)
+{
+    return _mm_div_ps(a, b);
+}
+
+inline f32x4 sqrt(f32x4 value)
+{
+    return _mm_sqrt_ps(value);
+}
+
+/**
+ * Multiply and add, i.e. (a * b) + c. This is not fused, so gives the same result as the scalar expression.
+ */
+inline f32x4 madd(f32x4 a, f32x4 b, f32x4 c)
+{
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+/**
+ * Get the first lane.
+ *
+ * @param value
+ *   Register to get lane from.
+ *
+ * @returns
+ *   Value of first lane.
+ */
+inline float first(f32x4 value)
+{
+    return _mm_cvtss_f32(value);
+}
+
+/**
+ * Compare lanes for equality.
+ *
+ * @returns
+ *   Mask with all bits set in lanes where a == b.
+ */
+inline mask4 equal(f32x4 a, f32x4 b)
+{
+    return _mm_cmpeq_ps(a, b);
+}
+
+/**
+ * Compare lanes.
+ *
+ * @returns
+ *   Mask with all bits set in lanes where a < b.
+ */
+inline mask4 less(f32x4 a, f32x4 b)
+{
+    return _mm_cmplt_ps(a, b);
+}
+
+/**
+ * Pick lanes from one of two registers.
+ *
+ * @param mask
+ *   Mask from a comparison.
+ *
+ * @returns
+ *   Lanes from if_true where the mask is set, otherwise lanes from if_false.
+ */
+inline f32x4 select(mask4 mask, f32x4 if_true, f32x4 if_false)
+{
+    return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+}
+
+/**
+ * Rearrange lanes of a single register.
+ *
+ * @returns
+ *   (value[I0], value[I1], value[I2], value[I3])
+ */
+template <int I0, int I1, int I2, int I3>
+inline f32x4 shuffle(f32x4 value)
+{
+    return _mm_shuffle_ps(value, value, _MM_SHUFFLE(I3, I2, I1, I0));
+}
+
+/**
+ * Combine lanes from two registers.
+ *
+ * @returns
+ *   (a[I0], a[I1], b[I2], b[I3])
+ */
+template <int I0, int I1, int I2, int I3>
+inline f32x4 shuffle(f32x4 a, f32x4 b)
+{
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(I3, I2, I1, I0));
+}
+
+#elif defined(IRIS_ARCH_ARM64)
+
+/** Four floats in a SIMD register. */
+using f32x4 = float32x4_t;
+
+/** Result of comparing two f32x4 registers, one mask per lane. */
+using mask4 = uint32x4_t;
+
+/**
+ * Load four floats, no alignment requirement.
+ *
+ * @param ptr
+ *   Pointer to floats.
+ *
+ * @returns
+ *   Loaded floats.
+ */
+inline f32x4 load(const float *ptr)
+{
+    return vld1q_f32(ptr);
+}
+
+/**
+ * Store four floats, no alignment requirement.
+ *
+ * @param ptr
+ *   Pointer to write to.
+ *
+ * @param value
+ *   Floats to write.
+ */
+inline void store(float *ptr, f32x4 value)
+{
+    vst1q_f32(ptr, value);
+}
+
+/**
+ * Set all lanes to a value.
+ *
+ * @param value
+ *   Value to set.
+ *
+ * @returns
+ *   Register with value in all lanes.
+ */
+inline f32x4 splat(float value)
+{
+    return vdupq_n_f32(value);
+}
+
+/**
+ * Set each lane.
+ *
+ * @returns
+ *   Register with supplied values.
+ */
+inline f32x4 set(float a, float b, float c, float d)
+{
+    return f32x4{a, b, c, d};
+}
+
+inline f32x4 add(f32x4 a, f32x4 b)
+{
+    return vaddq_f32(a, b);
+}
+
+inline f32x4 sub(f32x4 a, f32x4 b)
+{
+    return vsubq_f32(a, b);
+}
+
+inline f32x4 mul(f32x4 a, f32x4 b)
+{
+    return vmulq_f32(a, b);
+}
+
+inline f32x4 div(f32x4 a, f32x4 b)
+{
+    return vdivq_f32(a, b);
+}
+
+inline f32x4 sqrt(f32x4 value)
+{
+    return vsqrtq_f32(value);
+}
+
+/**
+ * Multiply and add, i.e. (a * b) + c. This is not fused, so gives the same result as the scalar expression.
+ */
+inline f32x4 madd(f32x4 a, f32x4 b, f32x4 c)
+{
+    return vaddq_f32(vmulq_f32(a, b), c);
+}
+
+/**
+ * Get the first lane.
+ *
+ * @param value
+ *   Register to get lane from.
+ *
+ * @returns
+ *   Value of first lane.
+ */
+inline float first(f32x4 value)
+{
+    return vgetq_lane_f32(value, 0);
+}
+
+/**
+ * Compare lanes for equality.
+ *
+ * @returns
+ *   Mask with all bits set in lanes where a == b.
+ */
+inline mask4 equal(f32x4 a, f32x4 b)
+{
+    return vceqq_f32(a, b);
+}
+
+/**
+ * Compare lanes.
+ *
+ * @returns
+ *   Mask with all bits set in lanes where a < b.
+ */
+inline mask4 less(f32x4 a, f32x4 b)
+{
+    return vcltq_f32(a, b);
+}
+
+/**
+ * Pick lanes from one of two registers.
+ *
+ * @param mask
+ *   Mask from a comparison.
+ *
+ * @returns
+ *   Lanes from if_true where the mask is set, otherwise lanes from if_false.
+ */
+inline f32x4 select(mask4 mask, f32x4 if_true, f32x4 if_false)
+{
+    return vbslq_f32(mask, if_true, if_false);
+}
+
+/**
+ * Rearrange lanes of a single register.
+ *
+ * @returns
+ *   (value[I0], value[I1], value[I2], value[I3])
+ */
+template <int I0, int I1, int I2, int I3>
+inline f32x4 shuffle(f32x4 value)
+{
+    return __builtin_shufflevector(value, value, I0, I1, I2, I3);
+}
+
+/**
+ * Combine lanes from two registers.
+ *
+ * @returns
+ *   (a[I0], a[I1], b[I2], b[I3])
+ */
+template <int I0, int I1, int I2, int I3>
+inline f32x4 shuffle(f32x4 a, f32x4 b)
+{
+    return __builtin_shufflevector(a, b, I0, I1, I2 + 4, I3 + 4);
+}
+
+#endif
+
+/** Number of floats in a f32x4. */
+inline constexpr auto width = 4u;
+
+/**
+ * Broadcast a single lane to all lanes.
+ *
+ * @returns
+ *   value[I] in all lanes.
+ */
+template <int I>
+inline f32x4 splat(f32x4 value)
+{
+    return shuffle<I, I, I, I>(value);
+}
+
+/**
+ * Transpose four registers in place, as if they were the rows of a 4x4 matrix.
+ */
+inline void transpose(f32x4 &r0, f32x4 &r1, f32x4 &r2, f32x4 &r3)
+{
+    const auto t0 = shuffle<0, 1, 0, 1>(r0, r1);
+    const auto t1 = shuffle<2, 3, 2, 3>(r0, r1);
+    const auto t2 = shuffle<0, 1, 0, 1>(r2, r3);
+    const auto t3 = shuffle<2, 3, 2, 3>(r2, r3);
+
+    r0 = shuffle<0, 2, 0, 2>(t0, t2);
+    r1 = shuffle<1, 3, 1, 3>(t0, t2);
+    r2 = shuffle<0, 2, 0, 2>(t1, t3);
+    r3 = shuffle<1, 3, 1, 3>(t1, t3);
+}
+
+}
+
+#endif
@@ -0,0 +1,406 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * Handle to an element in a SlotMap. A handle is an index into the slot map and the generation of the slot when the
+ * handle was created. When an element is erased the generation of its slot is bumped, so any old handles to it are
+ * detected as stale even after the slot is reused.
+ */
+struct SlotMapHandle
+{
+    /** Index of slot. */
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+
+    /** Generation of slot this handle refers to. */
+    std::uint32_t generation = 0u;
+
+    auto operator<=>(const SlotMapHandle &) const = default;
+};
+
+/**
+ * A container which stores its elements contiguously and hands out stable handles to them. Insert, erase and lookup
+ * are all O(1) and iteration is over a packed array, so it's a good fit for collections of engine objects that are
+ * walked every frame but created and destroyed at arbitrary times.
+ *
+ * Erasing an element moves the last element into its place, so iteration order is not preserved across erases (see
+ * swap_positions for a way to enforce some order). Pointers and iterators to elements are invalidated by insert and
+ * erase, handles remain valid until the element they refer to is erased.
+ */
+template <class T>
+class SlotMap
+{
+  public:
+    // member types
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    /**
+     * Construct an element in place.
+     *
+     * @param args
+     *   Arguments to forward to the element constructor.
+     *
+     * @returns
+     *   Handle to new element.
+     */
+    template <class... Args>
+    SlotMapHandle emplace(Args &&...args)
+    {
+        ensure(values_.size() < empty_index, "slot map full");
+
+        // if there are no free slots then add one to the free list, this leaves the map in a valid state if anything
+        // below throws
+        if (free_head_ == empty_index)
+        {
+            free_head_ = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back({.position = empty_index, .generation = 0u});
+        }
+
+        const auto index = free_head_;
+        const auto position = static_cast<std::uint32_t>(values_.size());
+
+        slot_of_.push_back(index);
+
+        try
+        {
+            values_.emplace_back(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            slot_of_.pop_back();
+            throw;
+        }
+
+        // take the slot off the free list
+        free_head_ = slots_[index].position;
+        slots_[index].position = position;
+
+        return {.index = index, .generation = slots_[index].generation};
+    }
+
+    /**
+     * Insert an element.
+     *
+     * @param value
+     *   Element to insert.
+     *
+     * @returns
+     *   Handle to new element.
+     */
+    SlotMapHandle insert(T value)
+    {
+        return emplace(std::move(value));
+    }
+
+    /**
+     * Erase an element, the last element is moved into its place. Does nothing if the handle is stale.
+     *
+     * @param handle
+     *   Handle of element to erase.
+     *
+     * @returns
+     *   True if an element was erased, false otherwise.
+     */
+    bool erase(SlotMapHandle handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+
+        auto &slot = slots_[handle.index];
+        const auto position = slot.position;
+
+        // fill the hole with the last element
+        if (position != values_.size() - 1u)
+        {
+            values_[position] = std::move(values_.back());
+            slot_of_[position] = slot_of_.back();
+            slots_[slot_of_[position]].position = position;
+        }
+
+        values_.pop_back();
+        slot_of_.pop_back();
+
+        // invalidate any handles to this slot and put it on the free list
+        ++slot.generation;
+        slot.position = free_head_;
+        free_head_ = handle.index;
+
+        return true;
+    }
+
+    /**
+     * Check if a handle refers to an element in the map.
+     *
+     * @param handle
+     *   Handle to check.
+     *
+     * @returns
+     *   True if handle is valid, false if it is stale.
+     */
+    bool contains(SlotMapHandle handle) const
+    {
+        return (handle.index < slots_.size()) && (slots_[handle.index].generation == handle.generation);
+    }
+
+    /**
+     * Get an element.
+     *
+     * @param handle
+     *   Handle of element.
+     *
+     * @returns
+     *   Pointer to element, or nullptr if handle is stale.
+     */
+    T *get(SlotMapHandle handle)
+    {
+        return contains(handle) ? &values_[slots_[handle.index].position] : nullptr;
+    }
+
+    /**
+     * Get an element.
+     *
+     * @param handle
+     *   Handle of element.
+     *
+     * @returns
+     *   Pointer to element, or nullptr if handle is stale.
+     */
+    const T *get(SlotMapHandle handle) const
+    {
+        return contains(handle) ? &values_[slots_[handle.index].position] : nullptr;
+    }
+
+    /**
+     * Get an element, the handle must be valid.
+     *
+     * @param handle
+     *   Handle of element.
+     *
+     * @returns
+     *   Reference to element.
+     */
+    T &operator[](SlotMapHandle handle)
+    {
+        expect(contains(handle), "stale handle");
+        return values_[slots_[handle.index].position];
+    }
+
+    /**
+     * Get an element, the handle must be valid.
+     *
+     * @param handle
+     *   Handle of element.
+     *
+     * @returns
+     *   Reference to element.
+     */
+    const T &operator[](SlotMapHandle handle) const
+    {
+        expect(contains(handle), "stale handle");
+        return values_[slots_[handle.index].position];
+    }
+
+    /**
+     * Get the position of an element in the packed array, the handle must be valid.
+     *
+     * @param handle
+     *   Handle of element.
+     *
+     * @returns
+     *   Position of element.
+     */
+    size_type position(SlotMapHandle handle) const
+    {
+        expect(contains(handle), "stale handle");
+        return slots_[handle.index].position;
+    }
+
+    /**
+     * Get the handle for the element at a position in the packed array.
+     *
+     * @param position
+     *   Position of element, must be less than size().
+     *
+     * @returns
+     *   Handle of element.
+     */
+    SlotMapHandle handle(size_type position) const
+    {
+        expect(position < values_.size(), "position out of range");
+
+        const auto index = slot_of_[position];
+        return {.index = index, .generation = slots_[index].generation};
+    }
+
+    /**
+     * Swap the positions of two elements in the packed array, their handles are unaffected.
+     *
+     * @param a
+     *   Handle of first element.
+     *
+     * @param b
+     *   Handle of second element.
+     */
+    void swap_positions(SlotMapHandle a, SlotMapHandle b)
+    {
+        const auto position_a = position(a);
+        const auto position_b = position(b);
+
+        using std::swap;
+        swap(values_[position_a], values_[position_b]);
+        swap(slot_of_[position_a], slot_of_[position_b]);
+        slots_[a.index].position = static_cast<std::uint32_t>(position_b);
+        slots_[b.index].position = static_cast<std::uint32_t>(position_a);
+    }
+
+    /**
+     * Reserve space for elements.
+     *
+     * @param capacity
+     *   Number of elements to reserve space for.
+     */
+    void reserve(size_type capacity)
+    {
+        values_.reserve(capacity);
+        slot_of_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    /**
+     * Erase all elements, all existing handles become stale.
+     */
+    void clear()
+    {
+        while (!values_.empty())
+        {
+            erase(handle(values_.size() - 1u));
+        }
+    }
+
+    /**
+     * Get number of elements.
+     *
+     * @returns
+     *   Number of elements.
+     */
+    size_type size() const
+    {
+        return values_.size();
+    }
+
+    /**
+     * Check if there are no elements.
+     *
+     * @returns
+     *   True if empty, false otherwise.
+     */
+    bool empty() const
+    {
+        return values_.empty();
+    }
+
+    /**
+     * Get a pointer to the packed array of elements.
+     *
+     * @returns
+     *   Pointer to first element.
+     */
+    T *data()
+    {
+        return values_.data();
+    }
+
+    /**
+     * Get a pointer to the packed array of elements.
+     *
+     * @returns
+     *   Pointer to first element.
+     */
+    const T *data() const
+    {
+        return values_.data();
+    }
+
+    iterator begin()
+    {
+        return values_.begin();
+    }
+
+    const_iterator begin() const
+    {
+        return values_.begin();
+    }
+
+    const_iterator cbegin() const
+    {
+        return values_.cbegin();
+    }
+
+    iterator end()
+    {
+        return values_.end();
+    }
+
+    const_iterator end() const
+    {
+        return values_.end();
+    }
+
+    const_iterator cend() const
+    {
+        return values_.cend();
+    }
+
+  private:
+    /** Index used to mark the end of the free list. */
+    static constexpr auto empty_index = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * Indirection from a handle to an element.
+     */
+    struct Slot
+    {
+        /** Position of element in the packed array, or the next free slot if this slot is free. */
+        std::uint32_t position;
+
+        /** Current generation of slot. */
+        std::uint32_t generation;
+    };
+
+    /** Packed array of elements. */
+    std::vector<T> values_;
+
+    /** Slot index for each element in values_. */
+    std::vector<std::uint32_t> slot_of_;
+
+    /** Slots, indexed by handle. */
+    std::vector<Slot> slots_;
+
+    /** Index of first free slot. */
+    std::uint32_t free_head_ = empty_index;
+};
+
+}
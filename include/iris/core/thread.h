@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace iris
 {
@@ -73,6 +76,30 @@ class Thread
      */
     void bind_to_core(std::size_t core);
 
+    /**
+     * Restrict this thread such that it only executes on the specified cores.
+     *
+     * Note that depending on the current platform this may act as a
+     * suggestion to the kernel, rather than be honored (macOS only supports
+     * a hint for a single core, so other sets are ignored).
+     *
+     * @param cores
+     *   Ids of cores to run on, each in the range [0, number of cores).
+     */
+    void bind_to_cores(const std::vector<std::size_t> &cores);
+
+    /**
+     * Set the name of this thread, as shown in debuggers and profilers.
+     *
+     * Note that depending on the current platform the name may be truncated
+     * (linux only supports 15 characters) or ignored (macOS only allows a
+     * thread to name itself).
+     *
+     * @param name
+     *   New name.
+     */
+    void set_name(const std::string &name);
+
   private:
     /** Internal thread object. */
     std::thread thread_;
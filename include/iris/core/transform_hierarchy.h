@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "core/matrix4.h"
+#include "core/transform.h"
+#include "jobs/job_system_manager.h"
+
+namespace iris
+{
+
+/**
+ * Handle to a node in a TransformHierarchy. As with SlotMapHandle the generation allows stale handles to be detected
+ * after a node is removed. A default constructed handle refers to no node, which is used to mean "no parent".
+ */
+struct TransformNode
+{
+    /** Id of node. */
+    std::uint32_t id = std::numeric_limits<std::uint32_t>::max();
+
+    /** Generation of id this handle refers to. */
+    std::uint32_t generation = 0u;
+
+    auto operator<=>(const TransformNode &) const = default;
+};
+
+/**
+ * A hierarchy of transforms, where each node has a local transform relative to its parent and a world transform which
+ * is the product of all its ancestors.
+ *
+ * Nodes are stored in depth-first order (each node is immediately followed by all its descendants) so a single linear
+ * pass can compute world transforms, with parents always being processed before their children. Changing a local
+ * transform only marks the node as dirty, the world and normal matrices for dirty nodes and their descendants are then
+ * recomputed by update(), which skips over any subtree that has no changes. This means setting several properties of
+ * a transform in a frame costs one matrix product and one inversion, rather than one per change.
+ *
+ * Creating, removing and reparenting nodes are O(n) as they move nodes to maintain the depth-first order, they are
+ * expected to be much rarer than transform changes.
+ *
+ * This class is not thread safe. Marking a node dirty also writes to its ancestors and to state shared by the whole
+ * hierarchy, so even setting the transforms of unrelated nodes from different threads is a data race.
+ */
+class TransformHierarchy
+{
+  public:
+    /**
+     * Construct an empty hierarchy.
+     */
+    TransformHierarchy();
+
+    /**
+     * Create a new node, it will be the last child of its parent.
+     *
+     * @param local
+     *   Transform of the node relative to its parent.
+     *
+     * @param parent
+     *   Parent of the node, a default constructed handle will create a root node.
+     *
+     * @returns
+     *   Handle to the new node.
+     */
+    TransformNode create(const Transform &local, TransformNode parent = {});
+
+    /**
+     * Remove a node. Any children are reparented to the parent of the removed node, keeping their local transforms.
+     *
+     * @param node
+     *   Node to remove, does nothing if the node is not in the hierarchy.
+     */
+    void remove(TransformNode node);
+
+    /**
+     * Check if a node is in the hierarchy.
+     *
+     * @param node
+     *   Node to check.
+     *
+     * @returns
+     *   True if node is in the hierarchy, false if it was never created or has been removed.
+     */
+    bool contains(TransformNode node) const;
+
+    /**
+     * Get the parent of a node.
+     *
+     * @param node
+     *   Node to get parent of.
+     *
+     * @returns
+     *   Parent of node, or a default constructed handle if it is a root.
+     */
+    TransformNode parent(TransformNode node) const;
+
+    /**
+     * Change the parent of a node, it (and all its descendants) will be moved to be the last child of the new parent.
+     * The local transform is kept, so the world transform will change.
+     *
+     * @param node
+     *   Node to reparent.
+     *
+     * @param parent
+     *   New parent, a default constructed handle will make node a root. Must not be node or one of its descendants.
+     */
+    void set_parent(TransformNode node, TransformNode parent);
+
+    /**
+     * Get the local transform of a node.
+     *
+     * @param node
+     *   Node to get transform of.
+     *
+     * @returns
+     *   Transform relative to parent.
+     */
+    const Transform &local(TransformNode node) const;
+
+    /**
+     * Set the local transform of a node. This only marks the node as dirty, its world transform is recomputed by the
+     * next call to update().
+     *
+     * @param node
+     *   Node to set transform of.
+     *
+     * @param local
+     *   New transform relative to parent.
+     */
+    void set_local(TransformNode node, const Transform &local);
+
+    /**
+     * Get the world transform of a node.
+     *
+     * If the node or any of its ancestors have changed since the last update() then this walks up the hierarchy to
+     * compute the current value, otherwise it is the cached matrix.
+     *
+     * @param node
+     *   Node to get transform of.
+     *
+     * @returns
+     *   World transform.
+     */
+    Matrix4 world(TransformNode node) const;
+
+    /**
+     * Get the normal transform of a node, see Matrix4::make_normal_transform.
+     *
+     * As with world() this is correct even if the node has changed since the last update(), but then requires an
+     * inversion.
+     *
+     * @param node
+     *   Node to get transform of.
+     *
+     * @returns
+     *   Normal transform.
+     */
+    Matrix4 normal(TransformNode node) const;
+
+    /**
+     * Recompute world and normal transforms for all dirty nodes and their descendants.
+     */
+    void update();
+
+    /**
+     * Recompute world and normal transforms for all dirty nodes and their descendants, with each root whose subtree
+     * needs updating processed as a separate unit of work across the workers. This call blocks until the update is
+     * complete.
+     *
+     * @param jobs_manager
+     *   Job system to run the update on.
+     */
+    void update(JobSystemManager &jobs_manager);
+
+    /**
+     * Check if any node has changed since the last update().
+     *
+     * @returns
+     *   True if update() has work to do, false otherwise.
+     */
+    bool is_dirty() const;
+
+    /**
+     * Get the number of nodes in the hierarchy.
+     *
+     * @returns
+     *   Number of nodes.
+     */
+    std::size_t size() const;
+
+  private:
+    /**
+     * Get the position of a node in the depth-first order.
+     *
+     * @param node
+     *   Node to get position of, must be in the hierarchy.
+     *
+     * @returns
+     *   Position of node.
+     */
+    std::uint32_t position(TransformNode node) const;
+
+    /**
+     * Mark a node as dirty and its ancestors as having a dirty subtree.
+     *
+     * @param position
+     *   Position of node.
+     */
+    void mark_dirty(std::uint32_t position);
+
+    /**
+     * Check if a node or any of its ancestors are dirty.
+     *
+     * @param position
+     *   Position of node.
+     *
+     * @returns
+     *   True if the cached world transform is out of date.
+     */
+    bool is_stale(std::uint32_t position) const;
+
+    /**
+     * Update a range of nodes, which must consist of whole subtrees whose parents do not need updating.
+     *
+     * @param begin
+     *   Position of first node.
+     *
+     * @param end
+     *   One past the position of the last node.
+     */
+    void update_range(std::size_t begin, std::size_t end);
+
+    /**
+     * Reorder all nodes.
+     *
+     * @param order
+     *   The old position of each node in the new order, must be a permutation of [0, size()).
+     */
+    void reorder(const std::vector<std::uint32_t> &order);
+
+    /** Local transform of each node. */
+    std::vector<Transform> local_;
+
+    /** Cached world transform of each node. */
+    std::vector<Matrix4> world_;
+
+    /** Cached normal transform of each node. */
+    std::vector<Matrix4> normal_;
+
+    /** Position of the parent of each node. */
+    std::vector<std::uint32_t> parent_;
+
+    /** Number of nodes in the subtree rooted at each node, including itself. */
+    std::vector<std::uint32_t> subtree_size_;
+
+    /** Dirty flags for each node. */
+    std::vector<std::uint8_t> flags_;
+
+    /** Id of each node. */
+    std::vector<std::uint32_t> id_of_;
+
+    /** Position of each id. */
+    std::vector<std::uint32_t> position_of_;
+
+    /** Current generation of each id. */
+    std::vector<std::uint32_t> generation_;
+
+    /** Ids available for reuse. */
+    std::vector<std::uint32_t> free_ids_;
+
+    /** Positions of roots to update, stored to avoid allocating each update. */
+    std::vector<std::uint32_t> dirty_roots_;
+
+    /** Whether any node has been marked dirty since the last update. */
+    bool dirty_;
+};
+
+}
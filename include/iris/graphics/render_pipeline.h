@@ -117,6 +117,17 @@ class RenderPipeline
      */
     std::vector<RenderCommand> rebuild();
 
+    /**
+     * Rebuilds the RenderCommands as if build() was called but doesn't add additional passes. The supplied collection
+     * is cleared and refilled, so its storage is reused.
+     *
+     * Note this should only be called internally by the engine, calling it manually may produce unexpected results.
+     *
+     * @param render_queue
+     *   Collection to write RenderCommand objects representing the full pipeline to.
+     */
+    void rebuild(std::vector<RenderCommand> &render_queue);
+
     /**
      * Get collection of all RenderPass objects in this pipeline.
      *
@@ -140,6 +151,13 @@ class RenderPipeline
      */
     void clear_dirty_bit();
 
+    /**
+     * Recompute any entity transforms that have changed in all scenes, see Scene::update_transforms.
+     *
+     * Note this should only be called internally by the engine, once per frame.
+     */
+    void update_transforms();
+
     /**
      * Get scene buy index.
      *
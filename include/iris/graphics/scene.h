@@ -6,14 +6,19 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#include "core/slot_map.h"
+#include "core/transform_hierarchy.h"
 #include "graphics/instanced_entity.h"
 #include "graphics/lights/lighting_rig.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_graph/render_graph.h"
+#include "graphics/single_entity.h"
 
 namespace iris
 {
@@ -21,6 +26,12 @@ namespace iris
 /**
  * A scene is a collection of entities to be rendered. It owns the memory of its
  * render entities.
+ *
+ * The transforms of all SingleEntity objects in a scene share one
+ * TransformHierarchy, which is not thread safe. Setting the transform of any
+ * entity (set_position, set_orientation, set_scale, set_transform) and
+ * set_parent must all be called from a single thread, even for different
+ * entities.
  */
 class Scene
 {
@@ -135,12 +146,31 @@ class Scene
     RenderGraph *render_graph(RenderEntity *entity) const;
 
     /**
-     * Get a reference to all entities in the scene.
+     * Set the parent of an entity, after which its position, orientation and scale are relative to the parent.
+     *
+     * @param entity
+     *   Entity to set parent of, must be in this scene.
+     *
+     * @param parent
+     *   New parent, must be in this scene and not be a descendant of entity. If nullptr then entity will have no
+     *   parent.
+     */
+    void set_parent(SingleEntity *entity, SingleEntity *parent);
+
+    /**
+     * Recompute world transforms for all entities which (or whose parents) have changed since the last call. This is
+     * called once per frame by the Renderer.
+     */
+    void update_transforms();
+
+    /**
+     * Get a reference to all entities in the scene. Entities added by the RenderPipeline at the front come first,
+     * otherwise the order is unspecified.
      *
      * @returns
      *   Collection of <RenderGraph, RenderEntity> tuples.
      */
-    std::vector<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &entities();
+    SlotMap<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &entities();
 
     /**
      * Get a const reference to all entities in the scene.
@@ -148,7 +178,7 @@ class Scene
      * @returns
      *   Collection of <RenderGraph, RenderEntity> tuples.
      */
-    const std::vector<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &entities() const;
+    const SlotMap<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &entities() const;
 
     /**
      * Get LightingRig.
@@ -217,8 +247,25 @@ class Scene
      */
     RenderEntity *add_at_front(RenderGraph *render_graph, std::unique_ptr<RenderEntity> entity);
 
-    /** Collection of <RenderGraph, RenderEntity> tuples. */
-    std::vector<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> entities_;
+    /**
+     * Move the transform of an entity into the scene's hierarchy, if it has one.
+     *
+     * @param entity
+     *   Entity being added to scene.
+     */
+    void add_transform(RenderEntity *entity);
+
+    /** Collection of <RenderGraph, RenderEntity> tuples, entities added at the front occupy the first positions. */
+    SlotMap<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> entities_;
+
+    /** Map of RenderEntity to its handle in entities_. */
+    std::unordered_map<const RenderEntity *, SlotMapHandle> entity_handles_;
+
+    /** Number of entities added with add_at_front. */
+    std::size_t front_count_;
+
+    /** Transforms of all SingleEntity objects in the scene. */
+    TransformHierarchy transforms_;
 
     /** Collection of RenderGraphs. */
     std::vector<std::unique_ptr<RenderGraph>> render_graphs_;
@@ -16,6 +16,7 @@
 #include "core/matrix4.h"
 #include "core/quaternion.h"
 #include "core/transform.h"
+#include "core/transform_hierarchy.h"
 #include "graphics/mesh.h"
 #include "graphics/primitive_type.h"
 #include "graphics/render_entity.h"
@@ -29,6 +30,14 @@ namespace iris
 
 /**
  * Implementation of RenderEntity for a single instance mesh.
+ *
+ * Once added to a Scene the entity's transform is stored in the scene's TransformHierarchy, so it can be parented to
+ * other entities (see Scene::set_parent). Position, orientation and scale are then relative to the parent and changing
+ * them only marks the transform as dirty, the world and normal matrices are recomputed once per frame.
+ *
+ * Marking a transform dirty writes to state shared by every entity in the scene, so the transform setters of all
+ * entities in a Scene must be called from a single thread (or otherwise externally synchronised), even when setting
+ * different entities.
  */
 class SingleEntity : public RenderEntity
 {
@@ -164,7 +173,7 @@ class SingleEntity : public RenderEntity
     void set_scale(const Vector3 &scale);
 
     /**
-     * Get the transformation matrix of the SingleEntity.
+     * Get the world space transformation matrix of the SingleEntity, this includes the transforms of any parents.
      *
      * @returns
      *   Transformation matrix.
@@ -172,7 +181,7 @@ class SingleEntity : public RenderEntity
     Matrix4 transform() const;
 
     /**
-     * Set transformation matrix.
+     * Set transformation matrix, relative to any parent.
      *
      * @param transform
      *   New transform matrix.
@@ -180,7 +189,7 @@ class SingleEntity : public RenderEntity
     void set_transform(const Matrix4 &transform);
 
     /**
-     * Set transformation.
+     * Set transformation, relative to any parent.
      *
      * @param transform
      *   New transform.
@@ -228,11 +237,39 @@ class SingleEntity : public RenderEntity
     bool has_transparency() const override;
 
   private:
-    /** World space transform. */
+    // friend to allow the Scene to move the transform into its hierarchy
+    friend class Scene;
+
+    /**
+     * Get the transform relative to any parent.
+     *
+     * @returns
+     *   Local transform.
+     */
+    const Transform &local_transform() const;
+
+    /**
+     * Set the transform relative to any parent.
+     *
+     * @param transform
+     *   New local transform.
+     */
+    void set_local_transform(const Transform &transform);
+
+    /** Local transform, only used when not in a hierarchy. */
     Transform transform_;
 
-    /** Normal transformation matrix. */
-    Matrix4 normal_;
+    /** Normal transformation matrix, only used when not in a hierarchy. */
+    mutable Matrix4 normal_;
+
+    /** Whether normal_ needs recalculating. */
+    mutable bool normal_dirty_;
+
+    /** Hierarchy storing the transform, nullptr if not added to a Scene. */
+    TransformHierarchy *hierarchy_;
+
+    /** Node for this entity in hierarchy_. */
+    TransformNode node_;
 
     /** Skeleton. */
     Skeleton *skeleton_;
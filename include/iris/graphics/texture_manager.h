@@ -20,6 +20,8 @@
 #include "graphics/sampler.h"
 #include "graphics/texture.h"
 #include "graphics/texture_usage.h"
+#include "jobs/job_system_manager.h"
+#include "jobs/task.h"
 
 namespace iris
 {
@@ -58,6 +60,35 @@ class TextureManager
         TextureUsage usage = TextureUsage::IMAGE,
         const Sampler *sampler = nullptr);
 
+    /**
+     * Load a texture from the supplied file without blocking the calling thread. The file is read on the
+     * ResourceManager I/O threads, decoded on a job system worker and then the texture is created on the main thread
+     * (so the task finishes on the main thread). Several textures can be loaded in parallel with when_all.
+     *
+     * This shares the same cache as load(). If the same texture is loaded by two tasks at once it may be decoded twice,
+     * but only one texture is created.
+     *
+     * @param resource
+     *   File to load.
+     *
+     * @param jobs_manager
+     *   Job system to decode on, its main thread jobs must be run for the task to finish.
+     *
+     * @param usage
+     *   The usage of the texture, see load().
+     *
+     * @param sampler
+     *   Sampler to sue for texture, if nullptr the default sampler will be used.
+     *
+     * @returns
+     *   Task producing a pointer to the loaded texture.
+     */
+    Task<Texture *> load_async(
+        std::string resource,
+        JobSystemManager &jobs_manager,
+        TextureUsage usage = TextureUsage::IMAGE,
+        const Sampler *sampler = nullptr);
+
     /**
      * Load a CubeMap from the supplied file. Will use ResourceManager.
      *
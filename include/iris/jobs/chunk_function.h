@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+
+namespace iris
+{
+
+/**
+ * Non-owning reference to a callable which processes a single chunk of a parallel loop (see
+ * JobSystemManager::parallel_for). It is small enough to be captured in an InlineJob.
+ *
+ * The referenced callable must outlive the ChunkFunction.
+ */
+class ChunkFunction
+{
+  public:
+    /**
+     * Construct a new ChunkFunction.
+     *
+     * @param function
+     *   Callable to reference, will be called with a chunk index.
+     */
+    template <class F>
+        requires std::invocable<const F &, std::size_t>
+    ChunkFunction(const F &function)
+        : function_(std::addressof(function))
+        , invoke_([](const void *function, std::size_t chunk) { (*static_cast<const F *>(function))(chunk); })
+    {
+    }
+
+    /**
+     * Call the referenced callable.
+     *
+     * @param chunk
+     *   Index of chunk to process.
+     */
+    void operator()(std::size_t chunk) const
+    {
+        invoke_(function_, chunk);
+    }
+
+  private:
+    /** Referenced callable. */
+    const void *function_;
+
+    /** Type erased call to referenced callable. */
+    void (*invoke_)(const void *, std::size_t);
+};
+
+}
@@ -49,6 +49,18 @@ class ConcurrentQueue
         return empty_;
     }
 
+    /**
+     * Get the number of elements in the queue.
+     *
+     * @returns
+     *   Number of elements.
+     */
+    size_type size() const
+    {
+        std::unique_lock lock(mutex_);
+        return container_.size();
+    }
+
     /**
      * Add an item to the end of the queue.
      *
@@ -117,7 +129,7 @@ class ConcurrentQueue
     container_type container_;
 
     /** Mutex for queue. */
-    std::mutex mutex_;
+    mutable std::mutex mutex_;
 
     /** Flag indicating whether queue is empty. */
     std::atomic<bool> empty_;
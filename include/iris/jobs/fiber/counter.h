@@ -7,13 +7,22 @@
 #pragma once
 
 #include <atomic>
-#include <mutex>
+#include <exception>
 
 namespace iris
 {
 
+class Fiber;
+
 /**
- * A thread-safe counter. Can be decremented and checked.
+ * A lock-free counter. Can be decremented and checked.
+ *
+ * Fibers can wait on a counter reaching zero, they are stored in an intrusive list (linked via
+ * Fiber::next_waiter) so waiting does not allocate. Whoever decrements the counter to zero is handed the list of
+ * waiting fibers and is responsible for scheduling them.
+ *
+ * A counter also records the first exception thrown by any of the jobs it is counting, so the waiting fiber does not
+ * need to keep hold of the fibers that ran them.
  */
 class Counter
 {
@@ -38,24 +47,85 @@ class Counter
      * @returns
      *   Value of counter.
      */
-    operator int();
+    operator int() const;
 
     /**
-     * Prefix decrement counter.
+     * Prefix decrement counter. It is an error to use this if there are
+     * waiting fibers, use decrement() instead.
      */
     void operator--();
 
     /**
-     * Postfix decrement counter.
+     * Postfix decrement counter. It is an error to use this if there are
+     * waiting fibers, use decrement() instead.
      */
     void operator--(int);
 
+    /**
+     * Decrement counter.
+     *
+     * @returns
+     *   If this call dropped the counter to zero then the list of fibers waiting
+     *   on it (linked via Fiber::next_waiter), which the caller must now
+     *   schedule. Otherwise nullptr.
+     */
+    Fiber *decrement();
+
+    /**
+     * Increase counter. This is only valid whilst the counter is above zero,
+     * i.e. it must be called from a job that is itself being counted, before
+     * that job decrements.
+     *
+     * @param count
+     *   Amount to increase by.
+     */
+    void increment(int count);
+
+    /**
+     * Register a fiber to be handed back when the counter reaches zero.
+     *
+     * @param fiber
+     *   Fiber to add to wait list.
+     *
+     * @returns
+     *   True if the fiber was added, false if the counter has already reached
+     *   zero (in which case there is nothing to wait for).
+     */
+    bool add_waiter(Fiber *fiber);
+
+    /**
+     * Record an exception thrown by a counted job. Only the first exception is
+     * kept, any others are dropped.
+     *
+     * This must be called before the job decrements the counter, so that it is
+     * visible to the waiting fiber when it is resumed.
+     *
+     * @param exception
+     *   Exception to record.
+     */
+    void set_exception(std::exception_ptr exception);
+
+    /**
+     * Get the first exception recorded. Only safe to call once the counter has
+     * reached zero.
+     *
+     * @returns
+     *   exception_ptr to throw exception, nullptr if none were recorded.
+     */
+    std::exception_ptr exception() const;
+
   private:
     /** Value of counter. */
-    int value_;
+    std::atomic<int> value_;
+
+    /** Head of intrusive list of waiting fibers. */
+    std::atomic<Fiber *> waiters_;
+
+    /** Flag if an exception has been recorded. */
+    std::atomic<bool> has_exception_;
 
-    /** Lock for object. */
-    std::mutex mutex_;
+    /** First recorded exception. */
+    std::exception_ptr exception_;
 };
 
 }
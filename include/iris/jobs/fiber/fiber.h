@@ -7,12 +7,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 
 #include "core/static_buffer.h"
 #include "jobs/fiber/counter.h"
-#include "jobs/job.h"
+#include "jobs/inline_job.h"
+#include "jobs/job_priority.h"
 
 namespace iris
 {
@@ -33,7 +35,7 @@ class Fiber
      * @param job
      *   Job to run.
      */
-    explicit Fiber(Job job);
+    explicit Fiber(InlineJob job);
 
     /**
      * Construct a Fiber with a job and a counter.
@@ -42,9 +44,23 @@ class Fiber
      *   Job to run.
      *
      * @param counter
-     *   Counter to decrement when job is done.
+     *   Counter for the scheduler to decrement when job is done.
      */
-    Fiber(Job job, Counter *counter);
+    Fiber(InlineJob job, Counter *counter);
+
+    /**
+     * Construct a Fiber with a job, a counter and a requested stack size.
+     *
+     * @param job
+     *   Job to run.
+     *
+     * @param counter
+     *   Counter for the scheduler to decrement when job is done.
+     *
+     * @param stack_size
+     *   Size of stack in bytes, may be rounded up by the platform.
+     */
+    Fiber(InlineJob job, Counter *counter, std::size_t stack_size);
 
     ~Fiber();
 
@@ -55,8 +71,13 @@ class Fiber
 
     /**
      * Start the fiber.
+     *
+     * @returns
+     *   True if the job ran to completion, false if it was suspended. Note that
+     *   if it was suspended then it may already have been resumed by another
+     *   thread, so it should not be touched again.
      */
-    void start();
+    bool start();
 
     /**
      * Suspends a Fibers execution, execution will continue from where
@@ -69,8 +90,33 @@ class Fiber
      * was called.
      *
      * It is undefined behavior to resume a non-suspended Fiber.
+     *
+     * @returns
+     *   True if the job ran to completion, false if it was suspended again.
+     */
+    bool resume();
+
+    /**
+     * Re-arm a finished Fiber with a new job, reusing its stack. This allows
+     * Fibers to be pooled rather than created for every job.
+     *
+     * It is undefined behavior to reset a Fiber which is running or suspended.
+     *
+     * @param job
+     *   Job to run.
+     *
+     * @param counter
+     *   Counter for the scheduler to decrement when job is done.
+     */
+    void reset(InlineJob job, Counter *counter);
+
+    /**
+     * Get the size of the stack this Fiber was created with.
+     *
+     * @returns
+     *   Stack size in bytes, as requested at construction.
      */
-    void resume();
+    std::size_t stack_size() const;
 
     /**
      * Check if a Fiber is safe to call methods on. It is only not safe when it
@@ -86,6 +132,21 @@ class Fiber
      */
     void set_unsafe();
 
+    /**
+     * Set fiber to be safe. This is only needed if a fiber was marked unsafe in
+     * preparation for suspending but then didn't need to.
+     */
+    void set_safe();
+
+    /**
+     * Check if the fiber has been started (and so should be resumed rather than
+     * started).
+     *
+     * @returns
+     *   True if start has been called since construction or last reset.
+     */
+    bool is_started() const;
+
     /**
      * Check if another fiber is waiting for this to finish.
      *
@@ -94,6 +155,64 @@ class Fiber
      */
     bool is_being_waited_on() const;
 
+    /**
+     * Get the counter the scheduler should decrement when this fiber finishes.
+     *
+     * @returns
+     *   Counter, or nullptr if nothing is waiting on this fiber.
+     */
+    Counter *counter() const;
+
+    /**
+     * Get the priority lane this fiber is scheduled in.
+     *
+     * @returns
+     *   Fiber priority.
+     */
+    JobPriority priority() const;
+
+    /**
+     * Set the priority lane this fiber is scheduled in. This is reset to
+     * JobPriority::NORMAL by reset().
+     *
+     * @param priority
+     *   New priority.
+     */
+    void set_priority(JobPriority priority);
+
+    /**
+     * Get when this fiber was last put on a queue.
+     *
+     * @returns
+     *   Time fiber was scheduled.
+     */
+    std::chrono::steady_clock::time_point scheduled_at() const;
+
+    /**
+     * Set when this fiber was last put on a queue, used to measure how long it
+     * waits to be run.
+     *
+     * @param time
+     *   Time fiber was scheduled.
+     */
+    void set_scheduled_at(std::chrono::steady_clock::time_point time);
+
+    /**
+     * Get the next fiber in an intrusive wait list (see Counter).
+     *
+     * @returns
+     *   Next waiting fiber, or nullptr if end of list.
+     */
+    Fiber *next_waiter() const;
+
+    /**
+     * Set the next fiber in an intrusive wait list (see Counter).
+     *
+     * @param fiber
+     *   Next waiting fiber.
+     */
+    void set_next_waiter(Fiber *fiber);
+
     /**
      * Get any exception thrown during the execution of this fiber.
      *
@@ -118,13 +237,36 @@ class Fiber
      */
     static Fiber **this_fiber();
 
+#if defined(IRIS_PLATFORM_WIN32)
+    /**
+     * Default stack size for a Fiber. This matches the 1 MB windows gives a fiber when CreateFiberEx is not passed a
+     * size, only the first page is committed up front so the rest costs address space rather than memory.
+     */
+    static constexpr std::size_t default_stack_size = 1024u * 1024u;
+#else
+    /** Default stack size for a Fiber. */
+    static constexpr std::size_t default_stack_size = 36u * 1024u;
+#endif
+
   private:
     /** Job to run in Fiber. */
-    Job job_;
+    InlineJob job_;
 
     /** optional counter. */
     Counter *counter_;
 
+    /** Next fiber in wait list. */
+    Fiber *next_waiter_;
+
+    /** Priority lane to schedule fiber in. */
+    JobPriority priority_;
+
+    /** When fiber was last put on a queue. */
+    std::chrono::steady_clock::time_point scheduled_at_;
+
+    /** Flag if fiber has been started. */
+    bool started_;
+
     /** Optional parent fiber. */
     Fiber *parent_fiber_;
 
@@ -134,6 +276,9 @@ class Fiber
     /** Flag if fiber is not safe to operator on. */
     std::atomic<bool> safe_;
 
+    /** Requested stack size in bytes. */
+    std::size_t stack_size_;
+
     /** Pointer to implementation. */
     struct implementation;
     std::unique_ptr<implementation> impl_;
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+
+#include "jobs/fiber/fiber_mutex.h"
+#include "jobs/fiber/fiber_wait_list.h"
+
+namespace iris
+{
+
+/**
+ * A condition variable for use with FiberMutex. Waiting suspends the calling fiber rather than blocking its worker
+ * thread, if called from a thread which is not a fiber it blocks the thread as normal.
+ *
+ * Unlike std::condition_variable there are no spurious wake ups, but as another waiter may get the mutex first the
+ * predicate overload of wait() should still be preferred.
+ */
+class FiberConditionVariable
+{
+  public:
+    /**
+     * Construct a new FiberConditionVariable.
+     */
+    FiberConditionVariable();
+
+    FiberConditionVariable(const FiberConditionVariable &) = delete;
+    FiberConditionVariable &operator=(const FiberConditionVariable &) = delete;
+    FiberConditionVariable(FiberConditionVariable &&) = delete;
+    FiberConditionVariable &operator=(FiberConditionVariable &&) = delete;
+
+    /**
+     * Atomically unlock the mutex and wait to be notified. The mutex is locked again before this returns.
+     *
+     * @param lock
+     *   Lock on mutex, must be locked by the caller.
+     */
+    void wait(std::unique_lock<FiberMutex> &lock);
+
+    /**
+     * Wait until a predicate is satisfied.
+     *
+     * @param lock
+     *   Lock on mutex, must be locked by the caller.
+     *
+     * @param predicate
+     *   Predicate to wait on, called with the mutex locked.
+     */
+    template <class Predicate>
+    void wait(std::unique_lock<FiberMutex> &lock, Predicate predicate)
+    {
+        while (!predicate())
+        {
+            wait(lock);
+        }
+    }
+
+    /**
+     * Wake a single waiter.
+     */
+    void notify_one();
+
+    /**
+     * Wake all waiters.
+     */
+    void notify_all();
+
+  private:
+    /** Fibers and threads waiting to be notified. */
+    FiberWaitList waiters_;
+};
+
+}
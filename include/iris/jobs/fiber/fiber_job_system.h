@@ -6,28 +6,93 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "core/semaphore.h"
 #include "core/thread.h"
-#include "jobs/concurrent_queue.h"
+#include "jobs/chunk_function.h"
 #include "jobs/fiber/counter.h"
 #include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_pool.h"
+#include "jobs/fiber/worker_stats.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
 #include "jobs/job_system.h"
+#include "jobs/job_system_config.h"
+#include "jobs/main_thread_queue.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/work_stealing_queue.h"
 
 namespace iris
 {
 
 /**
  * Implementation of JobSystem that schedules its jobs using fibers.
+ *
+ * Each worker thread owns a work-stealing queue. Jobs added from a worker are pushed onto its own queue (no locking),
+ * idle workers steal from a randomly chosen victim. Jobs added from outside of a worker thread go via a shared
+ * lock-free queue.
+ *
+ * There is a full set of queues for each JobPriority lane, a worker only looks at a lane once all higher priority
+ * lanes are empty. A fiber resumed after waiting goes back into the lane it was originally scheduled in.
  */
 class FiberJobSystem : public JobSystem
 {
   public:
+    /**
+     * Construct a new FiberJobSystem with one worker per core (minus one for the main thread).
+     */
     FiberJobSystem();
+
+    /**
+     * Construct a new FiberJobSystem with a fixed number of workers.
+     *
+     * @param worker_count
+     *   Number of worker threads to create, must be greater than zero.
+     */
+    explicit FiberJobSystem(std::uint32_t worker_count);
+
+    /**
+     * Construct a new FiberJobSystem with a fixed number of workers and fiber pool size.
+     *
+     * @param worker_count
+     *   Number of worker threads to create, must be greater than zero.
+     *
+     * @param fiber_pool_size
+     *   Maximum number of finished fibers to keep around for reuse.
+     */
+    FiberJobSystem(std::uint32_t worker_count, std::size_t fiber_pool_size);
+
+    /**
+     * Construct a new FiberJobSystem with a configured worker layout.
+     *
+     * @param config
+     *   Config for worker threads.
+     */
+    explicit FiberJobSystem(const JobSystemConfig &config);
+
+    /**
+     * Construct a new FiberJobSystem with a configured worker layout and fiber pool size.
+     *
+     * @param config
+     *   Config for worker threads.
+     *
+     * @param fiber_pool_size
+     *   Maximum number of finished fibers to keep around for reuse.
+     */
+    FiberJobSystem(const JobSystemConfig &config, std::size_t fiber_pool_size);
+
     ~FiberJobSystem() override;
 
     /**
@@ -40,6 +105,19 @@ class FiberJobSystem : public JobSystem
      */
     void add_jobs(const std::vector<Job> &jobs) override;
 
+    /**
+     * Add a collection of jobs. Once added these are executed in a
+     * fire-and-forget manner, there is no way to wait on them to finish or
+     * to know when they have executed.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_jobs(std::span<InlineJob> jobs) override;
+
     /**
      * Add a collection of jobs. Once added this call blocks until all
      * jobs have finished executing.
@@ -49,18 +127,310 @@ class FiberJobSystem : public JobSystem
      */
     void wait_for_jobs(const std::vector<Job> &jobs) override;
 
+    /**
+     * Add a collection of jobs. Once added this call blocks until all
+     * jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void wait_for_jobs(std::span<InlineJob> jobs) override;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added these are
+     * executed in a fire-and-forget manner.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    void add_jobs(std::span<InlineJob> jobs, JobPriority priority) override;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added this call
+     * blocks until all jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    void wait_for_jobs(std::span<InlineJob> jobs, JobPriority priority) override;
+
+    /**
+     * Add a collection of jobs as continuations of the currently running job.
+     * Anything waiting on the current job will also wait for these to finish
+     * (and see any exceptions they throw). If not called from within a job
+     * that is being waited on then these are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span, they run with the same
+     * priority as the current job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_continuation_jobs(std::span<InlineJob> jobs) override;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_main_thread_jobs(const std::vector<Job> &jobs) override;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_main_thread_jobs(std::span<InlineJob> jobs) override;
+
+    /**
+     * Run all jobs queued for the main thread. The main loop should call this
+     * once per frame.
+     *
+     * This must only be called from the main thread.
+     *
+     * @returns
+     *   Number of jobs run.
+     */
+    std::size_t run_main_thread_jobs() override;
+
+    /**
+     * Get the number of jobs queued in each lane.
+     *
+     * @returns
+     *   Queue depths.
+     */
+    JobQueueDepths queue_depths() const override;
+
+    /**
+     * Set what idle workers do before they go to sleep, this can be changed at
+     * any time and is picked up the next time a worker runs out of work.
+     *
+     * @param policy
+     *   New idle policy.
+     */
+    void set_idle_policy(const IdlePolicy &policy) override;
+
+    /**
+     * Get the current idle policy.
+     *
+     * @returns
+     *   Idle policy.
+     */
+    IdlePolicy idle_policy() const override;
+
+    /**
+     * Run a function for every chunk index in [0, chunk_count), spread across
+     * the workers. This call blocks until all chunks have been processed.
+     *
+     * The chunk range is recursively split in half, with each half run as a
+     * separate job, so idle workers can steal large ranges of chunks.
+     *
+     * @param chunk_count
+     *   Number of chunks.
+     *
+     * @param function
+     *   Function to call for each chunk index.
+     */
+    void run_chunks(std::size_t chunk_count, ChunkFunction function) override;
+
+    /**
+     * Get the number of threads jobs are executed on.
+     *
+     * @returns
+     *   Number of worker threads.
+     */
+    std::uint32_t worker_count() const override;
+
+    /**
+     * Get the name and cores of each worker.
+     *
+     * @returns
+     *   Layout of each worker, indexed by worker.
+     */
+    std::vector<WorkerLayout> worker_layout() const override;
+
+    /**
+     * Get a snapshot of fiber pool usage.
+     *
+     * @returns
+     *   Fiber pool stats.
+     */
+    FiberPoolStats fiber_pool_stats() const;
+
+    /**
+     * Get a snapshot of the counters for each worker. This can be called at
+     * any time, it does not stop the workers.
+     *
+     * @returns
+     *   Counters for each worker, indexed by worker.
+     */
+    std::vector<WorkerStats> worker_stats() const;
+
+    /**
+     * Start recording a trace event every time a worker runs a job, any
+     * previously recorded events are discarded.
+     */
+    void start_trace();
+
+    /**
+     * Stop recording trace events.
+     */
+    void stop_trace();
+
+    /**
+     * Get recorded trace events as Chrome trace-event JSON (viewable in
+     * chrome://tracing or Perfetto). Timestamps are relative to the last call
+     * to start_trace.
+     *
+     * @returns
+     *   JSON string.
+     */
+    std::string chrome_trace() const;
+
+    /**
+     * Get the job system that owns the calling worker thread.
+     *
+     * @returns
+     *   Job system of calling worker, or nullptr if not called from a worker.
+     */
+    static FiberJobSystem *current();
+
+    /**
+     * Schedule a suspended fiber to be resumed. This is used by FiberWaitList to wake fibers blocked on a
+     * synchronisation primitive.
+     *
+     * @param fiber
+     *   Fiber to resume, must have been running on one of our workers.
+     */
+    void reschedule(Fiber *fiber);
+
   private:
+    /**
+     * Schedule a collection of fire-and-forget jobs.
+     *
+     * @param jobs
+     *   Jobs to execute, either Job or InlineJob elements.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    template <class Jobs>
+    void add_jobs_impl(Jobs &jobs, JobPriority priority);
+
+    /**
+     * Schedule a collection of jobs and block until they have all finished.
+     *
+     * @param jobs
+     *   Jobs to execute, either Job or InlineJob elements.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    template <class Jobs>
+    void wait_for_jobs_impl(Jobs &jobs, JobPriority priority);
+
+    /**
+     * Run a function for every chunk index in [first, last), splitting the
+     * range in half until there is a single chunk.
+     *
+     * @param first
+     *   First chunk index.
+     *
+     * @param last
+     *   One past the last chunk index.
+     *
+     * @param function
+     *   Function to call for each chunk index.
+     */
+    void run_chunk_range(std::size_t first, std::size_t last, ChunkFunction function);
+
+    /**
+     * Get the queue owned by the calling thread for a priority lane.
+     *
+     * This must not be cached across a fiber suspend, as the fiber may be resumed on a different thread.
+     *
+     * @param priority
+     *   Lane to get queue for.
+     *
+     * @returns
+     *   Queue of calling worker, or nullptr if not called from one of our workers.
+     */
+    WorkStealingQueue<Fiber *> *local_queue(JobPriority priority) const;
+
+    /**
+     * Put a new fiber on a queue in its priority lane and signal a worker.
+     *
+     * @param fiber
+     *   Fiber to schedule.
+     *
+     * @param local_queue
+     *   Queue of calling worker for the fibers lane, or nullptr if not called from one of our workers.
+     */
+    void schedule(Fiber *fiber, WorkStealingQueue<Fiber *> *local_queue);
+
     /** Flag indicating of system is running. */
     std::atomic<bool> running_;
 
     /** Semaphore signally how many fibers are available. */
     Semaphore jobs_semaphore_;
 
+    /** What idle workers do before waiting on jobs_semaphore_. */
+    std::atomic<IdlePolicy> idle_policy_;
+
+    /** Pool of fibers to run jobs in. */
+    FiberPool fiber_pool_;
+
+    /** Name and cores of each worker. */
+    std::vector<WorkerLayout> worker_layout_;
+
     /** Worker threads which execute fibers. */
     std::vector<Thread> workers_;
 
-    /** Queue of fibers.*/
-    ConcurrentQueue<std::tuple<Fiber *, Counter *>> fibers_;
+    /**
+     * Per-lane, per-worker queues of fibers (indexed [lane][worker]), only pushed to by the owning worker but can be
+     * stolen from by any.
+     */
+    std::array<std::vector<std::unique_ptr<WorkStealingQueue<Fiber *>>>, job_priority_count> worker_queues_;
+
+    /**
+     * Per-lane queues of fibers added from non-worker threads. These are bounded, if one fills up then adding jobs
+     * from outside of the workers will wait for them to catch up.
+     */
+    std::array<MpmcQueue<Fiber *>, job_priority_count> fibers_;
+
+    /** Jobs to be run on the main thread. */
+    MainThreadQueue main_thread_jobs_;
+
+    /** Counters for each worker. */
+    std::vector<std::unique_ptr<WorkerCounters>> worker_counters_;
+
+    /** Trace buffer for each worker. */
+    std::vector<std::unique_ptr<WorkerTrace>> worker_traces_;
+
+    /** Flag indicating if workers should record trace events. */
+    std::atomic<bool> tracing_;
+
+    /** When tracing was last started. */
+    std::chrono::steady_clock::time_point trace_start_;
 };
 
 }
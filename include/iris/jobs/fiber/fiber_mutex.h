@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+
+#include "jobs/fiber/fiber_wait_list.h"
+
+namespace iris
+{
+
+/**
+ * A mutex which suspends a waiting fiber rather than blocking its worker thread, so the worker can run other fibers
+ * until the mutex is free. If called from a thread which is not a fiber it blocks the thread as normal.
+ *
+ * Meets the Lockable requirements, so can be used with std::unique_lock and std::scoped_lock. Ownership is handed
+ * directly to the longest waiter on unlock.
+ *
+ * Note that a fiber may be resumed on a different worker thread, so this must not be mixed with anything that relies
+ * on the thread staying the same (e.g. thread_local or std::mutex) whilst it is held.
+ */
+class FiberMutex
+{
+  public:
+    /**
+     * Construct an unlocked mutex.
+     */
+    FiberMutex();
+
+    FiberMutex(const FiberMutex &) = delete;
+    FiberMutex &operator=(const FiberMutex &) = delete;
+    FiberMutex(FiberMutex &&) = delete;
+    FiberMutex &operator=(FiberMutex &&) = delete;
+
+    /**
+     * Lock the mutex, suspending (or blocking) until it is available.
+     */
+    void lock();
+
+    /**
+     * Try and lock the mutex without waiting.
+     *
+     * @returns
+     *   True if the mutex was locked, otherwise false.
+     */
+    bool try_lock();
+
+    /**
+     * Unlock the mutex, waking the next waiter (if any).
+     */
+    void unlock();
+
+  private:
+    /** Flag indicating if the mutex is held. */
+    std::atomic<bool> locked_;
+
+    /** Fibers and threads waiting for the mutex. */
+    FiberWaitList waiters_;
+};
+
+}
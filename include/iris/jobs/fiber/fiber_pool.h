@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "jobs/fiber/counter.h"
+#include "jobs/fiber/fiber.h"
+#include "jobs/inline_job.h"
+
+namespace iris
+{
+
+/**
+ * Snapshot of FiberPool usage.
+ */
+struct FiberPoolStats
+{
+    /** Number of acquires that reused a pooled Fiber. */
+    std::size_t hits;
+
+    /** Number of acquires that had to create a new Fiber. */
+    std::size_t misses;
+
+    /** Number of Fibers currently acquired and not yet released. */
+    std::size_t live;
+
+    /** Highest number of Fibers acquired at once. */
+    std::size_t peak_live;
+};
+
+/**
+ * A thread-safe pool of finished Fibers (and their stacks) that can be reused for new jobs. Creating a Fiber allocates
+ * a guarded stack, which means system calls and page faults, so for small jobs this dominates the cost of running
+ * them.
+ *
+ * Fibers are grouped into stack size classes, an acquire will be served from the smallest class that can fit the
+ * requested stack size.
+ *
+ * Every job acquires and releases a Fiber, so the pool is lock-free. Each size class has a fixed number of slots
+ * which are kept on one of two Treiber stacks (as in ObjectPool), slots holding a pooled Fiber and empty slots. An
+ * acquire or release moves one slot between them, which is a CAS on each stack in the uncontended case.
+ */
+class FiberPool
+{
+  public:
+    /**
+     * Construct a new FiberPool with a single stack size class of Fiber::default_stack_size.
+     *
+     * @param max_pooled
+     *   Maximum number of finished Fibers to keep per stack size class, any more will be destroyed on release.
+     */
+    explicit FiberPool(std::size_t max_pooled = 1024u);
+
+    /**
+     * Construct a new FiberPool with custom stack size classes.
+     *
+     * @param max_pooled
+     *   Maximum number of finished Fibers to keep per stack size class, any more will be destroyed on release.
+     *
+     * @param stack_sizes
+     *   Stack size classes in bytes, must not be empty.
+     */
+    FiberPool(std::size_t max_pooled, std::vector<std::size_t> stack_sizes);
+
+    /**
+     * Destroys all pooled Fibers. Any Fibers not released will *not* be destroyed.
+     */
+    ~FiberPool();
+
+    FiberPool(const FiberPool &) = delete;
+    FiberPool &operator=(const FiberPool &) = delete;
+    FiberPool(FiberPool &&) = delete;
+    FiberPool &operator=(FiberPool &&) = delete;
+
+    /**
+     * Get a Fiber ready to run a job, reusing a pooled one if possible.
+     *
+     * @param job
+     *   Job to run.
+     *
+     * @param counter
+     *   Counter to decrement when job is done, may be nullptr.
+     *
+     * @param stack_size
+     *   Minimum stack size in bytes, must not be larger than the largest stack size class.
+     *
+     * @returns
+     *   Fiber ready to start.
+     */
+    Fiber *acquire(InlineJob job, Counter *counter = nullptr, std::size_t stack_size = Fiber::default_stack_size);
+
+    /**
+     * Return a finished Fiber to the pool.
+     *
+     * @param fiber
+     *   Fiber to return, must have been acquired from this pool and finished running its job.
+     */
+    void release(Fiber *fiber);
+
+    /**
+     * Get a snapshot of pool usage.
+     *
+     * @returns
+     *   Pool stats.
+     */
+    FiberPoolStats stats() const;
+
+  private:
+    /**
+     * Pooled Fibers for a single stack size.
+     */
+    struct SizeClass
+    {
+        /** Stack size in bytes. */
+        std::size_t stack_size;
+
+        /** Pooled Fiber in each slot, only accessed by whoever has popped the slot off a stack. */
+        std::unique_ptr<Fiber *[]> fibers;
+
+        /** Index of the next slot after each slot, in whichever stack the slot is in. */
+        std::unique_ptr<std::atomic<std::uint32_t>[]> next;
+
+        /** Tagged index of the first slot holding a pooled Fiber. */
+        std::atomic<std::uint64_t> pooled;
+
+        /** Tagged index of the first empty slot. */
+        std::atomic<std::uint64_t> empty;
+    };
+
+    /**
+     * Find the smallest size class which can fit the requested stack size.
+     *
+     * @param stack_size
+     *   Stack size in bytes.
+     *
+     * @returns
+     *   Size class.
+     */
+    SizeClass &size_class(std::size_t stack_size);
+
+    /** Maximum number of pooled Fibers per size class. */
+    std::size_t max_pooled_;
+
+    /** Size classes, sorted by stack size. */
+    std::vector<std::unique_ptr<SizeClass>> size_classes_;
+
+    /** Number of acquires that reused a Fiber. */
+    std::atomic<std::size_t> hits_;
+
+    /** Number of acquires that created a Fiber. */
+    std::atomic<std::size_t> misses_;
+
+    /** Number of acquired Fibers. */
+    std::atomic<std::size_t> live_;
+
+    /** Highest number of acquired Fibers. */
+    std::atomic<std::size_t> peak_live_;
+};
+
+}
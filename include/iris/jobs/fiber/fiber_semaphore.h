@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+#include "jobs/fiber/fiber_wait_list.h"
+
+namespace iris
+{
+
+/**
+ * A counting semaphore which suspends a waiting fiber rather than blocking its worker thread. If called from a thread
+ * which is not a fiber it blocks the thread as normal.
+ *
+ * Released permits are handed directly to the longest waiter.
+ */
+class FiberSemaphore
+{
+  public:
+    /**
+     * Construct a new FiberSemaphore.
+     *
+     * @param initial
+     *   Initial number of permits.
+     */
+    explicit FiberSemaphore(std::ptrdiff_t initial = 0);
+
+    FiberSemaphore(const FiberSemaphore &) = delete;
+    FiberSemaphore &operator=(const FiberSemaphore &) = delete;
+    FiberSemaphore(FiberSemaphore &&) = delete;
+    FiberSemaphore &operator=(FiberSemaphore &&) = delete;
+
+    /**
+     * Release permits, waking waiters if there are any.
+     *
+     * @param count
+     *   Number of permits to release.
+     */
+    void release(std::ptrdiff_t count = 1);
+
+    /**
+     * Acquire a permit, suspending (or blocking) until one is available.
+     */
+    void acquire();
+
+    /**
+     * Try and acquire a permit without waiting.
+     *
+     * @returns
+     *   True if a permit was acquired, otherwise false.
+     */
+    bool try_acquire();
+
+  private:
+    /** Number of available permits, guarded by the wait list lock. */
+    std::ptrdiff_t count_;
+
+    /** Fibers and threads waiting for a permit. */
+    FiberWaitList waiters_;
+};
+
+}
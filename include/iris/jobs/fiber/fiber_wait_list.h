@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+#include "jobs/fiber/fiber.h"
+
+namespace iris
+{
+
+class FiberJobSystem;
+
+/**
+ * A FIFO list of fibers (or threads) blocked on a synchronisation primitive. This is the shared building block for
+ * FiberMutex, FiberConditionVariable and FiberSemaphore.
+ *
+ * A waiting fiber is suspended and, when woken, rescheduled on the FiberJobSystem it was running on, so its worker
+ * thread is free to run other fibers in the meantime. A waiting thread which is not a fiber blocks on an OS primitive.
+ *
+ * The list is guarded by an internal spin lock which is only ever held for a handful of instructions and never across a
+ * suspend, callers use it to make their own state changes atomic with adding or removing waiters.
+ */
+class FiberWaitList
+{
+  public:
+    /**
+     * Something waiting on the list. Waiters live on the stack of the waiting fiber or thread, which is kept alive
+     * whilst it is blocked, so waiting never allocates.
+     */
+    class Waiter
+    {
+      public:
+        /**
+         * Construct a waiter for the calling fiber or thread.
+         */
+        Waiter();
+
+        Waiter(const Waiter &) = delete;
+        Waiter &operator=(const Waiter &) = delete;
+        Waiter(Waiter &&) = delete;
+        Waiter &operator=(Waiter &&) = delete;
+
+        /**
+         * Block until woken. Must be called after the waiter has been pushed and the list unlocked.
+         */
+        void block();
+
+        /**
+         * Wake the waiter. Must be called after it has been popped, without the list locked.
+         */
+        void wake();
+
+      private:
+        friend class FiberWaitList;
+
+        /** Waiting fiber, nullptr if the waiter is not running in a fiber. */
+        Fiber *fiber_;
+
+        /** Job system to reschedule fiber_ on. */
+        FiberJobSystem *job_system_;
+
+        /** Next waiter in list. */
+        Waiter *next_;
+
+        /** Flag set when a thread waiter is woken. */
+        bool woken_;
+
+        /** Lock for woken_. */
+        std::mutex mutex_;
+
+        /** Condition variable a thread waiter blocks on. */
+        std::condition_variable condition_;
+    };
+
+    /**
+     * Construct an empty wait list.
+     */
+    FiberWaitList();
+
+    FiberWaitList(const FiberWaitList &) = delete;
+    FiberWaitList &operator=(const FiberWaitList &) = delete;
+    FiberWaitList(FiberWaitList &&) = delete;
+    FiberWaitList &operator=(FiberWaitList &&) = delete;
+
+    /**
+     * Acquire the internal spin lock.
+     */
+    void lock();
+
+    /**
+     * Release the internal spin lock.
+     */
+    void unlock();
+
+    /**
+     * Add a waiter to the back of the list. Must be called with the list locked.
+     *
+     * @param waiter
+     *   Waiter to add.
+     */
+    void push(Waiter &waiter);
+
+    /**
+     * Remove the waiter at the front of the list. Must be called with the list locked.
+     *
+     * @returns
+     *   Removed waiter, or nullptr if the list is empty.
+     */
+    Waiter *pop();
+
+    /**
+     * Remove up to count waiters from the front of the list. Must be called with the list locked.
+     *
+     * @param count
+     *   Maximum number of waiters to remove.
+     *
+     * @returns
+     *   Head of removed waiters, linked in FIFO order, or nullptr if the list is empty. Use next() to walk them and
+     *   wake() each one.
+     */
+    Waiter *pop(std::size_t count);
+
+    /**
+     * Remove all waiters. Must be called with the list locked.
+     *
+     * @returns
+     *   Head of removed waiters, linked in FIFO order, or nullptr if the list is empty. Use next() to walk them and
+     *   wake() each one.
+     */
+    Waiter *pop_all();
+
+    /**
+     * Get the waiter after another in a list returned from pop. This must be read before the waiter is woken.
+     *
+     * @param waiter
+     *   Waiter to get next of.
+     *
+     * @returns
+     *   Next waiter, or nullptr if last.
+     */
+    static Waiter *next(Waiter *waiter);
+
+    /**
+     * Check if there are no waiters. Must be called with the list locked.
+     *
+     * @returns
+     *   True if list is empty, otherwise false.
+     */
+    bool empty() const;
+
+  private:
+    /** Spin lock flag. */
+    std::atomic<bool> locked_;
+
+    /** Front of list. */
+    Waiter *head_;
+
+    /** Back of list. */
+    Waiter *tail_;
+};
+
+}
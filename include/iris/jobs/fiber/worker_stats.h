@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace iris
+{
+
+/** Number of buckets in the queue wait histogram. */
+inline constexpr std::size_t queue_wait_bucket_count = 16u;
+
+/**
+ * Get the (exclusive) upper bound of a queue wait histogram bucket. Bucket zero counts waits under 1us, each bucket
+ * after that doubles the bound and the last bucket counts everything else.
+ *
+ * @param bucket
+ *   Index of bucket.
+ *
+ * @returns
+ *   Upper bound of bucket.
+ */
+constexpr std::chrono::nanoseconds queue_wait_bucket_upper_bound(std::size_t bucket)
+{
+    return (bucket + 1u) < queue_wait_bucket_count ? std::chrono::microseconds(std::int64_t{1} << bucket)
+                                                   : std::chrono::nanoseconds::max();
+}
+
+/**
+ * Snapshot of the counters for a single worker thread.
+ */
+struct WorkerStats
+{
+    /** Number of jobs run to completion. */
+    std::uint64_t jobs_run;
+
+    /** Time spent running fibers. */
+    std::chrono::nanoseconds busy_time;
+
+    /** Time spent looking or waiting for a fiber to run. */
+    std::chrono::nanoseconds idle_time;
+
+    /**
+     * Histogram of how long fibers sat in a queue before this worker picked them up (see
+     * queue_wait_bucket_upper_bound).
+     */
+    std::array<std::uint64_t, queue_wait_bucket_count> queue_wait;
+
+    /** Number of times a fiber suspended (to wait on other jobs) whilst running on this worker. */
+    std::uint64_t fibers_suspended;
+
+    /** Number of times this worker resumed a previously suspended fiber. */
+    std::uint64_t fibers_resumed;
+
+    /** Number of fibers this worker stole from another worker. */
+    std::uint64_t steals;
+};
+
+/**
+ * Counters for a single worker thread. These are only ever written by the owning worker but can be read by any thread
+ * at any time, so they are kept as relaxed atomics.
+ */
+class alignas(64) WorkerCounters
+{
+  public:
+    /**
+     * Construct a new WorkerCounters with everything zeroed.
+     */
+    WorkerCounters();
+
+    /**
+     * Record a job finishing.
+     */
+    void add_job_run()
+    {
+        increment(jobs_run_, 1u);
+    }
+
+    /**
+     * Record time spent running fibers.
+     *
+     * @param duration
+     *   Time spent.
+     */
+    void add_busy_time(std::chrono::nanoseconds duration)
+    {
+        increment(busy_ns_, static_cast<std::uint64_t>(duration.count()));
+    }
+
+    /**
+     * Record time spent idle.
+     *
+     * @param duration
+     *   Time spent.
+     */
+    void add_idle_time(std::chrono::nanoseconds duration)
+    {
+        increment(idle_ns_, static_cast<std::uint64_t>(duration.count()));
+    }
+
+    /**
+     * Record how long a fiber was queued for.
+     *
+     * @param duration
+     *   Time fiber was queued.
+     */
+    void add_queue_wait(std::chrono::nanoseconds duration);
+
+    /**
+     * Record a fiber suspending.
+     */
+    void add_suspend()
+    {
+        increment(fibers_suspended_, 1u);
+    }
+
+    /**
+     * Record a fiber being resumed.
+     */
+    void add_resume()
+    {
+        increment(fibers_resumed_, 1u);
+    }
+
+    /**
+     * Record a successful steal.
+     */
+    void add_steal()
+    {
+        increment(steals_, 1u);
+    }
+
+    /**
+     * Get a snapshot of the counters. Counters are read individually, so may be very slightly out of step with each
+     * other.
+     *
+     * @returns
+     *   Snapshot of counters.
+     */
+    WorkerStats snapshot() const;
+
+  private:
+    /**
+     * Increment a counter. As there is only a single writer this does not need to be an atomic read-modify-write.
+     *
+     * @param counter
+     *   Counter to increment.
+     *
+     * @param value
+     *   Amount to increment by.
+     */
+    static void increment(std::atomic<std::uint64_t> &counter, std::uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /** Number of jobs run. */
+    std::atomic<std::uint64_t> jobs_run_;
+
+    /** Nanoseconds spent busy. */
+    std::atomic<std::uint64_t> busy_ns_;
+
+    /** Nanoseconds spent idle. */
+    std::atomic<std::uint64_t> idle_ns_;
+
+    /** Queue wait histogram. */
+    std::array<std::atomic<std::uint64_t>, queue_wait_bucket_count> queue_wait_;
+
+    /** Number of suspends. */
+    std::atomic<std::uint64_t> fibers_suspended_;
+
+    /** Number of resumes. */
+    std::atomic<std::uint64_t> fibers_resumed_;
+
+    /** Number of steals. */
+    std::atomic<std::uint64_t> steals_;
+};
+
+/**
+ * A single slice of a job running on a worker, from when the fiber was started or resumed until it finished or
+ * suspended.
+ */
+struct JobTraceEvent
+{
+    /** Address of the fiber the job ran in, identifies a job across suspends. */
+    std::uintptr_t fiber;
+
+    /** When the slice began. */
+    std::chrono::steady_clock::time_point begin;
+
+    /** When the slice ended. */
+    std::chrono::steady_clock::time_point end;
+
+    /** True if the slice began with a resume, false if it was the start of the job. */
+    bool resumed;
+
+    /** True if the slice ended with the fiber suspending, false if the job finished. */
+    bool suspended;
+};
+
+/**
+ * Buffer of trace events for a single worker thread.
+ */
+class WorkerTrace
+{
+  public:
+    /**
+     * Construct an empty trace.
+     */
+    WorkerTrace();
+
+    /**
+     * Record an event.
+     *
+     * @param event
+     *   Event to record.
+     */
+    void record(const JobTraceEvent &event);
+
+    /**
+     * Remove all recorded events.
+     */
+    void clear();
+
+    /**
+     * Get a copy of all recorded events.
+     *
+     * @returns
+     *   Recorded events.
+     */
+    std::vector<JobTraceEvent> events() const;
+
+  private:
+    /** Recorded events. */
+    std::vector<JobTraceEvent> events_;
+
+    /** Lock for events_, only contended whilst the trace is being read. */
+    mutable std::mutex mutex_;
+};
+
+/**
+ * Convert per-worker trace events to Chrome trace-event JSON (viewable in chrome://tracing or Perfetto). Each worker
+ * is shown as a separate thread.
+ *
+ * @param traces
+ *   Events for each worker, indexed by worker.
+ *
+ * @param start
+ *   Time to use as zero for event timestamps.
+ *
+ * @returns
+ *   JSON string.
+ */
+std::string to_chrome_trace(
+    const std::vector<std::vector<JobTraceEvent>> &traces,
+    std::chrono::steady_clock::time_point start);
+
+}
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+#if defined(IRIS_ARCH_X86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+namespace iris
+{
+
+/**
+ * Controls what an idle worker does before it goes to sleep. A worker with nothing to do first spins (checking for
+ * work between pause instructions), then yields its time slice a number of times, and finally parks on an OS
+ * primitive until it is woken.
+ *
+ * Spinning gives the lowest wake-up latency but burns a core whilst idle, parking immediately uses no CPU but every
+ * wake-up goes through the kernel.
+ */
+struct IdlePolicy
+{
+    /** Number of times to check for work (with a pause between each) before yielding. */
+    std::uint32_t spin_count;
+
+    /** Number of times to check for work (yielding between each) before parking. */
+    std::uint32_t yield_count;
+
+    /**
+     * Policy for machines with cores to spare e.g. a dedicated server.
+     *
+     * @returns
+     *   Low latency policy.
+     */
+    static constexpr IdlePolicy low_latency()
+    {
+        return {.spin_count = 16384u, .yield_count = 256u};
+    }
+
+    /**
+     * Default policy, a short spin to catch jobs that arrive in quick succession.
+     *
+     * @returns
+     *   Balanced policy.
+     */
+    static constexpr IdlePolicy balanced()
+    {
+        return {.spin_count = 1024u, .yield_count = 16u};
+    }
+
+    /**
+     * Policy for battery powered machines, park straight away.
+     *
+     * @returns
+     *   Low power policy.
+     */
+    static constexpr IdlePolicy low_power()
+    {
+        return {.spin_count = 0u, .yield_count = 0u};
+    }
+};
+
+/**
+ * Hint to the CPU that we are in a spin loop. This reduces power usage and lets a sibling hyper-thread make progress.
+ */
+inline void cpu_relax()
+{
+#if defined(IRIS_ARCH_X86_64)
+    _mm_pause();
+#elif defined(IRIS_ARCH_ARM64)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * Spin and then yield according to a policy until a predicate is satisfied or the policy is exhausted. If this
+ * returns false the caller should park.
+ *
+ * @param policy
+ *   Policy controlling how long to spin and yield for.
+ *
+ * @param ready
+ *   Predicate to check for work, may have side effects (e.g. acquiring a semaphore).
+ *
+ * @returns
+ *   True if ready returned true, false if policy was exhausted.
+ */
+template <class Ready>
+bool idle_wait(const IdlePolicy &policy, Ready &&ready)
+{
+    for (auto i = 0u; i < policy.spin_count; ++i)
+    {
+        if (ready())
+        {
+            return true;
+        }
+
+        cpu_relax();
+    }
+
+    for (auto i = 0u; i < policy.yield_count; ++i)
+    {
+        if (ready())
+        {
+            return true;
+        }
+
+        std::this_thread::yield();
+    }
+
+    return false;
+}
+
+/**
+ * Wait for a predicate which is expected to become true very soon (e.g. another thread finishing a short critical
+ * section). Spins briefly and then yields, so if the other thread has been descheduled we don't burn our time slice.
+ *
+ * @param ready
+ *   Predicate to wait on.
+ */
+template <class Ready>
+void spin_until(Ready &&ready)
+{
+    static constexpr auto spin_count = 64u;
+
+    for (auto i = 0u; !ready(); ++i)
+    {
+        if (i < spin_count)
+        {
+            cpu_relax();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+}
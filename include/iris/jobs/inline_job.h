@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * A move-only job which stores its callable inline, so constructing one never allocates. The size of the callable is
+ * checked at compile time, anything with a capture larger than InlineJob::capacity will fail to compile.
+ *
+ * This is the type the job systems run internally. A Job (std::function) can be converted to an InlineJob, but if
+ * its capture was too large for the std::function small buffer it will already have allocated.
+ */
+class InlineJob
+{
+  public:
+    /** Maximum size in bytes of a callable that can be stored. */
+    static constexpr std::size_t capacity = 64u;
+
+    /**
+     * Construct an empty job.
+     */
+    InlineJob()
+        : storage_()
+        , vtable_(nullptr)
+    {
+    }
+
+    /**
+     * Construct an empty job.
+     */
+    InlineJob(std::nullptr_t)
+        : InlineJob()
+    {
+    }
+
+    /**
+     * Construct a job from a callable.
+     *
+     * @param function
+     *   Callable to store, will be perfectly forwarded.
+     */
+    template <class F>
+        requires(!std::same_as<std::remove_cvref_t<F>, InlineJob>) && std::invocable<std::decay_t<F> &>
+    InlineJob(F &&function)
+        : storage_()
+        , vtable_(&vtable_for<std::decay_t<F>>)
+    {
+        using Function = std::decay_t<F>;
+
+        static_assert(sizeof(Function) <= capacity, "job capture too large for inline storage");
+        static_assert(alignof(Function) <= alignof(std::max_align_t), "job capture over aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Function>, "job must be nothrow move constructible");
+
+        ::new (static_cast<void *>(storage_)) Function(std::forward<F>(function));
+    }
+
+    ~InlineJob()
+    {
+        reset();
+    }
+
+    InlineJob(const InlineJob &) = delete;
+    InlineJob &operator=(const InlineJob &) = delete;
+
+    InlineJob(InlineJob &&other) noexcept
+        : storage_()
+        , vtable_(std::exchange(other.vtable_, nullptr))
+    {
+        if (vtable_ != nullptr)
+        {
+            vtable_->move(storage_, other.storage_);
+        }
+    }
+
+    InlineJob &operator=(InlineJob &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+
+            vtable_ = std::exchange(other.vtable_, nullptr);
+
+            if (vtable_ != nullptr)
+            {
+                vtable_->move(storage_, other.storage_);
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * Run the job.
+     */
+    void operator()()
+    {
+        expect(vtable_ != nullptr, "cannot invoke empty job");
+
+        vtable_->invoke(storage_);
+    }
+
+    /**
+     * Check if job is not empty.
+     *
+     * @returns
+     *   True if job has a callable, false otherwise.
+     */
+    explicit operator bool() const
+    {
+        return vtable_ != nullptr;
+    }
+
+  private:
+    /**
+     * Type erased operations for the stored callable.
+     */
+    struct VTable
+    {
+        /** Invoke callable. */
+        void (*invoke)(std::byte *);
+
+        /** Move construct callable into dst and destroy src. */
+        void (*move)(std::byte *dst, std::byte *src);
+
+        /** Destroy callable. */
+        void (*destroy)(std::byte *);
+    };
+
+    /** VTable for a given callable type. */
+    template <class Function>
+    static constexpr VTable vtable_for = {
+        .invoke = [](std::byte *storage) { (*std::launder(reinterpret_cast<Function *>(storage)))(); },
+        .move =
+            [](std::byte *dst, std::byte *src)
+        {
+            auto *function = std::launder(reinterpret_cast<Function *>(src));
+            ::new (static_cast<void *>(dst)) Function(std::move(*function));
+            std::destroy_at(function);
+        },
+        .destroy = [](std::byte *storage) { std::destroy_at(std::launder(reinterpret_cast<Function *>(storage))); }};
+
+    /**
+     * Destroy any stored callable, leaving the job empty.
+     */
+    void reset()
+    {
+        if (vtable_ != nullptr)
+        {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+    /** Inline storage for callable. */
+    alignas(std::max_align_t) std::byte storage_[capacity];
+
+    /** Operations for stored callable, nullptr if empty. */
+    const VTable *vtable_;
+};
+
+}
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of job priorities. Workers always take a job from the highest priority lane that has one, jobs within
+ * a lane are not reordered.
+ */
+enum class JobPriority : std::uint32_t
+{
+    /**
+     * Latency critical work, e.g. jobs which must finish this frame.
+     */
+    HIGH,
+
+    /**
+     * Default priority.
+     */
+    NORMAL,
+
+    /**
+     * Work that can be delayed indefinitely by other jobs, e.g. asset decoding.
+     */
+    BACKGROUND
+};
+
+/** Number of JobPriority values, useful for sizing per-lane storage. */
+inline constexpr std::size_t job_priority_count = 3u;
+
+}
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+namespace iris
+{
+
+/**
+ * Snapshot of the number of jobs queued but not yet started, per lane. As jobs are constantly being queued and taken
+ * these should be treated as approximate.
+ */
+struct JobQueueDepths
+{
+    /** Number of queued JobPriority::HIGH jobs. */
+    std::size_t high;
+
+    /** Number of queued JobPriority::NORMAL jobs. */
+    std::size_t normal;
+
+    /** Number of queued JobPriority::BACKGROUND jobs. */
+    std::size_t background;
+
+    /** Number of jobs waiting for the main thread. */
+    std::size_t main_thread;
+};
+
+}
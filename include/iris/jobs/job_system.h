@@ -6,9 +6,18 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 
+#include "jobs/chunk_function.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
+#include "jobs/job_system_config.h"
 
 namespace iris
 {
@@ -37,6 +46,19 @@ class JobSystem
      */
     virtual void add_jobs(const std::vector<Job> &jobs) = 0;
 
+    /**
+     * Add a collection of jobs. Once added these are executed in a
+     * fire-and-forget manner, there is no way to wait on them to finish or
+     * to know when they have executed.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add_jobs(std::span<InlineJob> jobs) = 0;
+
     /**
      * Add a collection of jobs. Once added this call blocks until all
      * jobs have finished executing.
@@ -45,6 +67,144 @@ class JobSystem
      *   Jobs to execute.
      */
     virtual void wait_for_jobs(const std::vector<Job> &jobs) = 0;
+
+    /**
+     * Add a collection of jobs. Once added this call blocks until all
+     * jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void wait_for_jobs(std::span<InlineJob> jobs) = 0;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added these are
+     * executed in a fire-and-forget manner.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    virtual void add_jobs(std::span<InlineJob> jobs, JobPriority priority) = 0;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added this call
+     * blocks until all jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    virtual void wait_for_jobs(std::span<InlineJob> jobs, JobPriority priority) = 0;
+
+    /**
+     * Add a collection of jobs as continuations of the currently running job.
+     * Anything waiting on the current job will also wait for these to finish
+     * (and see any exceptions they throw). If not called from within a job
+     * that is being waited on then these are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span, they run with the same
+     * priority as the current job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add_continuation_jobs(std::span<InlineJob> jobs) = 0;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add_main_thread_jobs(const std::vector<Job> &jobs) = 0;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add_main_thread_jobs(std::span<InlineJob> jobs) = 0;
+
+    /**
+     * Run all jobs queued for the main thread. The main loop should call this
+     * once per frame.
+     *
+     * This must only be called from the main thread.
+     *
+     * @returns
+     *   Number of jobs run.
+     */
+    virtual std::size_t run_main_thread_jobs() = 0;
+
+    /**
+     * Get the number of jobs queued in each lane.
+     *
+     * @returns
+     *   Queue depths.
+     */
+    virtual JobQueueDepths queue_depths() const = 0;
+
+    /**
+     * Set what idle workers do before they go to sleep, this can be changed at
+     * any time and is picked up the next time a worker runs out of work.
+     *
+     * @param policy
+     *   New idle policy.
+     */
+    virtual void set_idle_policy(const IdlePolicy &policy) = 0;
+
+    /**
+     * Get the current idle policy.
+     *
+     * @returns
+     *   Idle policy.
+     */
+    virtual IdlePolicy idle_policy() const = 0;
+
+    /**
+     * Run a function for every chunk index in [0, chunk_count), spread across
+     * the workers. This call blocks until all chunks have been processed.
+     *
+     * @param chunk_count
+     *   Number of chunks.
+     *
+     * @param function
+     *   Function to call for each chunk index.
+     */
+    virtual void run_chunks(std::size_t chunk_count, ChunkFunction function) = 0;
+
+    /**
+     * Get the number of threads jobs are executed on.
+     *
+     * @returns
+     *   Number of worker threads.
+     */
+    virtual std::uint32_t worker_count() const = 0;
+
+    /**
+     * Get the name and cores of each worker.
+     *
+     * @returns
+     *   Layout of each worker, indexed by worker.
+     */
+    virtual std::vector<WorkerLayout> worker_layout() const = 0;
 };
 
 }
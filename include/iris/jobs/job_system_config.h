@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace iris
+{
+
+class Thread;
+
+/**
+ * Configuration for the worker threads of a job system. The defaults give the same layout as before this was
+ * configurable: one unpinned worker per core, minus one for the main thread.
+ */
+struct JobSystemConfig
+{
+    /** Number of workers, zero means one per core not otherwise reserved. */
+    std::uint32_t worker_count = 0u;
+
+    /** Cores workers must not run on, e.g. to keep them free for the main and network threads. */
+    std::vector<std::size_t> reserved_cores = {};
+
+    /**
+     * Cores each worker may run on (indexed by worker), a missing or empty entry means any core that is not
+     * reserved.
+     */
+    std::vector<std::vector<std::size_t>> worker_affinity = {};
+
+    /** Name of each worker (indexed by worker), a missing or empty entry gets a default name. */
+    std::vector<std::string> worker_names = {};
+
+    /** If true then workers without an explicit affinity are each pinned to a single core, round-robin. */
+    bool pin_workers = false;
+};
+
+/**
+ * The resolved layout of a single worker thread.
+ */
+struct WorkerLayout
+{
+    /** Name of worker thread. */
+    std::string name;
+
+    /** Cores the worker may run on, empty if it can run on any core. */
+    std::vector<std::size_t> cores;
+};
+
+/**
+ * Build a job system config from program arguments. Unrecognised arguments are ignored, supported arguments are:
+ *  --jobs-workers=<count>
+ *  --jobs-reserve=<core>,<core>,...
+ *  --jobs-affinity=<cores for worker 0>/<cores for worker 1>/... (cores are comma separated)
+ *  --jobs-names=<name>,<name>,...
+ *  --jobs-pin
+ *
+ * @param args
+ *   Program arguments.
+ *
+ * @returns
+ *   Parsed config.
+ */
+JobSystemConfig parse_job_system_config(const std::vector<std::string> &args);
+
+/**
+ * Resolve a config to the layout of each worker.
+ *
+ * @param config
+ *   Config to resolve.
+ *
+ * @param core_count
+ *   Number of cores on the machine.
+ *
+ * @returns
+ *   Layout of each worker, indexed by worker.
+ */
+std::vector<WorkerLayout> resolve_worker_layout(const JobSystemConfig &config, std::uint32_t core_count);
+
+/**
+ * Get a config for a fixed number of otherwise default workers.
+ *
+ * @param worker_count
+ *   Number of workers, must be greater than zero.
+ *
+ * @returns
+ *   Config for workers.
+ */
+JobSystemConfig fixed_worker_config(std::uint32_t worker_count);
+
+/**
+ * Name and pin a newly created worker as per its layout, and report it. If the worker cannot be pinned (e.g. the cores
+ * are outside our cpuset) it is left unpinned and a warning is logged.
+ *
+ * @param worker
+ *   Worker thread.
+ *
+ * @param layout
+ *   Layout of worker.
+ *
+ * @param index
+ *   Index of worker.
+ */
+void apply_layout(Thread &worker, const WorkerLayout &layout, std::size_t index);
+
+/**
+ * Write a WorkerLayout to a stream, useful for debugging.
+ *
+ * @param out
+ *   Stream to write to.
+ *
+ * @param layout
+ *   WorkerLayout to write to stream.
+ *
+ * @returns
+ *   Reference to input stream.
+ */
+inline std::ostream &operator<<(std::ostream &out, const WorkerLayout &layout)
+{
+    out << layout.name << " [";
+
+    if (layout.cores.empty())
+    {
+        out << "any";
+    }
+
+    for (auto i = 0u; i < layout.cores.size(); ++i)
+    {
+        out << (i == 0u ? "" : ",") << layout.cores[i];
+    }
+
+    return out << "]";
+}
+
+}
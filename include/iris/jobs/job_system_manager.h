@@ -6,10 +6,22 @@
 
 #pragma once
 
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "jobs/chunk_function.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
 #include "jobs/job_system.h"
+#include "jobs/job_system_config.h"
 
 namespace iris
 {
@@ -31,6 +43,17 @@ class JobSystemManager
      */
     virtual JobSystem *create_job_system() = 0;
 
+    /**
+     * Create a JobSystem with a given worker layout.
+     *
+     * @param config
+     *   Config for worker threads.
+     *
+     * @returns
+     *   Pointer to JobSystem.
+     */
+    virtual JobSystem *create_job_system(const JobSystemConfig &config) = 0;
+
     /**
      * Add a collection of jobs. Once added these are executed in a
      * fire-and-forget manner, there is no way to wait on them to finish or
@@ -41,6 +64,19 @@ class JobSystemManager
      */
     virtual void add(const std::vector<Job> &jobs) = 0;
 
+    /**
+     * Add a collection of jobs. Once added these are executed in a
+     * fire-and-forget manner, there is no way to wait on them to finish or
+     * to know when they have executed.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add(std::span<InlineJob> jobs) = 0;
+
     /**
      * Add a collection of jobs. Once added this call blocks until all
      * jobs have finished executing.
@@ -49,6 +85,317 @@ class JobSystemManager
      *   Jobs to execute.
      */
     virtual void wait(const std::vector<Job> &jobs) = 0;
+
+    /**
+     * Add a collection of jobs. Once added this call blocks until all
+     * jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void wait(std::span<InlineJob> jobs) = 0;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added these are
+     * executed in a fire-and-forget manner.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    virtual void add(std::span<InlineJob> jobs, JobPriority priority) = 0;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added this call
+     * blocks until all jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    virtual void wait(std::span<InlineJob> jobs, JobPriority priority) = 0;
+
+    /**
+     * Add a collection of jobs as continuations of the currently running job.
+     * Anything waiting on the current job will also wait for these to finish
+     * (and see any exceptions they throw). If not called from within a job
+     * that is being waited on then these are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span, they run with the same
+     * priority as the current job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add_continuation(std::span<InlineJob> jobs) = 0;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add_main_thread(const std::vector<Job> &jobs) = 0;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    virtual void add_main_thread(std::span<InlineJob> jobs) = 0;
+
+    /**
+     * Run all jobs queued for the main thread. The main loop should call this
+     * once per frame.
+     *
+     * This must only be called from the main thread.
+     *
+     * @returns
+     *   Number of jobs run.
+     */
+    virtual std::size_t run_main_thread_jobs() = 0;
+
+    /**
+     * Get the number of jobs queued in each lane.
+     *
+     * @returns
+     *   Queue depths.
+     */
+    virtual JobQueueDepths queue_depths() const = 0;
+
+    /**
+     * Set what idle workers do before they go to sleep, this can be changed at
+     * any time and is picked up the next time a worker runs out of work.
+     *
+     * @param policy
+     *   New idle policy.
+     */
+    virtual void set_idle_policy(const IdlePolicy &policy) = 0;
+
+    /**
+     * Get the current idle policy.
+     *
+     * @returns
+     *   Idle policy.
+     */
+    virtual IdlePolicy idle_policy() const = 0;
+
+    /**
+     * Run a function for every chunk index in [0, chunk_count), spread across
+     * the workers. This call blocks until all chunks have been processed.
+     *
+     * In general parallel_for or parallel_reduce should be used instead.
+     *
+     * @param chunk_count
+     *   Number of chunks.
+     *
+     * @param function
+     *   Function to call for each chunk index.
+     */
+    virtual void run_chunks(std::size_t chunk_count, ChunkFunction function) = 0;
+
+    /**
+     * Get the number of threads jobs are executed on.
+     *
+     * @returns
+     *   Number of worker threads.
+     */
+    virtual std::uint32_t worker_count() const = 0;
+
+    /**
+     * Get the name and cores of each worker.
+     *
+     * @returns
+     *   Layout of each worker, indexed by worker.
+     */
+    virtual std::vector<WorkerLayout> worker_layout() const = 0;
+
+    /**
+     * Call a function for every index in [begin, end), spread across the
+     * workers. This call blocks until every index has been processed.
+     *
+     * The range is split into contiguous chunks of at least grain indices, with
+     * a few chunks per worker so uneven work can be balanced. If the range fits
+     * in a single chunk it is processed on the calling thread.
+     *
+     * @param begin
+     *   First index.
+     *
+     * @param end
+     *   One past the last index.
+     *
+     * @param grain
+     *   Minimum number of indices per chunk.
+     *
+     * @param function
+     *   Callable as either function(index) or function(chunk_begin,
+     *   chunk_end), will be called concurrently.
+     */
+    template <class F>
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, F &&function)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        const auto chunk_size = parallel_chunk_size(end - begin, grain);
+        const auto chunk_count = ((end - begin) + chunk_size - 1u) / chunk_size;
+
+        const auto process = [begin, end, chunk_size, &function](std::size_t chunk)
+        {
+            const auto chunk_begin = begin + (chunk * chunk_size);
+            const auto chunk_end = std::min(chunk_begin + chunk_size, end);
+
+            if constexpr (std::invocable<F &, std::size_t, std::size_t>)
+            {
+                function(chunk_begin, chunk_end);
+            }
+            else
+            {
+                for (auto i = chunk_begin; i < chunk_end; ++i)
+                {
+                    function(i);
+                }
+            }
+        };
+
+        if (chunk_count == 1u)
+        {
+            process(0u);
+        }
+        else
+        {
+            run_chunks(chunk_count, process);
+        }
+    }
+
+    /**
+     * Map every index in [begin, end) to a value and reduce them to a single
+     * result, spread across the workers. This call blocks until the result is
+     * available.
+     *
+     * The range is chunked as per parallel_for. Each chunk is reduced
+     * separately and then the chunk results are reduced in order on the
+     * calling thread, so the result does not depend on scheduling.
+     *
+     * @param begin
+     *   First index.
+     *
+     * @param end
+     *   One past the last index.
+     *
+     * @param grain
+     *   Minimum number of indices per chunk.
+     *
+     * @param identity
+     *   Identity value for reduce, used as the starting value for each chunk.
+     *
+     * @param map
+     *   Callable as either map(index) or map(chunk_begin, chunk_end), returning
+     *   a value to reduce. Will be called concurrently.
+     *
+     * @param reduce
+     *   Callable as reduce(T, T) returning the combined value, must be
+     *   associative. Will be called concurrently.
+     *
+     * @returns
+     *   Reduced value, or identity if the range is empty.
+     */
+    template <class T, class Map, class Reduce>
+    T parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, Map &&map, Reduce &&reduce)
+    {
+        if (begin >= end)
+        {
+            return identity;
+        }
+
+        // each chunk writes to its own cache line
+        struct alignas(64) Partial
+        {
+            T value;
+        };
+
+        const auto chunk_size = parallel_chunk_size(end - begin, grain);
+        const auto chunk_count = ((end - begin) + chunk_size - 1u) / chunk_size;
+        std::vector<Partial> partials(chunk_count, Partial{identity});
+
+        const auto process = [begin, end, chunk_size, &partials, &map, &reduce](std::size_t chunk)
+        {
+            const auto chunk_begin = begin + (chunk * chunk_size);
+            const auto chunk_end = std::min(chunk_begin + chunk_size, end);
+            auto &partial = partials[chunk].value;
+
+            if constexpr (std::invocable<Map &, std::size_t, std::size_t>)
+            {
+                partial = reduce(std::move(partial), map(chunk_begin, chunk_end));
+            }
+            else
+            {
+                for (auto i = chunk_begin; i < chunk_end; ++i)
+                {
+                    partial = reduce(std::move(partial), map(i));
+                }
+            }
+        };
+
+        if (chunk_count == 1u)
+        {
+            process(0u);
+        }
+        else
+        {
+            run_chunks(chunk_count, process);
+        }
+
+        auto result = std::move(identity);
+
+        for (auto &partial : partials)
+        {
+            result = reduce(std::move(result), std::move(partial.value));
+        }
+
+        return result;
+    }
+
+  private:
+    /**
+     * Calculate the chunk size for a parallel loop.
+     *
+     * @param count
+     *   Number of indices in loop.
+     *
+     * @param grain
+     *   Minimum number of indices per chunk.
+     *
+     * @returns
+     *   Number of indices per chunk.
+     */
+    std::size_t parallel_chunk_size(std::size_t count, std::size_t grain) const
+    {
+        // a few chunks per worker means there is still something to steal if some chunks take longer than others
+        static constexpr std::size_t chunks_per_worker = 4u;
+
+        const auto target_chunks = std::max(std::size_t{worker_count()}, std::size_t{1u}) * chunks_per_worker;
+
+        return std::max({grain, std::size_t{1u}, (count + target_chunks - 1u) / target_chunks});
+    }
 };
 
 }
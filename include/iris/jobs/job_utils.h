@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+#include "jobs/job_priority.h"
+
+// internal helpers shared by the job system implementations
+
+namespace iris
+{
+
+/**
+ * Get an InlineJob to run for a Job, this copies the job.
+ *
+ * @param job
+ *   Job to copy.
+ *
+ * @returns
+ *   InlineJob wrapping a copy of job.
+ */
+inline InlineJob take_job(const Job &job)
+{
+    return {job};
+}
+
+/**
+ * Get an InlineJob to run for an InlineJob, this moves out of the job.
+ *
+ * @param job
+ *   Job to move from.
+ *
+ * @returns
+ *   Moved job.
+ */
+inline InlineJob take_job(InlineJob &job)
+{
+    return std::move(job);
+}
+
+/**
+ * Get the index of a priority lane.
+ *
+ * @param priority
+ *   Priority to get lane of.
+ *
+ * @returns
+ *   Lane index, higher priorities have lower indices.
+ */
+inline std::size_t lane(JobPriority priority)
+{
+    return static_cast<std::size_t>(priority);
+}
+
+}
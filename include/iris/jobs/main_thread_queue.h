@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+
+namespace iris
+{
+
+/**
+ * A thread-safe queue of jobs which must be run on the main thread (e.g. anything that touches the graphics API). Any
+ * thread can add jobs, the main loop runs them at a defined point each frame by calling run().
+ */
+class MainThreadQueue
+{
+  public:
+    /**
+     * Construct an empty queue.
+     */
+    MainThreadQueue();
+
+    MainThreadQueue(const MainThreadQueue &) = delete;
+    MainThreadQueue &operator=(const MainThreadQueue &) = delete;
+    MainThreadQueue(MainThreadQueue &&) = delete;
+    MainThreadQueue &operator=(MainThreadQueue &&) = delete;
+
+    /**
+     * Add a collection of jobs, these are copied.
+     *
+     * @param jobs
+     *   Jobs to queue.
+     */
+    void enqueue(const std::vector<Job> &jobs);
+
+    /**
+     * Add a collection of jobs, these are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to queue.
+     */
+    void enqueue(std::span<InlineJob> jobs);
+
+    /**
+     * Run all jobs queued at the time of the call, in the order they were queued. Jobs queued whilst this is running
+     * (including by the jobs themselves) are left for the next call.
+     *
+     * If any jobs throw then the remaining jobs are still run, and the first exception is rethrown at the end.
+     *
+     * This must only be called from the main thread, and not from within one of the jobs it runs.
+     *
+     * @returns
+     *   Number of jobs run.
+     */
+    std::size_t run();
+
+    /**
+     * Get the number of queued jobs.
+     *
+     * @returns
+     *   Number of queued jobs.
+     */
+    std::size_t size() const;
+
+  private:
+    /** Queued jobs. */
+    std::vector<InlineJob> jobs_;
+
+    /** Jobs being run, kept as a member so its capacity is reused each call. */
+    std::vector<InlineJob> running_;
+
+    /** Lock for jobs_. */
+    mutable std::mutex mutex_;
+};
+
+}
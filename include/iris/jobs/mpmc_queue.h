@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * A bounded lock-free multi-producer multi-consumer FIFO queue, based on Dmitry Vyukov's ring buffer design. Each slot
+ * has a sequence number which tells producers and consumers whether it is free or full for their position, so the only
+ * contention is a CAS on the shared enqueue or dequeue position.
+ *
+ * This has the same enqueue/try_dequeue surface as ConcurrentQueue, so can be swapped in where a fixed capacity is
+ * acceptable. Unlike ConcurrentQueue, try_dequeue only fails if the queue is empty and never allocates.
+ */
+template <class T>
+class MpmcQueue
+{
+  public:
+    // member types
+    using size_type = std::size_t;
+    using value_type = T;
+    using reference = T &;
+
+    /**
+     * Construct an empty queue.
+     *
+     * @param capacity
+     *   Maximum number of elements, must be a power of two.
+     */
+    explicit MpmcQueue(size_type capacity = 1024u)
+        : cells_(std::make_unique<Cell[]>(capacity))
+        , mask_(capacity - 1u)
+        , enqueue_position_(0u)
+        , dequeue_position_(0u)
+    {
+        ensure((capacity >= 2u) && ((capacity & (capacity - 1u)) == 0u), "capacity must be a power of two");
+
+        for (auto i = 0u; i < capacity; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue()
+    {
+        // no one else can be using the queue, so destroy anything left in it
+        const auto end = enqueue_position_.load(std::memory_order_relaxed);
+        for (auto position = dequeue_position_.load(std::memory_order_relaxed); position != end; ++position)
+        {
+            std::destroy_at(std::launder(reinterpret_cast<value_type *>(cells_[position & mask_].storage)));
+        }
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+    MpmcQueue(MpmcQueue &&) = delete;
+    MpmcQueue &operator=(MpmcQueue &&) = delete;
+
+    /**
+     * Check if the queue is empty. This is only a snapshot, it may be out of date by the time it returns.
+     *
+     * @returns
+     *   True if queue is empty, else false.
+     */
+    bool empty() const
+    {
+        return size() == 0u;
+    }
+
+    /**
+     * Get the number of elements in the queue. This is only a snapshot, it may be out of date by the time it returns.
+     *
+     * @returns
+     *   Number of elements.
+     */
+    size_type size() const
+    {
+        const auto dequeue_position = dequeue_position_.load(std::memory_order_acquire);
+        const auto enqueue_position = enqueue_position_.load(std::memory_order_acquire);
+
+        return enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0u;
+    }
+
+    /**
+     * Get the maximum number of elements the queue can hold.
+     *
+     * @returns
+     *   Capacity.
+     */
+    size_type capacity() const
+    {
+        return mask_ + 1u;
+    }
+
+    /**
+     * Try and add an item to the end of the queue.
+     *
+     * @param args
+     *   Arguments for object being places in queue, will be perfectly forwarded.
+     *
+     * @returns
+     *   True if the item was added, false if the queue was full.
+     */
+    template <class... Args>
+    bool try_enqueue(Args &&...args)
+    {
+        auto position = enqueue_position_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+
+        for (;;)
+        {
+            cell = &cells_[position & mask_];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+            if (diff == 0)
+            {
+                // slot is free for our position, try and claim it
+                if (enqueue_position_.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // slot still holds the value from the previous lap, so we are full
+                return false;
+            }
+            else
+            {
+                // another producer claimed this position, try again with the latest one
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void *>(cell->storage)) value_type(std::forward<Args>(args)...);
+
+        // publish the value to the consumer of this position
+        cell->sequence.store(position + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Add an item to the end of the queue. If the queue is full this spins (yielding) until there is space.
+     *
+     * @param args
+     *   Arguments for object being places in queue, will be perfectly forwarded.
+     */
+    template <class... Args>
+    void enqueue(Args &&...args)
+    {
+        // arguments are only forwarded on the attempt that succeeds
+        while (!try_enqueue(std::forward<Args>(args)...))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Tries to pop the next element off the queue.
+     *
+     * @param element
+     *   Reference to store popped element.
+     *
+     * @returns
+     *   True if an element could be dequeued, false if the queue was empty.
+     */
+    bool try_dequeue(reference element)
+    {
+        auto position = dequeue_position_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+
+        for (;;)
+        {
+            cell = &cells_[position & mask_];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1u);
+
+            if (diff == 0)
+            {
+                // slot has been filled for our position, try and claim it
+                if (dequeue_position_.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // slot has not been filled yet, so we are empty
+                return false;
+            }
+            else
+            {
+                // another consumer claimed this position, try again with the latest one
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        auto *value = std::launder(reinterpret_cast<value_type *>(cell->storage));
+        element = std::move(*value);
+        std::destroy_at(value);
+
+        // mark the slot as free for the producer on the next lap
+        cell->sequence.store(position + mask_ + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Pops the next element off the queue. If the queue is empty this spins (yielding) until there is an element.
+     *
+     * @returns
+     *   Popped element.
+     */
+    value_type dequeue()
+    {
+        value_type value{};
+
+        while (!try_dequeue(value))
+        {
+            std::this_thread::yield();
+        }
+
+        return value;
+    }
+
+  private:
+    /**
+     * A single slot in the ring.
+     */
+    struct Cell
+    {
+        /** Position this slot is ready for, see try_enqueue and try_dequeue. */
+        std::atomic<size_type> sequence;
+
+        /** Storage for value. */
+        alignas(value_type) std::byte storage[sizeof(value_type)];
+    };
+
+    /** Ring of slots. */
+    std::unique_ptr<Cell[]> cells_;
+
+    /** Mask to convert a position to a slot index. */
+    size_type mask_;
+
+    /** Next position to enqueue at, on its own cache line to avoid false sharing with consumers. */
+    alignas(64) std::atomic<size_type> enqueue_position_;
+
+    /**
+     * Next position to dequeue from, on its own cache line to avoid false sharing with producers. The alignment also
+     * pads the queue so nothing that follows it shares this line.
+     */
+    alignas(64) std::atomic<size_type> dequeue_position_;
+};
+
+}
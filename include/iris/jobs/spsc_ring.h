@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * A bounded wait-free single-producer single-consumer FIFO ring buffer. Exactly one thread may push and exactly one
+ * thread may pop at any one time (they can be different threads), no other synchronisation is needed.
+ *
+ * Each side keeps a cached copy of the other side's index, so the shared index (and its cache line) is only read when
+ * the cache says there is not enough room (for the producer) or not enough elements (for the consumer).
+ */
+template <class T>
+class SpscRing
+{
+  public:
+    // member types
+    using size_type = std::size_t;
+    using value_type = T;
+    using reference = T &;
+
+    /**
+     * Construct an empty ring.
+     *
+     * @param capacity
+     *   Maximum number of elements, must be a power of two.
+     */
+    explicit SpscRing(size_type capacity = 1024u)
+        : slots_(std::make_unique<Slot[]>(capacity))
+        , mask_(capacity - 1u)
+        , head_(0u)
+        , cached_tail_(0u)
+        , tail_(0u)
+        , cached_head_(0u)
+    {
+        ensure((capacity >= 2u) && ((capacity & (capacity - 1u)) == 0u), "capacity must be a power of two");
+    }
+
+    ~SpscRing()
+    {
+        // no one else can be using the ring, so destroy anything left in it
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        for (auto position = head_.load(std::memory_order_relaxed); position != tail; ++position)
+        {
+            std::destroy_at(element(position));
+        }
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+    SpscRing(SpscRing &&) = delete;
+    SpscRing &operator=(SpscRing &&) = delete;
+
+    /**
+     * Check if the ring is empty. This is only a snapshot, it may be out of date by the time it returns.
+     *
+     * @returns
+     *   True if ring is empty, else false.
+     */
+    bool empty() const
+    {
+        return size() == 0u;
+    }
+
+    /**
+     * Get the number of elements in the ring. This is only a snapshot, it may be out of date by the time it returns.
+     *
+     * @returns
+     *   Number of elements.
+     */
+    size_type size() const
+    {
+        const auto head = head_.load(std::memory_order_acquire);
+        const auto tail = tail_.load(std::memory_order_acquire);
+
+        return tail - head;
+    }
+
+    /**
+     * Get the maximum number of elements the ring can hold.
+     *
+     * @returns
+     *   Capacity.
+     */
+    size_type capacity() const
+    {
+        return mask_ + 1u;
+    }
+
+    /**
+     * Try and add an item to the end of the ring. Must only be called by the producer.
+     *
+     * @param args
+     *   Arguments for object being placed in ring, will be perfectly forwarded.
+     *
+     * @returns
+     *   True if the item was added, false if the ring was full.
+     */
+    template <class... Args>
+    bool try_push(Args &&...args)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+
+        if (free_slots(tail, 1u) == 0u)
+        {
+            return false;
+        }
+
+        ::new (static_cast<void *>(slots_[tail & mask_].storage)) value_type(std::forward<Args>(args)...);
+        tail_.store(tail + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Move as many items as will fit onto the end of the ring. Must only be called by the producer.
+     *
+     * @param values
+     *   Items to add, the ones that were added are left in a moved-from state.
+     *
+     * @returns
+     *   Number of items added (from the front of values).
+     */
+    size_type push(std::span<value_type> values)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const auto count = std::min(values.size(), free_slots(tail, values.size()));
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            ::new (static_cast<void *>(slots_[(tail + i) & mask_].storage)) value_type(std::move(values[i]));
+        }
+
+        // publish the whole batch in one go
+        tail_.store(tail + count, std::memory_order_release);
+
+        return count;
+    }
+
+    /**
+     * Tries to pop the next element off the ring. Must only be called by the consumer.
+     *
+     * @param element
+     *   Reference to store popped element.
+     *
+     * @returns
+     *   True if an element could be popped, false if the ring was empty.
+     */
+    bool try_pop(reference element)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+
+        if (used_slots(head, 1u) == 0u)
+        {
+            return false;
+        }
+
+        auto *value = this->element(head);
+        element = std::move(*value);
+        std::destroy_at(value);
+
+        head_.store(head + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Pop as many elements as are available, up to the size of the supplied span. Must only be called by the
+     * consumer.
+     *
+     * @param values
+     *   Span to move popped elements into.
+     *
+     * @returns
+     *   Number of elements popped (into the front of values).
+     */
+    size_type pop(std::span<value_type> values)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        const auto count = std::min(values.size(), used_slots(head, values.size()));
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto *value = element(head + i);
+            values[i] = std::move(*value);
+            std::destroy_at(value);
+        }
+
+        // hand all the slots back to the producer in one go
+        head_.store(head + count, std::memory_order_release);
+
+        return count;
+    }
+
+  private:
+    /**
+     * Storage for a single element.
+     */
+    struct Slot
+    {
+        alignas(value_type) std::byte storage[sizeof(value_type)];
+    };
+
+    /**
+     * Get the element at a position.
+     *
+     * @param position
+     *   Position of element.
+     *
+     * @returns
+     *   Pointer to element.
+     */
+    value_type *element(size_type position)
+    {
+        return std::launder(reinterpret_cast<value_type *>(slots_[position & mask_].storage));
+    }
+
+    /**
+     * Get the number of slots the producer can write to, only reloading the consumer's index if the cached copy says
+     * there are fewer than wanted.
+     *
+     * @param tail
+     *   Current tail.
+     *
+     * @param wanted
+     *   Number of slots the producer would like.
+     *
+     * @returns
+     *   Number of free slots.
+     */
+    size_type free_slots(size_type tail, size_type wanted)
+    {
+        if (capacity() - (tail - cached_head_) < wanted)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+
+        return capacity() - (tail - cached_head_);
+    }
+
+    /**
+     * Get the number of slots the consumer can read from, only reloading the producer's index if the cached copy says
+     * there are fewer than wanted.
+     *
+     * @param head
+     *   Current head.
+     *
+     * @param wanted
+     *   Number of slots the consumer would like.
+     *
+     * @returns
+     *   Number of used slots.
+     */
+    size_type used_slots(size_type head, size_type wanted)
+    {
+        if (cached_tail_ - head < wanted)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+
+        return cached_tail_ - head;
+    }
+
+    /** Ring of slots. */
+    std::unique_ptr<Slot[]> slots_;
+
+    /** Mask to convert a position to a slot index. */
+    size_type mask_;
+
+    /** Next position to pop from, only written by the consumer. */
+    alignas(64) std::atomic<size_type> head_;
+
+    /** Consumer's copy of tail_. */
+    size_type cached_tail_;
+
+    /** Next position to push to, only written by the producer. */
+    alignas(64) std::atomic<size_type> tail_;
+
+    /**
+     * Producer's copy of head_, shares a cache line with tail_. As the ring is over-aligned its size is rounded up, so
+     * nothing that follows it shares this line.
+     */
+    size_type cached_head_;
+};
+
+}
@@ -0,0 +1,767 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "core/error_handling.h"
+#include "jobs/inline_job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_system_manager.h"
+
+namespace iris
+{
+
+template <class T>
+class Task;
+
+namespace detail
+{
+
+/**
+ * State shared by the promise types of all Task specialisations.
+ */
+class TaskPromiseBase
+{
+  public:
+    /**
+     * Awaiter for the end of a task, hands control straight to whoever is waiting on it.
+     */
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            auto &promise = handle.promise();
+
+            // if we are part of a group then only the last task to finish resumes the awaiting coroutine
+            if ((promise.remaining_ != nullptr) && (promise.remaining_->fetch_sub(1u, std::memory_order_acq_rel) != 1u))
+            {
+                return std::noop_coroutine();
+            }
+
+            return promise.continuation_ ? promise.continuation_ : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {
+        }
+    };
+
+    TaskPromiseBase()
+        : continuation_(nullptr)
+        , remaining_(nullptr)
+        , exception_(nullptr)
+    {
+    }
+
+    /**
+     * Tasks are lazy, they don't start until they are awaited.
+     *
+     * @returns
+     *   Awaiter which always suspends.
+     */
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    /**
+     * Resume the awaiting coroutine (if any) when the task finishes.
+     *
+     * @returns
+     *   Final awaiter.
+     */
+    FinalAwaiter final_suspend() noexcept
+    {
+        return {};
+    }
+
+    /**
+     * Store an exception escaping the task, it will be rethrown to whoever awaits the result.
+     */
+    void unhandled_exception()
+    {
+        exception_ = std::current_exception();
+    }
+
+    /**
+     * Set the coroutine to resume when the task finishes.
+     *
+     * @param continuation
+     *   Coroutine to resume.
+     *
+     * @param remaining
+     *   If the task is part of a group, the number of tasks in the group which have not yet finished. The awaiting
+     *   coroutine is only resumed by the last one. nullptr if not part of a group.
+     */
+    void set_continuation(std::coroutine_handle<> continuation, std::atomic<std::size_t> *remaining)
+    {
+        continuation_ = continuation;
+        remaining_ = remaining;
+    }
+
+  protected:
+    /**
+     * Rethrow the stored exception, if there is one.
+     */
+    void rethrow_if_exception() const
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+  private:
+    /** Coroutine to resume on completion. */
+    std::coroutine_handle<> continuation_;
+
+    /** Outstanding tasks in group, nullptr if not in a group. */
+    std::atomic<std::size_t> *remaining_;
+
+    /** Exception thrown by task. */
+    std::exception_ptr exception_;
+};
+
+/**
+ * Promise type for a Task producing a value.
+ */
+template <class T>
+class TaskPromise : public TaskPromiseBase
+{
+  public:
+    Task<T> get_return_object();
+
+    template <class U>
+    void return_value(U &&value)
+    {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    /**
+     * Get the result of the task.
+     *
+     * @returns
+     *   Value returned from the task.
+     */
+    T &result()
+    {
+        rethrow_if_exception();
+        return *value_;
+    }
+
+  private:
+    /** Returned value, empty until the task finishes. */
+    std::optional<T> value_;
+};
+
+/**
+ * Promise type for a Task which does not produce a value.
+ */
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+  public:
+    Task<void> get_return_object();
+
+    void return_void()
+    {
+    }
+
+    /**
+     * Check the task finished successfully.
+     */
+    void result()
+    {
+        rethrow_if_exception();
+    }
+};
+
+}
+
+/**
+ * A lazily started coroutine which produces a value of type T (or nothing for void). A Task does not start running
+ * until it is awaited, and then runs on the awaiting thread until it reaches its own co_await. Use schedule_on to move
+ * a task onto a job system worker, switch_to_main_thread to move it onto the main thread and when_all to run several
+ * tasks in parallel.
+ *
+ * A suspended task holds no thread or fiber stack, only its coroutine frame, which is allocated once when the task is
+ * created. None of the awaiters here allocate.
+ *
+ * Task is move only and owns its coroutine frame, so it must outlive any co_await on it.
+ *
+ * Example:
+ *
+ *   Task<Texture *> load_texture(JobSystemManager &jobs, std::string path)
+ *   {
+ *       co_await schedule_on(jobs);
+ *       auto data = load_file(path);
+ *       auto image = decode(data);
+ *       co_await switch_to_main_thread(jobs);
+ *       co_return upload(image);
+ *   }
+ */
+template <class T = void>
+class Task
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+
+    /**
+     * Awaiter for starting a task and waiting on its result.
+     */
+    struct Awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            // start the task on this thread, it will resume us when it's finished
+            handle.promise().set_continuation(awaiting, nullptr);
+            return handle;
+        }
+
+        T await_resume()
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                handle.promise().result();
+            }
+            else
+            {
+                return std::move(handle.promise().result());
+            }
+        }
+
+        /** Task being awaited. */
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    /**
+     * Construct an empty Task.
+     */
+    Task()
+        : handle_(nullptr)
+    {
+    }
+
+    /**
+     * Construct a Task owning a coroutine.
+     *
+     * @param handle
+     *   Handle to coroutine.
+     */
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : handle_(handle)
+    {
+    }
+
+    ~Task()
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    Task(Task &&other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Check if the task has finished.
+     *
+     * @returns
+     *   True if finished, false if not started, running or suspended.
+     */
+    bool is_done() const
+    {
+        return handle_ && handle_.done();
+    }
+
+    /**
+     * Await the task, starting it if necessary. Awaiting an already finished task (e.g. after when_all) returns its
+     * result straight away. For a Task with a value the result is moved out.
+     *
+     * @returns
+     *   Awaiter.
+     */
+    Awaiter operator co_await() const noexcept
+    {
+        expect(static_cast<bool>(handle_), "cannot await empty task");
+        return {handle_};
+    }
+
+    /**
+     * Get the underlying coroutine handle.
+     *
+     * @returns
+     *   Coroutine handle.
+     */
+    std::coroutine_handle<promise_type> handle() const
+    {
+        return handle_;
+    }
+
+  private:
+    /** Owned coroutine. */
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail
+{
+
+template <class T>
+Task<T> TaskPromise<T>::get_return_object()
+{
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object()
+{
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+/**
+ * Resume a coroutine from a job system.
+ *
+ * @param jobs_manager
+ *   Manager to add job to.
+ *
+ * @param handle
+ *   Coroutine to resume.
+ *
+ * @param priority
+ *   Priority lane to resume in.
+ */
+inline void resume_on(JobSystemManager &jobs_manager, std::coroutine_handle<> handle, JobPriority priority)
+{
+    std::array<InlineJob, 1u> job{{[handle]() { handle.resume(); }}};
+    jobs_manager.add(job, priority);
+}
+
+}
+
+/**
+ * Awaiter which moves the awaiting coroutine onto a job system worker.
+ */
+class ScheduleAwaiter
+{
+  public:
+    ScheduleAwaiter(JobSystemManager &jobs_manager, JobPriority priority)
+        : jobs_manager_(jobs_manager)
+        , priority_(priority)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // once added we may be resumed on another thread before this returns, so nothing can touch this after
+        detail::resume_on(jobs_manager_, handle, priority_);
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+  private:
+    /** Manager to schedule on. */
+    JobSystemManager &jobs_manager_;
+
+    /** Priority lane to schedule in. */
+    JobPriority priority_;
+};
+
+/**
+ * Awaiter which moves the awaiting coroutine onto the main thread (see JobSystemManager::run_main_thread_jobs).
+ */
+class MainThreadAwaiter
+{
+  public:
+    explicit MainThreadAwaiter(JobSystemManager &jobs_manager)
+        : jobs_manager_(jobs_manager)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        std::array<InlineJob, 1u> job{{[handle]() { handle.resume(); }}};
+        jobs_manager_.add_main_thread(job);
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+  private:
+    /** Manager to schedule on. */
+    JobSystemManager &jobs_manager_;
+};
+
+/**
+ * Awaiter which runs a group of tasks in parallel on a job system and resumes the awaiting coroutine once they have
+ * all finished.
+ */
+template <class T>
+class WhenAllAwaiter
+{
+  public:
+    WhenAllAwaiter(JobSystemManager &jobs_manager, std::span<Task<T>> tasks, JobPriority priority)
+        : jobs_manager_(jobs_manager)
+        , tasks_(tasks)
+        , priority_(priority)
+        , remaining_(0u)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return tasks_.empty();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        // we hold an extra count whilst scheduling, so no task can resume us whilst we are still in here
+        remaining_.store(tasks_.size() + 1u, std::memory_order_relaxed);
+
+        for (auto &task : tasks_)
+        {
+            expect(static_cast<bool>(task.handle()) && !task.is_done(), "can only run unstarted tasks");
+
+            task.handle().promise().set_continuation(handle, &remaining_);
+            detail::resume_on(jobs_manager_, task.handle(), priority_);
+        }
+
+        // if every task finished whilst we were scheduling then carry straight on
+        return remaining_.fetch_sub(1u, std::memory_order_acq_rel) != 1u;
+    }
+
+    /**
+     * Rethrows the first exception thrown by a task (in task order). Results can be retrieved by awaiting each task.
+     */
+    void await_resume()
+    {
+        for (auto &task : tasks_)
+        {
+            task.handle().promise().result();
+        }
+    }
+
+  private:
+    /** Manager to schedule on. */
+    JobSystemManager &jobs_manager_;
+
+    /** Tasks to run. */
+    std::span<Task<T>> tasks_;
+
+    /** Priority lane to run tasks in. */
+    JobPriority priority_;
+
+    /** Number of tasks (plus one whilst scheduling) still running. */
+    std::atomic<std::size_t> remaining_;
+};
+
+/**
+ * Move the awaiting coroutine onto a job system worker.
+ *
+ *   co_await schedule_on(jobs);
+ *
+ * @param jobs_manager
+ *   Manager to schedule on.
+ *
+ * @param priority
+ *   Priority lane to schedule in.
+ *
+ * @returns
+ *   Awaiter.
+ */
+inline ScheduleAwaiter schedule_on(JobSystemManager &jobs_manager, JobPriority priority = JobPriority::NORMAL)
+{
+    return {jobs_manager, priority};
+}
+
+/**
+ * Move the awaiting coroutine onto the main thread, it will be resumed the next time the main thread calls
+ * JobSystemManager::run_main_thread_jobs.
+ *
+ *   co_await switch_to_main_thread(jobs);
+ *
+ * @param jobs_manager
+ *   Manager to schedule on.
+ *
+ * @returns
+ *   Awaiter.
+ */
+inline MainThreadAwaiter switch_to_main_thread(JobSystemManager &jobs_manager)
+{
+    return MainThreadAwaiter{jobs_manager};
+}
+
+/**
+ * Start a group of tasks in parallel on a job system and wait for them all to finish. Each task must not have been
+ * started. Afterwards each task is finished, so awaiting it returns its result straight away.
+ *
+ *   co_await when_all(jobs, tasks);
+ *   auto first = co_await tasks[0];
+ *
+ * @param jobs_manager
+ *   Manager to run tasks on.
+ *
+ * @param tasks
+ *   Tasks to run, must outlive the co_await.
+ *
+ * @param priority
+ *   Priority lane to run tasks in.
+ *
+ * @returns
+ *   Awaiter.
+ */
+template <class T, std::size_t Extent>
+WhenAllAwaiter<T> when_all(
+    JobSystemManager &jobs_manager,
+    std::span<Task<T>, Extent> tasks,
+    JobPriority priority = JobPriority::NORMAL)
+{
+    return {jobs_manager, tasks, priority};
+}
+
+namespace detail
+{
+
+/**
+ * Coroutine used by sync_wait to run a task and signal a blocked thread when it's done.
+ */
+class SyncWaitTask
+{
+  public:
+    /**
+     * State shared between the waiting thread and the coroutine.
+     */
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+    };
+
+    class promise_type
+    {
+      public:
+        SyncWaitTask get_return_object()
+        {
+            return SyncWaitTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept
+        {
+            struct Awaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+                {
+                    // signal under the lock, as once the waiting thread sees done it will destroy the state
+                    auto *state = handle.promise().state;
+                    std::unique_lock lock(state->mutex);
+                    state->done = true;
+                    state->condition.notify_one();
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            return Awaiter{};
+        }
+
+        void return_void()
+        {
+        }
+
+        void unhandled_exception()
+        {
+            exception = std::current_exception();
+        }
+
+        /** State to signal on completion. */
+        State *state = nullptr;
+
+        /** Exception thrown by awaited task. */
+        std::exception_ptr exception;
+    };
+
+    explicit SyncWaitTask(std::coroutine_handle<promise_type> handle)
+        : handle_(handle)
+    {
+    }
+
+    ~SyncWaitTask()
+    {
+        handle_.destroy();
+    }
+
+    SyncWaitTask(const SyncWaitTask &) = delete;
+    SyncWaitTask &operator=(const SyncWaitTask &) = delete;
+
+    /**
+     * Run the coroutine and block until it finishes, running main thread jobs whilst waiting.
+     *
+     * @param jobs_manager
+     *   Manager to run main thread jobs from.
+     */
+    void run(JobSystemManager &jobs_manager)
+    {
+        State state{};
+        handle_.promise().state = &state;
+
+        // start on this thread, if the task never leaves it then it will have finished when this returns
+        handle_.resume();
+
+        std::unique_lock lock(state.mutex);
+
+        while (!state.done)
+        {
+            // the task may be waiting to resume on the main thread, so keep running those jobs
+            lock.unlock();
+            const auto ran = jobs_manager.run_main_thread_jobs();
+            lock.lock();
+
+            if (ran == 0u)
+            {
+                // main thread jobs don't signal us, so only sleep for a short time before checking again
+                state.condition.wait_for(lock, std::chrono::milliseconds(1), [&state]() { return state.done; });
+            }
+        }
+
+        if (handle_.promise().exception)
+        {
+            std::rethrow_exception(handle_.promise().exception);
+        }
+    }
+
+  private:
+    /** Owned coroutine. */
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Await a task, storing its result.
+ *
+ * @param task
+ *   Task to await.
+ *
+ * @param result
+ *   Where to store result (unused for void tasks).
+ *
+ * @returns
+ *   Coroutine.
+ */
+template <class T, class Result>
+SyncWaitTask make_sync_wait_task(Task<T> &task, Result &result)
+{
+    if constexpr (std::is_void_v<T>)
+    {
+        co_await task;
+    }
+    else
+    {
+        result.emplace(co_await task);
+    }
+}
+
+}
+
+/**
+ * Run a task and block the calling thread until it finishes. This is the bridge from normal code into tasks. Whilst
+ * waiting this runs main thread jobs, so tasks can switch_to_main_thread, hence it should only be called from the main
+ * thread and not from within a job.
+ *
+ * @param jobs_manager
+ *   Manager the task uses.
+ *
+ * @param task
+ *   Task to run, must not have been started.
+ *
+ * @returns
+ *   Result of task, any exception it threw is rethrown.
+ */
+template <class T>
+T sync_wait(JobSystemManager &jobs_manager, Task<T> task)
+{
+    if constexpr (std::is_void_v<T>)
+    {
+        auto unused = std::optional<int>{};
+        detail::make_sync_wait_task(task, unused).run(jobs_manager);
+    }
+    else
+    {
+        auto result = std::optional<T>{};
+        detail::make_sync_wait_task(task, result).run(jobs_manager);
+
+        return std::move(*result);
+    }
+}
+
+}
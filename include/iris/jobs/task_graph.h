@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+#include "jobs/job_system_manager.h"
+
+namespace iris
+{
+
+/**
+ * A graph of jobs with explicit dependencies between them. The graph is built once and can then be run as many times
+ * as required (e.g. once per frame), after the first run no further allocations are made by the graph itself.
+ *
+ * A node is only scheduled once all of the nodes it depends on have finished, so no job (or fiber) ever blocks waiting
+ * on a dependency. When a node finishes the worker carries straight on with one of the nodes it made ready, any others
+ * are scheduled as continuations of the running job.
+ *
+ * If a node throws then nodes which depend on it are not run, the first exception is rethrown from run() once all
+ * other nodes have finished.
+ *
+ * The graph must not be modified or run again whilst it is running.
+ */
+class TaskGraph
+{
+  public:
+    /** Type used to identify a node. */
+    using NodeId = std::size_t;
+
+    /**
+     * Construct an empty graph.
+     */
+    TaskGraph();
+
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+    TaskGraph(TaskGraph &&) = delete;
+    TaskGraph &operator=(TaskGraph &&) = delete;
+
+    /**
+     * Add a node to the graph.
+     *
+     * @param job
+     *   Job to run for node, this is called every time the graph is run.
+     *
+     * @returns
+     *   Id of new node.
+     */
+    NodeId add_node(Job job);
+
+    /**
+     * Add a dependency between two nodes, after will not be run until before has finished.
+     *
+     * @param before
+     *   Node which must run first.
+     *
+     * @param after
+     *   Node which depends on before.
+     */
+    void add_edge(NodeId before, NodeId after);
+
+    /**
+     * Add a node which runs once another node has finished. This is shorthand for add_node followed by add_edge.
+     *
+     * @param node
+     *   Node to continue from.
+     *
+     * @param job
+     *   Job to run for new node.
+     *
+     * @returns
+     *   Id of new node.
+     */
+    NodeId add_continuation(NodeId node, Job job);
+
+    /**
+     * Get the number of nodes in the graph.
+     *
+     * @returns
+     *   Number of nodes.
+     */
+    std::size_t size() const;
+
+    /**
+     * Run all nodes in the graph, respecting dependencies. This call blocks until every node has finished.
+     *
+     * @param jobs_manager
+     *   Job system to run nodes on.
+     */
+    void run(JobSystemManager &jobs_manager);
+
+  private:
+    /**
+     * A single node in the graph.
+     */
+    struct Node
+    {
+        /** Job to run. */
+        Job job;
+
+        /** Nodes which depend on this one. */
+        std::vector<NodeId> successors;
+
+        /** Number of nodes this one depends on. */
+        std::size_t dependency_count;
+    };
+
+    /**
+     * Validate the graph and allocate per-run state, only called when the graph has been modified.
+     */
+    void prepare();
+
+    /**
+     * Run a node and then any nodes it made ready.
+     *
+     * @param node
+     *   Node to run.
+     */
+    void execute(NodeId node);
+
+    /** All nodes, indexed by NodeId. */
+    std::vector<Node> nodes_;
+
+    /** Nodes with no dependencies. */
+    std::vector<NodeId> roots_;
+
+    /** Jobs used to start roots, kept as a member so they are not reallocated each run. */
+    std::vector<InlineJob> root_jobs_;
+
+    /** Number of unfinished dependencies for each node in the current run. */
+    std::unique_ptr<std::atomic<std::size_t>[]> pending_;
+
+    /** Job system of current run. */
+    JobSystemManager *jobs_manager_;
+
+    /** Flag indicating graph has been modified since it was last prepared. */
+    bool dirty_;
+};
+
+}
@@ -6,24 +6,72 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <vector>
 
+#include "core/thread.h"
+#include "jobs/chunk_function.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
 #include "jobs/job_system.h"
+#include "jobs/job_system_config.h"
+#include "jobs/main_thread_queue.h"
 
 namespace iris
 {
 
 /**
- * Implementation of JobSystem that schedules its jobs using threads.
+ * Implementation of JobSystem that schedules its jobs on a fixed pool of threads.
+ *
+ * All jobs go via a single shared queue per JobPriority lane, workers always take from the highest priority non-empty
+ * lane. A thread waiting on jobs will run its own queued jobs until they have finished, so waiting from inside a job
+ * cannot starve the pool.
+ *
+ * Note that the pool is fixed size, a job occupies its worker until it returns. A long-lived job (e.g. a blocking
+ * network read loop) therefore permanently takes one worker out of the pool and with the default layout (one worker
+ * per core, minus one for the main thread) a small machine can be left with none for other fire-and-forget jobs.
+ * Waiting on jobs still makes progress as the waiting thread runs them itself. If an application queues several
+ * long-lived jobs it should size the pool for them with JobSystemConfig.
  */
 class ThreadJobSystem : public JobSystem
 {
   public:
+    /**
+     * Construct a new ThreadJobSystem with one worker per core (minus one for the main thread).
+     */
     ThreadJobSystem();
-    ~ThreadJobSystem() override = default;
+
+    /**
+     * Construct a new ThreadJobSystem with a fixed number of workers.
+     *
+     * @param worker_count
+     *   Number of worker threads to create, must be greater than zero.
+     */
+    explicit ThreadJobSystem(std::uint32_t worker_count);
+
+    /**
+     * Construct a new ThreadJobSystem with a configured worker layout.
+     *
+     * @param config
+     *   Config for worker threads.
+     */
+    explicit ThreadJobSystem(const JobSystemConfig &config);
+
+    /**
+     * Stops all workers, any jobs not yet started are dropped.
+     */
+    ~ThreadJobSystem() override;
 
     /**
      * Add a collection of jobs. Once added these are executed in a
@@ -35,6 +83,19 @@ class ThreadJobSystem : public JobSystem
      */
     void add_jobs(const std::vector<Job> &jobs) override;
 
+    /**
+     * Add a collection of jobs. Once added these are executed in a
+     * fire-and-forget manner, there is no way to wait on them to finish or
+     * to know when they have executed.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_jobs(std::span<InlineJob> jobs) override;
+
     /**
      * Add a collection of jobs. Once added this call blocks until all
      * jobs have finished executing.
@@ -44,9 +105,262 @@ class ThreadJobSystem : public JobSystem
      */
     void wait_for_jobs(const std::vector<Job> &jobs) override;
 
+    /**
+     * Add a collection of jobs. Once added this call blocks until all
+     * jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void wait_for_jobs(std::span<InlineJob> jobs) override;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added these are
+     * executed in a fire-and-forget manner.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    void add_jobs(std::span<InlineJob> jobs, JobPriority priority) override;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added this call
+     * blocks until all jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    void wait_for_jobs(std::span<InlineJob> jobs, JobPriority priority) override;
+
+    /**
+     * Add a collection of jobs as continuations of the currently running job.
+     * Anything waiting on the current job will also wait for these to finish
+     * (and see any exceptions they throw). If not called from within a job
+     * that is being waited on then these are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span, they run with the same
+     * priority as the current job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_continuation_jobs(std::span<InlineJob> jobs) override;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_main_thread_jobs(const std::vector<Job> &jobs) override;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_main_thread_jobs(std::span<InlineJob> jobs) override;
+
+    /**
+     * Run all jobs queued for the main thread. The main loop should call this
+     * once per frame.
+     *
+     * This must only be called from the main thread.
+     *
+     * @returns
+     *   Number of jobs run.
+     */
+    std::size_t run_main_thread_jobs() override;
+
+    /**
+     * Get the number of jobs queued in each lane.
+     *
+     * @returns
+     *   Queue depths.
+     */
+    JobQueueDepths queue_depths() const override;
+
+    /**
+     * Set what idle workers do before they go to sleep, this can be changed at
+     * any time and is picked up the next time a worker runs out of work.
+     *
+     * @param policy
+     *   New idle policy.
+     */
+    void set_idle_policy(const IdlePolicy &policy) override;
+
+    /**
+     * Get the current idle policy.
+     *
+     * @returns
+     *   Idle policy.
+     */
+    IdlePolicy idle_policy() const override;
+
+    /**
+     * Run a function for every chunk index in [0, chunk_count), spread across
+     * the workers. This call blocks until all chunks have been processed.
+     *
+     * @param chunk_count
+     *   Number of chunks.
+     *
+     * @param function
+     *   Function to call for each chunk index.
+     */
+    void run_chunks(std::size_t chunk_count, ChunkFunction function) override;
+
+    /**
+     * Get the number of threads jobs are executed on.
+     *
+     * @returns
+     *   Number of worker threads.
+     */
+    std::uint32_t worker_count() const override;
+
+    /**
+     * Get the name and cores of each worker.
+     *
+     * @returns
+     *   Layout of each worker, indexed by worker.
+     */
+    std::vector<WorkerLayout> worker_layout() const override;
+
   private:
+    /** Tracks a collection of jobs being waited on, defined in implementation. */
+    struct WaitGroup;
+
+    /**
+     * A queued job.
+     */
+    struct Task
+    {
+        /** Job to run. */
+        InlineJob job;
+
+        /** Group to notify when job is done, nullptr for fire-and-forget jobs. */
+        WaitGroup *group;
+
+        /** Lane task was queued in. */
+        JobPriority priority;
+    };
+
+    /**
+     * Queue a collection of jobs and wake workers.
+     *
+     * @param jobs
+     *   Jobs to queue, either Job or InlineJob elements.
+     *
+     * @param group
+     *   Group to notify as each job finishes, may be nullptr.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    template <class Jobs>
+    void enqueue(Jobs &jobs, WaitGroup *group, JobPriority priority);
+
+    /**
+     * Queue a collection of jobs and block until they have all finished, running queued jobs whilst waiting.
+     *
+     * @param jobs
+     *   Jobs to execute, either Job or InlineJob elements.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    template <class Jobs>
+    void wait_for_jobs_impl(Jobs &jobs, JobPriority priority);
+
+    /**
+     * Pop the oldest task belonging to a group off the highest priority lane that has one, if there is one.
+     *
+     * @param task
+     *   Reference to store popped task.
+     *
+     * @param group
+     *   Group task must belong to.
+     *
+     * @returns
+     *   True if a task was popped, false if no task for group is queued.
+     */
+    bool try_pop(Task &task, const WaitGroup *group);
+
+    /**
+     * Pop the next task off the highest priority non-empty lane, if there is one. mutex_ must be held by caller.
+     *
+     * @param task
+     *   Reference to store popped task.
+     *
+     * @returns
+     *   True if a task was popped, false if all lanes were empty.
+     */
+    bool pop_locked(Task &task);
+
+    /**
+     * Get the task currently being run by the calling thread.
+     *
+     * @returns
+     *   Reference to current task, nullptr if calling thread is not running a task.
+     */
+    static const Task *&current_task();
+
+    /**
+     * Run a task and notify its group.
+     *
+     * @param task
+     *   Task to run.
+     */
+    static void run(Task &task);
+
+    /**
+     * Main function for worker threads.
+     */
+    void worker_thread();
+
     /** Flag indicating of system is running. */
     std::atomic<bool> running_;
+
+    /** Queued tasks, one queue per priority lane. */
+    std::array<std::deque<Task>, job_priority_count> tasks_;
+
+    /** Number of tasks queued across all lanes, only modified whilst holding mutex_ but can be read without. */
+    std::atomic<std::size_t> task_count_;
+
+    /** What idle workers do before waiting on condition_. */
+    std::atomic<IdlePolicy> idle_policy_;
+
+    /** Lock for tasks_ and task_count_. */
+    mutable std::mutex mutex_;
+
+    /** Signals workers that tasks have been queued (or we are stopping). */
+    std::condition_variable condition_;
+
+    /** Name and cores of each worker. */
+    std::vector<WorkerLayout> worker_layout_;
+
+    /** Worker threads. */
+    std::vector<Thread> workers_;
+
+    /** Jobs to be run on the main thread. */
+    MainThreadQueue main_thread_jobs_;
 };
 
 }
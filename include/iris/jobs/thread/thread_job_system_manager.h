@@ -6,10 +6,19 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
+#include "jobs/chunk_function.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
+#include "jobs/job_system_config.h"
 #include "jobs/job_system_manager.h"
 #include "jobs/thread/thread_job_system.h"
 
@@ -32,6 +41,17 @@ class ThreadJobSystemManager : public JobSystemManager
      */
     JobSystem *create_job_system() override;
 
+    /**
+     * Create a JobSystem with a given worker layout.
+     *
+     * @param config
+     *   Config for worker threads.
+     *
+     * @returns
+     *   Pointer to JobSystem.
+     */
+    JobSystem *create_job_system(const JobSystemConfig &config) override;
+
     /**
      * Add a collection of jobs. Once added these are executed in a
      * fire-and-forget manner, there is no way to wait on them to finish or
@@ -42,6 +62,19 @@ class ThreadJobSystemManager : public JobSystemManager
      */
     void add(const std::vector<Job> &jobs) override;
 
+    /**
+     * Add a collection of jobs. Once added these are executed in a
+     * fire-and-forget manner, there is no way to wait on them to finish or
+     * to know when they have executed.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add(std::span<InlineJob> jobs) override;
+
     /**
      * Add a collection of jobs. Once added this call blocks until all
      * jobs have finished executing.
@@ -51,6 +84,144 @@ class ThreadJobSystemManager : public JobSystemManager
      */
     void wait(const std::vector<Job> &jobs) override;
 
+    /**
+     * Add a collection of jobs. Once added this call blocks until all
+     * jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span, this overload does not allocate
+     * per job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void wait(std::span<InlineJob> jobs) override;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added these are
+     * executed in a fire-and-forget manner.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    void add(std::span<InlineJob> jobs, JobPriority priority) override;
+
+    /**
+     * Add a collection of jobs to a priority lane. Once added this call
+     * blocks until all jobs have finished executing.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Lane to queue jobs in.
+     */
+    void wait(std::span<InlineJob> jobs, JobPriority priority) override;
+
+    /**
+     * Add a collection of jobs as continuations of the currently running job.
+     * Anything waiting on the current job will also wait for these to finish
+     * (and see any exceptions they throw). If not called from within a job
+     * that is being waited on then these are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span, they run with the same
+     * priority as the current job.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_continuation(std::span<InlineJob> jobs) override;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_main_thread(const std::vector<Job> &jobs) override;
+
+    /**
+     * Add a collection of jobs to be run on the main thread, the next time
+     * run_main_thread_jobs is called. Jobs are fire-and-forget.
+     *
+     * Jobs are moved out of the supplied span.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     */
+    void add_main_thread(std::span<InlineJob> jobs) override;
+
+    /**
+     * Run all jobs queued for the main thread. The main loop should call this
+     * once per frame.
+     *
+     * This must only be called from the main thread.
+     *
+     * @returns
+     *   Number of jobs run.
+     */
+    std::size_t run_main_thread_jobs() override;
+
+    /**
+     * Get the number of jobs queued in each lane.
+     *
+     * @returns
+     *   Queue depths.
+     */
+    JobQueueDepths queue_depths() const override;
+
+    /**
+     * Set what idle workers do before they go to sleep, this can be changed at
+     * any time and is picked up the next time a worker runs out of work.
+     *
+     * @param policy
+     *   New idle policy.
+     */
+    void set_idle_policy(const IdlePolicy &policy) override;
+
+    /**
+     * Get the current idle policy.
+     *
+     * @returns
+     *   Idle policy.
+     */
+    IdlePolicy idle_policy() const override;
+
+    /**
+     * Run a function for every chunk index in [0, chunk_count), spread across
+     * the workers. This call blocks until all chunks have been processed.
+     *
+     * @param chunk_count
+     *   Number of chunks.
+     *
+     * @param function
+     *   Function to call for each chunk index.
+     */
+    void run_chunks(std::size_t chunk_count, ChunkFunction function) override;
+
+    /**
+     * Get the number of threads jobs are executed on.
+     *
+     * @returns
+     *   Number of worker threads.
+     */
+    std::uint32_t worker_count() const override;
+
+    /**
+     * Get the name and cores of each worker.
+     *
+     * @returns
+     *   Layout of each worker, indexed by worker.
+     */
+    std::vector<WorkerLayout> worker_layout() const override;
+
   private:
     /** Current JobSystem. */
     std::unique_ptr<ThreadJobSystem> job_system_;
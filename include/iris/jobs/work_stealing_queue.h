@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * A lock-free Chase-Lev work-stealing deque.
+ *
+ * A single thread (the owner) pushes and pops items from the bottom of the queue (LIFO), any other thread may steal
+ * items from the top (FIFO). This means the owner gets good cache locality whilst thieves take the oldest (and
+ * usually largest) pieces of work.
+ *
+ * The queue grows when full, old buffers are kept alive until the queue is destroyed as a thief may still be reading
+ * from them.
+ *
+ * See: "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Zappa Nardelli - 2013)
+ */
+template <class T>
+class WorkStealingQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "work stealing queue element must be trivially copyable");
+
+  public:
+    // member types
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * Construct an empty queue.
+     *
+     * @param capacity
+     *   Initial capacity of queue, must be a power of two.
+     */
+    explicit WorkStealingQueue(size_type capacity = 1024u)
+        : top_(0)
+        , bottom_(0)
+        , buffer_(nullptr)
+        , buffers_()
+    {
+        expect((capacity != 0u) && ((capacity & (capacity - 1u)) == 0u), "capacity must be a power of two");
+
+        buffers_.emplace_back(std::make_unique<Buffer>(static_cast<std::int64_t>(capacity)));
+        buffer_ = buffers_.back().get();
+    }
+
+    // disable copy and move
+    WorkStealingQueue(const WorkStealingQueue &) = delete;
+    WorkStealingQueue &operator=(const WorkStealingQueue &) = delete;
+    WorkStealingQueue(WorkStealingQueue &&) = delete;
+    WorkStealingQueue &operator=(WorkStealingQueue &&) = delete;
+
+    /**
+     * Check if the queue is empty. As other threads may be stealing this is only a snapshot.
+     *
+     * @returns
+     *   True if queue is empty, else false.
+     */
+    bool empty() const
+    {
+        return size() == 0u;
+    }
+
+    /**
+     * Get the number of elements in the queue. As other threads may be stealing this is only a snapshot.
+     *
+     * @returns
+     *   Number of elements in queue.
+     */
+    size_type size() const
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_relaxed);
+
+        return static_cast<size_type>(bottom >= top ? bottom - top : 0);
+    }
+
+    /**
+     * Push an item onto the bottom of the queue. Must only be called by the owning thread.
+     *
+     * @param element
+     *   Element to push.
+     */
+    void push(T element)
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_acquire);
+        auto *buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (bottom - top > buffer->capacity - 1)
+        {
+            buffer = grow(buffer, bottom, top);
+        }
+
+        buffer->store(bottom, element);
+
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Pop an item from the bottom of the queue. Must only be called by the owning thread.
+     *
+     * @param element
+     *   Reference to store popped element.
+     *
+     * @returns
+     *   True if an element could be popped, false otherwise.
+     */
+    bool pop(T &element)
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        auto *buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto top = top_.load(std::memory_order_relaxed);
+        auto popped = false;
+
+        if (top <= bottom)
+        {
+            element = buffer->load(bottom);
+            popped = true;
+
+            if (top == bottom)
+            {
+                // last element in the queue, so race any thieves for it
+                popped = top_.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            // queue was empty, restore bottom
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return popped;
+    }
+
+    /**
+     * Steal an item from the top of the queue. Can be called by any thread.
+     *
+     * @param element
+     *   Reference to store stolen element.
+     *
+     * @returns
+     *   True if an element could be stolen, false if the queue was empty or another thread won the race.
+     */
+    bool steal(T &element)
+    {
+        auto top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = bottom_.load(std::memory_order_acquire);
+
+        auto stolen = false;
+
+        if (top < bottom)
+        {
+            auto *buffer = buffer_.load(std::memory_order_acquire);
+            const auto value = buffer->load(top);
+
+            if (top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                element = value;
+                stolen = true;
+            }
+        }
+
+        return stolen;
+    }
+
+  private:
+    /**
+     * Circular array of elements.
+     */
+    struct Buffer
+    {
+        explicit Buffer(std::int64_t capacity)
+            : capacity(capacity)
+            , mask(capacity - 1)
+            , data(std::make_unique<std::atomic<T>[]>(static_cast<std::size_t>(capacity)))
+        {
+        }
+
+        T load(std::int64_t index) const
+        {
+            return data[static_cast<std::size_t>(index & mask)].load(std::memory_order_relaxed);
+        }
+
+        void store(std::int64_t index, T element)
+        {
+            data[static_cast<std::size_t>(index & mask)].store(element, std::memory_order_relaxed);
+        }
+
+        std::int64_t capacity;
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> data;
+    };
+
+    /**
+     * Replace the current buffer with one twice the size, copying over all live elements.
+     *
+     * @param buffer
+     *   Current buffer.
+     *
+     * @param bottom
+     *   Current bottom index.
+     *
+     * @param top
+     *   Current top index.
+     *
+     * @returns
+     *   New buffer.
+     */
+    Buffer *grow(Buffer *buffer, std::int64_t bottom, std::int64_t top)
+    {
+        buffers_.emplace_back(std::make_unique<Buffer>(buffer->capacity * 2));
+        auto *new_buffer = buffers_.back().get();
+
+        for (auto i = top; i != bottom; ++i)
+        {
+            new_buffer->store(i, buffer->load(i));
+        }
+
+        buffer_.store(new_buffer, std::memory_order_release);
+
+        return new_buffer;
+    }
+
+    /** Index thieves steal from, on its own cache line to reduce false sharing. */
+    alignas(64) std::atomic<std::int64_t> top_;
+
+    /** Index owner pushes and pops from. */
+    alignas(64) std::atomic<std::int64_t> bottom_;
+
+    /** Current buffer. */
+    std::atomic<Buffer *> buffer_;
+
+    /** All buffers ever allocated, retired ones are kept alive for any in-flight thieves. */
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+}
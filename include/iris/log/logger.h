@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <iterator>
 #include <memory>
@@ -13,8 +15,11 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
+#include "jobs/spsc_ring.h"
 #include "log/colour_formatter.h"
 #include "log/log_level.h"
 #include "log/stdout_outputter.h"
@@ -138,6 +143,13 @@ void unpack(const std::string &message, std::size_t &pos, std::stringstream &str
  * respectively (feel free to decide what constitutes as a warning and error).
  * Debug should be used for the log messages you use to diagnose a bug and will
  * probably later delete.
+ *
+ * Messages are formatted on the calling thread and then handed to a background
+ * writer thread through a per-thread SpscRing, so logging never takes a lock
+ * unless that thread's ring is full. Messages from a single thread are always
+ * output in order, messages from different threads may be interleaved
+ * differently to the order they were logged in. ERR messages are flushed
+ * immediately.
  */
 class Logger
 {
@@ -154,6 +166,11 @@ class Logger
         return logger;
     }
 
+    /**
+     * Flushes any outstanding messages and stops the writer thread.
+     */
+    ~Logger();
+
     Logger(const Logger &) = delete;
     Logger &operator=(const Logger &) = delete;
     Logger(Logger &&) = delete;
@@ -240,9 +257,16 @@ class Logger
     template <class T, class... Args, typename = std::enable_if_t<std::is_base_of<Outputter, T>::value>>
     void set_Outputter(Args &&...args)
     {
+        std::unique_lock lock(mutex_);
         outputter_ = std::make_unique<T>(std::forward<Args>(args)...);
     }
 
+    /**
+     * Block until every message logged (by any thread) before this call has
+     * been output.
+     */
+    void flush();
+
     /**
      * Log a message. This function handles the case where no arguments
      * are supplied i.e. just a log message.
@@ -272,20 +296,7 @@ class Logger
         const std::string &filename,
         const int line,
         const bool engine,
-        const std::string &message)
-    {
-        // check if we want to process this log message
-        if ((!engine || log_engine_) && (level >= min_level_) && (ignore_.find(tag) == std::cend(ignore_)))
-        {
-            std::stringstream strm{};
-            strm << message;
-
-            const auto log = formatter_->format(level, tag, strm.str(), filename, line);
-
-            std::unique_lock lock(mutex_);
-            outputter_->output(log);
-        }
-    }
+        const std::string &message);
 
     /**
      * Log a message. This function handles the case where there are
@@ -334,15 +345,47 @@ class Logger
 
   private:
     /**
-     * Construct a new logger.
+     * Construct a new logger and start the writer thread.
      */
-    Logger()
-        : formatter_(std::make_unique<ColourFormatter>())
-        , outputter_(std::make_unique<StdoutFormatter>())
-        , ignore_()
-        , min_level_(LogLevel::DEBUG)
-        , log_engine_(false)
-        , mutex_(){};
+    Logger();
+
+    /**
+     * Get the ring for the calling thread, creating it on first use.
+     *
+     * @returns
+     *   Ring for calling thread.
+     */
+    SpscRing<std::string> &producer_ring();
+
+    /**
+     * Get a ring for a new producer thread, reusing a released one if
+     * possible.
+     *
+     * @returns
+     *   Ring for calling thread.
+     */
+    SpscRing<std::string> *acquire_ring();
+
+    /**
+     * Hand back the ring of an exiting thread so another thread can reuse it,
+     * any messages still in it are output as normal.
+     *
+     * @param ring
+     *   Ring to release.
+     */
+    void release_ring(SpscRing<std::string> *ring);
+
+    /**
+     * Writer thread, outputs messages until the Logger is destroyed.
+     */
+    void write_loop();
+
+    /**
+     * Output everything currently in all rings. Must be called with mutex_
+     * held, which makes whoever is draining the single consumer of every
+     * ring.
+     */
+    void drain();
 
     /** Formatter object. */
     std::unique_ptr<Formatter> formatter_;
@@ -359,8 +402,36 @@ class Logger
     /** Whether to log internal engine messages. */
     bool log_engine_;
 
-    /** Lock for logging. */
+    /** Lock for outputter_ and consuming from rings_. */
     std::mutex mutex_;
+
+    /** Lock for adding to rings_ and free_rings_. */
+    std::mutex rings_mutex_;
+
+    /**
+     * Every ring created, one for each thread logging at the same time. When a
+     * thread exits its ring is released to free_rings_ for the next new thread,
+     * so this only grows with the number of concurrent logging threads.
+     */
+    std::vector<std::unique_ptr<SpscRing<std::string>>> rings_;
+
+    /** Rings in rings_ not owned by any thread. */
+    std::vector<SpscRing<std::string> *> free_rings_;
+
+    /** Scratch space for draining a ring. */
+    std::vector<std::string> drain_batch_;
+
+    /** Set by producers to wake the writer thread. */
+    std::atomic<bool> pending_;
+
+    /** Flag to stop the writer thread. */
+    std::atomic<bool> running_;
+
+    /** Condition variable the writer thread sleeps on. */
+    std::condition_variable wake_;
+
+    /** Writer thread. */
+    std::thread writer_;
 };
 
 }
@@ -68,7 +68,19 @@ class Channel
      * @returns
      *   Packets to be send.
      */
-    virtual std::vector<Packet> yield_send_queue();
+    std::vector<Packet> yield_send_queue();
+
+    /**
+     * Yield all packets to be sent, according to the channel guarantees.
+     *
+     * The supplied collection is replaced, but its storage may be kept by the
+     * channel. Calling this in a loop with the same collection means neither
+     * side has to allocate once warmed up.
+     *
+     * @param queue
+     *   Collection to write packets to be sent to.
+     */
+    virtual void yield_send_queue(std::vector<Packet> &queue);
 
     /**
      * Yield all packets that have been received, according to the channel
@@ -77,7 +89,20 @@ class Channel
      * @returns
      *   Packets received.
      */
-    virtual std::vector<Packet> yield_receive_queue();
+    std::vector<Packet> yield_receive_queue();
+
+    /**
+     * Yield all packets that have been received, according to the channel
+     * guarantees.
+     *
+     * The supplied collection is replaced, but its storage may be kept by the
+     * channel. Calling this in a loop with the same collection means neither
+     * side has to allocate once warmed up.
+     *
+     * @param queue
+     *   Collection to write received packets to.
+     */
+    virtual void yield_receive_queue(std::vector<Packet> &queue);
 
   protected:
     /** Queue for send packets. */
@@ -57,22 +57,26 @@ class ReliableOrderedChannel : public Channel
      */
     void enqueue_receive(Packet packet) override;
 
+    // bring the returning overloads into scope
+    using Channel::yield_receive_queue;
+    using Channel::yield_send_queue;
+
     /**
      * Yield all packets to be sent, according to the channel guarantees.
      *
-     * @returns
-     *   Packets to be send.
+     * @param queue
+     *   Collection to write packets to be sent to, its storage is reused.
      */
-    std::vector<Packet> yield_send_queue() override;
+    void yield_send_queue(std::vector<Packet> &queue) override;
 
     /**
      * Yield all packets that have been received, according to the channel
      * guarantees.
      *
-     * @returns
-     *   Packets received.
+     * @param queue
+     *   Collection to write received packets to, its storage is reused.
      */
-    std::vector<Packet> yield_receive_queue() override;
+    void yield_receive_queue(std::vector<Packet> &queue) override;
 
   private:
     /** The expected sequence number of the next packet. */
@@ -12,11 +12,14 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "core/context.h"
 #include "core/data_buffer.h"
+#include "jobs/spsc_ring.h"
 #include "networking/channel/channel.h"
 #include "networking/channel/channel_type.h"
+#include "networking/packet.h"
 #include "networking/server_socket.h"
 
 namespace iris
@@ -31,7 +34,8 @@ namespace iris
  *  - sending/receiving data
  *
  * This is all done with the lightweight Packet protocol and Channels. This
- * class can also be provided with callbacks for key events.
+ * class can also be provided with callbacks for key events, these are fired
+ * from update() on the calling thread.
  *
  * Protocol:
  *
@@ -120,7 +124,11 @@ class ServerConnectionHandler
 
     /**
      * Updates the connection handler, processes all messages and fires all
-     * callbacks. This should be called regularly (e.g. from a game loop)
+     * callbacks. This must be called every frame (e.g. from a game loop).
+     *
+     * Events received in the background wait in a fixed size queue for this
+     * call, if it is not called often enough for the queue to fill then
+     * further events (including new connections) are dropped and logged.
      */
     void update();
 
@@ -142,6 +150,34 @@ class ServerConnectionHandler
     // forward declare internal struct
     struct Connection;
 
+    /**
+     * Something received by the background job which needs to be passed on to
+     * a callback.
+     */
+    struct Event
+    {
+        /** Id of connection. */
+        std::size_t id;
+
+        /** True if this is a new connection, false if it is data. */
+        bool new_connection;
+
+        /** Received data. */
+        DataBuffer data;
+
+        /** Channel data was received on. */
+        ChannelType channel;
+    };
+
+    /**
+     * Hand an event from the background job to update(). If the queue is full
+     * the event is dropped, so the background job never blocks.
+     *
+     * @param event
+     *   Event to pass on.
+     */
+    void push_event(Event event);
+
     /** Underlying socket. */
     std::unique_ptr<ServerSocket> socket_;
 
@@ -157,11 +193,17 @@ class ServerConnectionHandler
     /** Map of connections to their unique id. */
     std::map<std::size_t, std::unique_ptr<Connection>> connections_;
 
-    /** Mutex to control access to messages. */
+    /** Mutex to control access to channels. */
     std::mutex mutex_;
 
-    /** Collection of messages. */
-    std::vector<DataBuffer> messages_;
+    /** Events from the background job, waiting to be fired by update(). */
+    SpscRing<Event> events_;
+
+    /** Scratch space for popping events in update(). */
+    std::vector<Event> event_batch_;
+
+    /** Scratch space for yielding packets in send(), guarded by mutex_. */
+    std::vector<Packet> send_batch_;
 };
 
 }
@@ -9,9 +9,10 @@
 #include <chrono>
 #include <cstddef>
 #include <optional>
+#include <tuple>
 
 #include "core/context.h"
-#include "jobs/concurrent_queue.h"
+#include "jobs/mpmc_queue.h"
 #include "networking/socket.h"
 
 namespace iris
@@ -21,6 +22,9 @@ namespace iris
  * An adaptor for Socket which can simulate different network conditions. Note
  * that these conditions are compounded with any properties of the underlying
  * Socket.
+ *
+ * Writes are handed off to a background job without locking, so a single SimulatedSocket must only be written to from
+ * one thread at a time.
  */
 class SimulatedSocket : public Socket
 {
@@ -115,8 +119,8 @@ class SimulatedSocket : public Socket
     /** Underlying socket. */
     Socket *socket_;
 
-    /** Queue of data to send and when. */
-    ConcurrentQueue<std::tuple<DataBuffer, std::chrono::steady_clock::time_point>> write_queue_;
+    /** Queue of data to send and when, written to by both the receive job and the game thread. */
+    MpmcQueue<std::tuple<DataBuffer, std::chrono::steady_clock::time_point>> write_queue_;
 };
 
 }
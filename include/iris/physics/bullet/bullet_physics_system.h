@@ -10,6 +10,7 @@
 #include <memory>
 #include <optional>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
@@ -19,6 +20,7 @@
 #include <btBulletDynamicsCommon.h>
 
 #include "core/quaternion.h"
+#include "core/slot_map.h"
 #include "core/vector3.h"
 #include "graphics/mesh_manager.h"
 #include "graphics/scene.h"
@@ -257,7 +259,10 @@ class BulletPhysicsSystem : public PhysicsSystem
     std::unique_ptr<btDiscreteDynamicsWorld> world_;
 
     /** Collection of rigid bodies. */
-    std::vector<std::unique_ptr<RigidBody>> bodies_;
+    SlotMap<std::unique_ptr<RigidBody>> bodies_;
+
+    /** Map of rigid body to its handle in bodies_. */
+    std::unordered_map<const RigidBody *, SlotMapHandle> body_handles_;
 
     /** Collection of character controllers. */
     std::vector<std::unique_ptr<CharacterController>> character_controllers_;
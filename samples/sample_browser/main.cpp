@@ -145,6 +145,7 @@ void go(iris::Context context)
             }
 
             sample->variable_update();
+            context.jobs_manager().run_main_thread_jobs();
             window->render();
 
             return running;
@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/archive_resource_manager.h"
+
+#include <filesystem>
+#include <string_view>
+
+#include "core/resource_archive.h"
+#include "core/resource_view.h"
+
+namespace iris
+{
+
+ArchiveResourceManager::ArchiveResourceManager(const std::filesystem::path &archive)
+    : ResourceManager()
+    , archive_(archive)
+{
+}
+
+ResourceView ArchiveResourceManager::do_load(std::string_view resource)
+{
+    return archive_.read(resource);
+}
+
+}
@@ -0,0 +1,495 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/batch_kernels.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+#include "core/error_handling.h"
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/simd.h"
+#include "core/vector3.h"
+
+static_assert(sizeof(iris::Vector3) == sizeof(float) * 3u, "Vector3 must be three packed floats");
+static_assert(sizeof(iris::Quaternion) == sizeof(float) * 4u, "Quaternion must be four packed floats");
+
+namespace
+{
+
+/** Dot product above which slerp falls back to a normalised linear interpolation, matches Quaternion::slerp. */
+constexpr auto slerp_threshold = 0.9995f;
+
+/**
+ * Read a Vector3 from a structure-of-arrays view.
+ */
+iris::Vector3 read(iris::ConstVector3SoaView view, std::size_t index)
+{
+    return {view.x[index], view.y[index], view.z[index]};
+}
+
+/**
+ * Write a Vector3 to a structure-of-arrays view.
+ */
+void write(iris::Vector3SoaView view, std::size_t index, const iris::Vector3 &value)
+{
+    view.x[index] = value.x;
+    view.y[index] = value.y;
+    view.z[index] = value.z;
+}
+
+/**
+ * Read a Quaternion from a structure-of-arrays view.
+ */
+iris::Quaternion read(iris::ConstQuaternionSoaView view, std::size_t index)
+{
+    return {view.x[index], view.y[index], view.z[index], view.w[index]};
+}
+
+/**
+ * Write a Quaternion to a structure-of-arrays view.
+ */
+void write(iris::QuaternionSoaView view, std::size_t index, const iris::Quaternion &value)
+{
+    view.w[index] = value.w;
+    view.x[index] = value.x;
+    view.y[index] = value.y;
+    view.z[index] = value.z;
+}
+
+/**
+ * Slerp a single quaternion.
+ */
+iris::Quaternion slerp(iris::Quaternion from, const iris::Quaternion &to, float amount)
+{
+    from.slerp(to, amount);
+    return from;
+}
+
+#if defined(IRIS_SIMD)
+
+using iris::simd::f32x4;
+
+/**
+ * Four Vector3s, one per lane.
+ */
+struct Vector3x4
+{
+    f32x4 x;
+    f32x4 y;
+    f32x4 z;
+};
+
+/**
+ * Four Quaternions, one per lane.
+ */
+struct Quaternionx4
+{
+    f32x4 w;
+    f32x4 x;
+    f32x4 y;
+    f32x4 z;
+};
+
+/**
+ * The top three rows of a matrix with each element broadcast to all lanes.
+ */
+struct SplatMatrix
+{
+    f32x4 elements[12u];
+};
+
+/**
+ * Broadcast the elements of a matrix, ready for transforming points.
+ */
+SplatMatrix splat(const iris::Matrix4 &matrix)
+{
+    SplatMatrix m{};
+
+    for (auto i = 0u; i < std::size(m.elements); ++i)
+    {
+        m.elements[i] = iris::simd::splat(matrix[i]);
+    }
+
+    return m;
+}
+
+/**
+ * Transform four points, the operation order matches the scalar version.
+ */
+Vector3x4 transform(const SplatMatrix &matrix, const Vector3x4 &p)
+{
+    const auto &m = matrix.elements;
+
+    const auto row = [&m, &p](std::size_t offset)
+    {
+        auto r = iris::simd::mul(p.x, m[offset + 0u]);
+        r = iris::simd::madd(p.y, m[offset + 1u], r);
+        r = iris::simd::madd(p.z, m[offset + 2u], r);
+        return iris::simd::add(r, m[offset + 3u]);
+    };
+
+    return {row(0u), row(4u), row(8u)};
+}
+
+/**
+ * Load four packed Vector3s and deinterleave them into lanes.
+ */
+Vector3x4 load(const iris::Vector3 *ptr)
+{
+    std::array<float, 12u> buffer{};
+    std::memcpy(buffer.data(), ptr, sizeof(buffer));
+
+    // a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)
+    const auto a = iris::simd::load(buffer.data() + 0u);
+    const auto b = iris::simd::load(buffer.data() + 4u);
+    const auto c = iris::simd::load(buffer.data() + 8u);
+
+    using iris::simd::shuffle;
+
+    return {
+        shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c)),
+        shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c)),
+        shuffle<0, 2, 0, 2>(shuffle<2, 2, 1, 1>(a, b), shuffle<0, 0, 3, 3>(c, c))};
+}
+
+/**
+ * Interleave four Vector3s from lanes and store them packed.
+ */
+void store(iris::Vector3 *ptr, const Vector3x4 &v)
+{
+    using iris::simd::shuffle;
+
+    // a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)
+    const auto a = shuffle<0, 2, 0, 2>(shuffle<0, 0, 0, 0>(v.x, v.y), shuffle<0, 0, 1, 1>(v.z, v.x));
+    const auto b = shuffle<0, 2, 0, 2>(shuffle<1, 1, 1, 1>(v.y, v.z), shuffle<2, 2, 2, 2>(v.x, v.y));
+    const auto c = shuffle<0, 2, 0, 2>(shuffle<2, 2, 3, 3>(v.z, v.x), shuffle<3, 3, 3, 3>(v.y, v.z));
+
+    std::array<float, 12u> buffer{};
+    iris::simd::store(buffer.data() + 0u, a);
+    iris::simd::store(buffer.data() + 4u, b);
+    iris::simd::store(buffer.data() + 8u, c);
+
+    for (auto i = 0u; i < 4u; ++i)
+    {
+        ptr[i] = {buffer[i * 3u + 0u], buffer[i * 3u + 1u], buffer[i * 3u + 2u]};
+    }
+}
+
+/**
+ * Load four packed Quaternions and transpose them into lanes.
+ */
+Quaternionx4 load(const iris::Quaternion *ptr)
+{
+    std::array<float, 16u> buffer{};
+    std::memcpy(buffer.data(), ptr, sizeof(buffer));
+
+    Quaternionx4 q{
+        iris::simd::load(buffer.data() + 0u),
+        iris::simd::load(buffer.data() + 4u),
+        iris::simd::load(buffer.data() + 8u),
+        iris::simd::load(buffer.data() + 12u)};
+    iris::simd::transpose(q.w, q.x, q.y, q.z);
+
+    return q;
+}
+
+/**
+ * Transpose four Quaternions from lanes and store them packed.
+ */
+void store(iris::Quaternion *ptr, Quaternionx4 q)
+{
+    iris::simd::transpose(q.w, q.x, q.y, q.z);
+
+    std::array<float, 16u> buffer{};
+    iris::simd::store(buffer.data() + 0u, q.w);
+    iris::simd::store(buffer.data() + 4u, q.x);
+    iris::simd::store(buffer.data() + 8u, q.y);
+    iris::simd::store(buffer.data() + 12u, q.z);
+
+    // packed layout is (w x y z)
+    for (auto i = 0u; i < 4u; ++i)
+    {
+        ptr[i].w = buffer[i * 4u + 0u];
+        ptr[i].x = buffer[i * 4u + 1u];
+        ptr[i].y = buffer[i * 4u + 2u];
+        ptr[i].z = buffer[i * 4u + 3u];
+    }
+}
+
+/**
+ * Normalise four quaternions, matches Quaternion::normalise.
+ */
+Quaternionx4 normalise(const Quaternionx4 &q)
+{
+    auto magnitude = iris::simd::mul(q.w, q.w);
+    magnitude = iris::simd::madd(q.x, q.x, magnitude);
+    magnitude = iris::simd::madd(q.y, q.y, magnitude);
+    magnitude = iris::simd::madd(q.z, q.z, magnitude);
+
+    // a zero quaternion becomes the identity
+    const auto one = iris::simd::splat(1.0f);
+    const auto zero = iris::simd::equal(magnitude, iris::simd::splat(0.0f));
+    const auto d = iris::simd::select(zero, one, iris::simd::sqrt(magnitude));
+
+    return {
+        iris::simd::select(zero, one, iris::simd::div(q.w, d)),
+        iris::simd::div(q.x, d),
+        iris::simd::div(q.y, d),
+        iris::simd::div(q.z, d)};
+}
+
+/**
+ * Slerp four pairs of quaternions.
+ *
+ * Everything is done four wide except the trig, which has no SIMD equivalent, so is done per lane.
+ */
+Quaternionx4 slerp(const Quaternionx4 &from, Quaternionx4 to, float amount)
+{
+    auto dot = iris::simd::mul(from.x, to.x);
+    dot = iris::simd::madd(from.y, to.y, dot);
+    dot = iris::simd::madd(from.z, to.z, dot);
+    dot = iris::simd::madd(from.w, to.w, dot);
+
+    // take the shortest path
+    const auto negate = iris::simd::less(dot, iris::simd::splat(0.0f));
+    const auto minus_one = iris::simd::splat(-1.0f);
+    to.w = iris::simd::select(negate, iris::simd::mul(to.w, minus_one), to.w);
+    to.x = iris::simd::select(negate, iris::simd::mul(to.x, minus_one), to.x);
+    to.y = iris::simd::select(negate, iris::simd::mul(to.y, minus_one), to.y);
+    to.z = iris::simd::select(negate, iris::simd::mul(to.z, minus_one), to.z);
+    dot = iris::simd::select(negate, iris::simd::mul(dot, minus_one), dot);
+
+    // weights for the slerp lanes, sin(theta_0) is computed as sqrt((1 - dot) * (1 + dot)) four wide and only the
+    // remaining trig is done per lane
+    const auto one = iris::simd::splat(1.0f);
+    const auto sin_theta_0 = iris::simd::sqrt(iris::simd::mul(iris::simd::sub(one, dot), iris::simd::add(one, dot)));
+
+    std::array<float, 4u> dots{};
+    std::array<float, 4u> sin_theta{};
+    std::array<float, 4u> sin_remaining{};
+    iris::simd::store(dots.data(), dot);
+
+    for (auto i = 0u; i < dots.size(); ++i)
+    {
+        const auto theta_0 = std::acos(dots[i]);
+        sin_theta[i] = std::sin(theta_0 * amount);
+        sin_remaining[i] = std::sin(theta_0 * (1.0f - amount));
+    }
+
+    const auto w0 = iris::simd::div(iris::simd::load(sin_remaining.data()), sin_theta_0);
+    const auto w1 = iris::simd::div(iris::simd::load(sin_theta.data()), sin_theta_0);
+    const auto t = iris::simd::splat(amount);
+
+    const auto weighted = [&w0, &w1](f32x4 a, f32x4 b) { return iris::simd::madd(b, w1, iris::simd::mul(a, w0)); };
+    const auto lerp = [&t](f32x4 a, f32x4 b) { return iris::simd::madd(iris::simd::sub(b, a), t, a); };
+
+    // nearly parallel quaternions use a normalised lerp
+    const auto nlerp = normalise({lerp(from.w, to.w), lerp(from.x, to.x), lerp(from.y, to.y), lerp(from.z, to.z)});
+    const auto use_nlerp = iris::simd::less(iris::simd::splat(slerp_threshold), dot);
+
+    return {
+        iris::simd::select(use_nlerp, nlerp.w, weighted(from.w, to.w)),
+        iris::simd::select(use_nlerp, nlerp.x, weighted(from.x, to.x)),
+        iris::simd::select(use_nlerp, nlerp.y, weighted(from.y, to.y)),
+        iris::simd::select(use_nlerp, nlerp.z, weighted(from.z, to.z))};
+}
+
+#endif
+
+}
+
+namespace iris
+{
+
+void transform_points(const Matrix4 &matrix, std::span<const Vector3> in, std::span<Vector3> out)
+{
+    expect(in.size() == out.size(), "size mismatch");
+
+    std::size_t i = 0u;
+
+#if defined(IRIS_SIMD)
+    const auto m = splat(matrix);
+
+    for (; i + simd::width <= in.size(); i += simd::width)
+    {
+        store(out.data() + i, transform(m, load(in.data() + i)));
+    }
+#endif
+
+    for (; i < in.size(); ++i)
+    {
+        out[i] = matrix * in[i];
+    }
+}
+
+void transform_points(const Matrix4 &matrix, ConstVector3SoaView in, Vector3SoaView out)
+{
+    expect(
+        (in.y.size() == in.size()) && (in.z.size() == in.size()) && (out.size() == in.size()) &&
+            (out.y.size() == in.size()) && (out.z.size() == in.size()),
+        "size mismatch");
+
+    std::size_t i = 0u;
+
+#if defined(IRIS_SIMD)
+    const auto m = splat(matrix);
+
+    for (; i + simd::width <= in.size(); i += simd::width)
+    {
+        const auto p = transform(m, {simd::load(&in.x[i]), simd::load(&in.y[i]), simd::load(&in.z[i])});
+
+        simd::store(&out.x[i], p.x);
+        simd::store(&out.y[i], p.y);
+        simd::store(&out.z[i], p.z);
+    }
+#endif
+
+    for (; i < in.size(); ++i)
+    {
+        write(out, i, matrix * read(in, i));
+    }
+}
+
+void multiply_matrices(std::span<const Matrix4> lhs, std::span<const Matrix4> rhs, std::span<Matrix4> out)
+{
+    expect((lhs.size() == rhs.size()) && (lhs.size() == out.size()), "size mismatch");
+
+    // a single multiply already fills the SIMD lanes
+    for (auto i = 0u; i < lhs.size(); ++i)
+    {
+        out[i] = lhs[i] * rhs[i];
+    }
+}
+
+void multiply_matrices(const Matrix4 &lhs, std::span<const Matrix4> rhs, std::span<Matrix4> out)
+{
+    expect(rhs.size() == out.size(), "size mismatch");
+
+    // take a copy in case lhs aliases out
+    const auto m = lhs;
+
+    for (auto i = 0u; i < rhs.size(); ++i)
+    {
+        out[i] = m * rhs[i];
+    }
+}
+
+void normalise_quaternions(std::span<Quaternion> quaternions)
+{
+    std::size_t i = 0u;
+
+#if defined(IRIS_SIMD)
+    for (; i + simd::width <= quaternions.size(); i += simd::width)
+    {
+        store(quaternions.data() + i, normalise(load(quaternions.data() + i)));
+    }
+#endif
+
+    for (; i < quaternions.size(); ++i)
+    {
+        quaternions[i].normalise();
+    }
+}
+
+void normalise_quaternions(QuaternionSoaView quaternions)
+{
+    const auto size = quaternions.size();
+    expect(
+        (quaternions.x.size() == size) && (quaternions.y.size() == size) && (quaternions.z.size() == size),
+        "size mismatch");
+
+    std::size_t i = 0u;
+
+#if defined(IRIS_SIMD)
+    for (; i + simd::width <= size; i += simd::width)
+    {
+        const auto q = normalise(
+            {simd::load(&quaternions.w[i]),
+             simd::load(&quaternions.x[i]),
+             simd::load(&quaternions.y[i]),
+             simd::load(&quaternions.z[i])});
+
+        simd::store(&quaternions.w[i], q.w);
+        simd::store(&quaternions.x[i], q.x);
+        simd::store(&quaternions.y[i], q.y);
+        simd::store(&quaternions.z[i], q.z);
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        Quaternion q{quaternions.x[i], quaternions.y[i], quaternions.z[i], quaternions.w[i]};
+        write(quaternions, i, q.normalise());
+    }
+}
+
+void slerp_quaternions(
+    std::span<const Quaternion> from,
+    std::span<const Quaternion> to,
+    float amount,
+    std::span<Quaternion> out)
+{
+    expect((from.size() == to.size()) && (from.size() == out.size()), "size mismatch");
+
+    std::size_t i = 0u;
+
+#if defined(IRIS_SIMD)
+    for (; i + simd::width <= from.size(); i += simd::width)
+    {
+        store(out.data() + i, slerp(load(from.data() + i), load(to.data() + i), amount));
+    }
+#endif
+
+    for (; i < from.size(); ++i)
+    {
+        out[i] = slerp(from[i], to[i], amount);
+    }
+}
+
+void slerp_quaternions(ConstQuaternionSoaView from, ConstQuaternionSoaView to, float amount, QuaternionSoaView out)
+{
+    const auto size = from.size();
+    expect(
+        (from.x.size() == size) && (from.y.size() == size) && (from.z.size() == size) && (to.size() == size) &&
+            (to.x.size() == size) && (to.y.size() == size) && (to.z.size() == size) && (out.size() == size) &&
+            (out.x.size() == size) && (out.y.size() == size) && (out.z.size() == size),
+        "size mismatch");
+
+    std::size_t i = 0u;
+
+#if defined(IRIS_SIMD)
+    const auto load_soa = [](ConstQuaternionSoaView view, std::size_t index) -> Quaternionx4
+    {
+        return {
+            simd::load(&view.w[index]),
+            simd::load(&view.x[index]),
+            simd::load(&view.y[index]),
+            simd::load(&view.z[index])};
+    };
+
+    for (; i + simd::width <= size; i += simd::width)
+    {
+        const auto q = slerp(load_soa(from, i), load_soa(to, i), amount);
+
+        simd::store(&out.w[i], q.w);
+        simd::store(&out.x[i], q.x);
+        simd::store(&out.y[i], q.y);
+        simd::store(&out.z[i], q.z);
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        write(out, i, slerp(read(from, i), read(to, i), amount));
+    }
+}
+
+}
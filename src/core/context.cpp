@@ -19,6 +19,7 @@
 #include "graphics/render_target_manager.h"
 #include "graphics/texture_manager.h"
 #include "graphics/window_manager.h"
+#include "jobs/job_system_config.h"
 #include "jobs/job_system_manager.h"
 #include "physics/physics_manager.h"
 
@@ -34,8 +35,11 @@ Context::Context(int argc, char **argv)
     , jobs_api_()
     , resource_manager_()
     , args_(argc)
+    , job_system_config_()
 {
     std::transform(argv, argv + argc, std::begin(args_), [](const char *arg) -> std::string { return arg; });
+
+    job_system_config_ = parse_job_system_config(args_);
 }
 
 Context::~Context()
@@ -52,6 +56,11 @@ const std::vector<std::string> &Context::args() const
 {
     return args_;
 }
+
+const JobSystemConfig &Context::job_system_config() const
+{
+    return job_system_config_;
+}
 WindowManager &Context::window_manager() const
 {
     return *graphics_api_managers_.at(graphics_api_).window_manager;
@@ -179,7 +188,7 @@ void Context::set_jobs_api(const std::string &api)
 
     jobs_api_ = api;
 
-    jobs_manager().create_job_system();
+    jobs_manager().create_job_system(job_system_config_);
 }
 
 std::vector<std::string> Context::registered_jobs_apis() const
@@ -6,29 +6,22 @@
 
 #include "core/default_resource_manager.h"
 
-#include <filesystem>
-#include <fstream>
-#include <sstream>
+#include <memory>
 #include <string_view>
+#include <utility>
 
-#include "core/error_handling.h"
+#include "core/mapped_file.h"
+#include "core/resource_view.h"
 
 namespace iris
 {
 
-DataBuffer DefaultResourceManager::do_load(std::string_view resource)
+ResourceView DefaultResourceManager::do_load(std::string_view resource)
 {
-    std::stringstream strm{};
-    std::fstream f(root_ / resource, std::ios::in | std::ios::binary);
+    auto file = std::make_shared<const MappedFile>(root_ / resource);
+    const auto data = file->data();
 
-    strm << f.rdbuf();
-
-    ensure(f.good() && !f.bad(), "failed to read file");
-
-    const auto str = strm.str();
-    const auto *str_ptr = reinterpret_cast<const std::byte *>(str.data());
-
-    return {str_ptr, str_ptr + str.length()};
+    return {data, std::move(file)};
 }
 
 }
@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/frame_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/error_handling.h"
+
+namespace
+{
+
+#if defined(NDEBUG)
+constexpr auto poison_by_default = false;
+#else
+constexpr auto poison_by_default = true;
+#endif
+
+/** Incremented by advance_frame. */
+std::atomic<std::uint64_t> current_frame = 0u;
+
+/**
+ * Collection of every thread's arena, so stats can be reported.
+ */
+struct ArenaRegistry
+{
+    /** Lock for arenas. */
+    std::mutex mutex;
+
+    /** Arena of each thread. */
+    std::vector<std::pair<std::thread::id, iris::FrameArena *>> arenas;
+};
+
+/**
+ * Get the registry, this is a function local static so it's safe to use from thread_local objects.
+ *
+ * @returns
+ *   Arena registry.
+ */
+ArenaRegistry &registry()
+{
+    static ArenaRegistry registry{};
+    return registry;
+}
+
+/**
+ * A thread's frame arena, registers itself for the lifetime of the thread.
+ */
+struct ThreadArena
+{
+    ThreadArena()
+        : arena()
+        , frame(current_frame.load(std::memory_order_relaxed))
+    {
+        auto &reg = registry();
+        std::unique_lock lock(reg.mutex);
+        reg.arenas.emplace_back(std::this_thread::get_id(), &arena);
+    }
+
+    ~ThreadArena()
+    {
+        auto &reg = registry();
+        std::unique_lock lock(reg.mutex);
+        std::erase_if(reg.arenas, [this](const auto &element) { return element.second == &arena; });
+    }
+
+    /** Arena for thread. */
+    iris::FrameArena arena;
+
+    /** Frame the arena was last reset for. */
+    std::uint64_t frame;
+};
+
+/**
+ * Get the arena for the calling thread, creating it if needed.
+ *
+ * @returns
+ *   Arena for calling thread.
+ */
+ThreadArena &this_thread_arena()
+{
+    thread_local ThreadArena thread_arena{};
+    return thread_arena;
+}
+
+}
+
+namespace iris
+{
+
+FrameArenaResource::FrameArenaResource(FrameArena &arena)
+    : arena_(arena)
+{
+}
+
+void *FrameArenaResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    return arena_.allocate(bytes, alignment);
+}
+
+void FrameArenaResource::do_deallocate(void *, std::size_t, std::size_t)
+{
+    // memory is only reclaimed on reset
+}
+
+bool FrameArenaResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+FrameArena::FrameArena(std::size_t block_size)
+    : FrameArena(block_size, poison_by_default)
+{
+}
+
+FrameArena::FrameArena(std::size_t block_size, bool poison)
+    : block_size_(block_size)
+    , poison_(poison)
+    , blocks_()
+    , offset_(0u)
+    , previous_blocks_used_(0u)
+    , bytes_allocated_(0u)
+    , high_water_mark_(0u)
+    , capacity_(0u)
+    , resource_(*this)
+{
+    ensure(block_size_ > 0u, "block size must be greater than zero");
+
+    add_block(block_size_);
+}
+
+void *FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    expect((alignment != 0u) && ((alignment & (alignment - 1u)) == 0u), "alignment must be a power of two");
+
+    const auto padding_for = [alignment](const std::byte *ptr)
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return ((address + alignment - 1u) & ~(alignment - 1u)) - address;
+    };
+
+    auto padding = padding_for(blocks_.back().memory.get() + offset_);
+
+    if (offset_ + padding + size > blocks_.back().size)
+    {
+        // reserve enough that the allocation fits whatever the alignment of the new block
+        add_block(size + alignment);
+        padding = padding_for(blocks_.back().memory.get());
+    }
+
+    auto *ptr = blocks_.back().memory.get() + offset_ + padding;
+    offset_ += padding + size;
+
+    const auto allocated = previous_blocks_used_ + offset_;
+    bytes_allocated_.store(allocated, std::memory_order_relaxed);
+
+    if (allocated > high_water_mark_.load(std::memory_order_relaxed))
+    {
+        high_water_mark_.store(allocated, std::memory_order_relaxed);
+    }
+
+    if (poison_)
+    {
+        std::memset(ptr, allocated_poison, size);
+    }
+
+    return ptr;
+}
+
+void FrameArena::reset()
+{
+    if (poison_)
+    {
+        // everything but the current block is full (bar some padding at the end)
+        for (auto i = 0u; i < blocks_.size(); ++i)
+        {
+            const auto used = (i == blocks_.size() - 1u) ? offset_ : blocks_[i].size;
+            std::memset(blocks_[i].memory.get(), reset_poison, used);
+        }
+    }
+
+    // if this frame overflowed then replace all blocks with one that can hold all of it, so the next frame fits
+    if (blocks_.size() > 1u)
+    {
+        const auto merged_size = capacity_.load(std::memory_order_relaxed);
+
+        blocks_.clear();
+        capacity_.store(0u, std::memory_order_relaxed);
+        add_block(merged_size);
+
+        if (poison_)
+        {
+            std::memset(blocks_.back().memory.get(), reset_poison, blocks_.back().size);
+        }
+    }
+
+    offset_ = 0u;
+    previous_blocks_used_ = 0u;
+    bytes_allocated_.store(0u, std::memory_order_relaxed);
+}
+
+std::pmr::memory_resource *FrameArena::resource()
+{
+    return &resource_;
+}
+
+FrameArenaStats FrameArena::stats() const
+{
+    return {
+        .bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed),
+        .high_water_mark = high_water_mark_.load(std::memory_order_relaxed),
+        .capacity = capacity_.load(std::memory_order_relaxed)};
+}
+
+void FrameArena::add_block(std::size_t size)
+{
+    const auto block_size = std::max(size, block_size_);
+
+    previous_blocks_used_ += offset_;
+    offset_ = 0u;
+
+    blocks_.push_back({.memory = std::make_unique_for_overwrite<std::byte[]>(block_size), .size = block_size});
+    capacity_.store(capacity_.load(std::memory_order_relaxed) + block_size, std::memory_order_relaxed);
+}
+
+FrameArena &this_thread_frame_arena()
+{
+    return this_thread_arena().arena;
+}
+
+std::pmr::memory_resource *frame_resource()
+{
+    return this_thread_frame_arena().resource();
+}
+
+void advance_frame()
+{
+    current_frame.fetch_add(1u, std::memory_order_relaxed);
+    reclaim_frame_arena();
+}
+
+void reclaim_frame_arena()
+{
+    auto &thread_arena = this_thread_arena();
+
+    // only the owning thread ever resets its arena, so this is just a check against the global frame
+    const auto frame = current_frame.load(std::memory_order_relaxed);
+    if (thread_arena.frame != frame)
+    {
+        thread_arena.arena.reset();
+        thread_arena.frame = frame;
+    }
+}
+
+std::vector<ThreadFrameArenaStats> frame_arena_stats()
+{
+    auto &reg = registry();
+    std::unique_lock lock(reg.mutex);
+
+    std::vector<ThreadFrameArenaStats> stats{};
+
+    for (const auto &[thread, arena] : reg.arenas)
+    {
+        stats.push_back({.thread = thread, .stats = arena->stats()});
+    }
+
+    return stats;
+}
+
+}
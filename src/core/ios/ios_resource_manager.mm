@@ -4,21 +4,23 @@
 //                 https://www.boost.org/LICENSE_1_0.txt)                     //
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "core/ios_resource_manager.h"
+#include "core/ios/ios_resource_manager.h"
 
-#include <fstream>
-#include <sstream>
+#include <memory>
 #include <string_view>
+#include <utility>
 
 #import <UIKit/UIKit.h>
 
 #include "core/exception.h"
 #include "core/macos/macos_ios_utility.h"
+#include "core/mapped_file.h"
+#include "core/resource_view.h"
 
 namespace iris
 {
 
-DataBuffer ResourceManager::load(std::string_view resource)
+ResourceView IOSResourceManager::do_load(std::string_view resource)
 {
     const auto *bundle = [NSBundle mainBundle];
     if (bundle == nullptr)
@@ -37,14 +39,10 @@ DataBuffer ResourceManager::load(std::string_view resource)
     const auto *path = [NSString pathWithComponents:parts];
     const auto *cpath = [path fileSystemRepresentation];
 
-    std::stringstream strm{};
-    std::fstream f(cpath, std::ios::in | std::ios::binary);
-    strm << f.rdbuf();
+    auto file = std::make_shared<const MappedFile>(cpath);
+    const auto data = file->data();
 
-    const auto str = strm.str();
-    const auto *ptr = reinterpret_cast<const std::byte *>(str.data());
-
-    return {ptr, ptr + str.size()};
+    return {data, std::move(file)};
 }
 
 }
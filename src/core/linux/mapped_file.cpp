@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/mapped_file.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/auto_release.h"
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+struct MappedFile::implementation
+{
+    std::byte *region;
+    std::size_t size;
+};
+
+MappedFile::MappedFile(const std::filesystem::path &path)
+    : impl_(std::make_unique<implementation>())
+{
+    impl_->region = nullptr;
+    impl_->size = 0u;
+
+    AutoRelease<int, -1> fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC), ::close};
+    ensure(fd, "failed to open file");
+
+    struct ::stat info{};
+    ensure(::fstat(fd, &info) == 0, "failed to stat file");
+
+    impl_->size = static_cast<std::size_t>(info.st_size);
+
+    // mapping zero bytes is an error, so leave empty files unmapped
+    if (impl_->size != 0u)
+    {
+        auto *region = ::mmap(nullptr, impl_->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ensure(region != MAP_FAILED, "failed to map file");
+
+        impl_->region = static_cast<std::byte *>(region);
+
+        // files are usually parsed front to back, so let the kernel read ahead aggressively
+        ::madvise(region, impl_->size, MADV_SEQUENTIAL);
+    }
+
+    // the mapping keeps its own reference to the file, so the descriptor can be closed here
+}
+
+MappedFile::~MappedFile()
+{
+    if (impl_->region != nullptr)
+    {
+        ::munmap(impl_->region, impl_->size);
+    }
+}
+
+std::span<const std::byte> MappedFile::data() const
+{
+    return {impl_->region, impl_->size};
+}
+
+std::size_t MappedFile::size() const
+{
+    return impl_->size;
+}
+
+}
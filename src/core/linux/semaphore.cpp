@@ -50,4 +50,15 @@ void Semaphore::acquire()
     --impl_->count;
 }
 
+bool Semaphore::try_acquire()
+{
+    if (::sem_trywait(impl_->auto_semaphore) != 0)
+    {
+        return false;
+    }
+
+    --impl_->count;
+    return true;
+}
+
 }
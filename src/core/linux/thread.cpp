@@ -6,7 +6,10 @@
 
 #include "core/thread.h"
 
+#include <cstddef>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <pthread.h>
 
@@ -48,4 +51,28 @@ void Thread::bind_to_core(std::size_t core)
     ensure(::pthread_setaffinity_np(pthread_handle, sizeof(cpuset), &cpuset) == 0, "could not set cputset");
 }
 
+void Thread::bind_to_cores(const std::vector<std::size_t> &cores)
+{
+    ensure(!cores.empty(), "must bind to at least one core");
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+
+    for (const auto core : cores)
+    {
+        ensure(core < std::thread::hardware_concurrency(), "invalid core id");
+        CPU_SET(core, &cpuset);
+    }
+
+    ensure(::pthread_setaffinity_np(thread_.native_handle(), sizeof(cpuset), &cpuset) == 0, "could not set cputset");
+}
+
+void Thread::set_name(const std::string &name)
+{
+    // linux limits names to 16 characters including the null terminator
+    const auto truncated = name.substr(0u, 15u);
+
+    expect(::pthread_setname_np(thread_.native_handle(), truncated.c_str()) == 0, "could not set thread name");
+}
+
 }
@@ -45,4 +45,15 @@ void Semaphore::acquire()
     --impl_->count;
 }
 
+bool Semaphore::try_acquire()
+{
+    if (::dispatch_semaphore_wait(impl_->semaphore, DISPATCH_TIME_NOW) != 0)
+    {
+        return false;
+    }
+
+    --impl_->count;
+    return true;
+}
+
 }
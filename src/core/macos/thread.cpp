@@ -6,7 +6,10 @@
 
 #include "core/thread.h"
 
+#include <cstddef>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <mach/mach.h>
 #include <mach/thread_policy.h>
@@ -51,4 +54,20 @@ void Thread::bind_to_core(std::size_t core)
     expect(set_policy == KERN_SUCCESS, "failed to bind thread to core");
 }
 
+void Thread::bind_to_cores(const std::vector<std::size_t> &cores)
+{
+    ensure(!cores.empty(), "must bind to at least one core");
+
+    // affinity policies are a single tag, so there is no way to express a set of cores
+    if (cores.size() == 1u)
+    {
+        bind_to_core(cores.front());
+    }
+}
+
+void Thread::set_name(const std::string &)
+{
+    // pthread_setname_np can only name the calling thread on macOS, so there is nothing we can do here
+}
+
 }
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/resource_archive.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
+
+#include "core/data_buffer.h"
+#include "core/error_handling.h"
+#include "core/mapped_file.h"
+#include "core/resource_view.h"
+
+namespace
+{
+
+/** Magic bytes at the start of every archive. */
+constexpr std::array<char, 4u> magic{{'I', 'R', 'P', 'K'}};
+
+/** Current format version. */
+constexpr std::uint32_t version = 1u;
+
+/** Size of header: magic, version, entry count, names size. */
+constexpr std::size_t header_size = 16u;
+
+/** Size of an index record: offset, size, stored size, name offset, name size, compression, reserved. */
+constexpr std::size_t record_size = 40u;
+
+/** Alignment of entry data. */
+constexpr std::size_t data_alignment = 16u;
+
+/**
+ * Read a value from a buffer.
+ *
+ * @param data
+ *   Buffer to read from.
+ *
+ * @param offset
+ *   Offset into buffer, must leave enough bytes for the value.
+ *
+ * @returns
+ *   Read value.
+ */
+template <class T>
+T read_value(std::span<const std::byte> data, std::size_t offset)
+{
+    T value{};
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+/**
+ * Append a value to a buffer.
+ *
+ * @param data
+ *   Buffer to write to.
+ *
+ * @param value
+ *   Value to write.
+ */
+template <class T>
+void write_value(iris::DataBuffer &data, T value)
+{
+    const auto *bytes = reinterpret_cast<const std::byte *>(&value);
+    data.insert(std::cend(data), bytes, bytes + sizeof(value));
+}
+
+/**
+ * Round a value up to the data alignment.
+ *
+ * @param value
+ *   Value to align.
+ *
+ * @returns
+ *   Aligned value.
+ */
+std::uint64_t align(std::uint64_t value)
+{
+    return (value + data_alignment - 1u) & ~static_cast<std::uint64_t>(data_alignment - 1u);
+}
+
+}
+
+namespace iris
+{
+
+ResourceArchive::ResourceArchive(const std::filesystem::path &path)
+    : file_(std::make_shared<const MappedFile>(path))
+    , entries_()
+{
+    const auto data = file_->data();
+
+    ensure(data.size() >= header_size, "archive too small");
+    ensure(std::memcmp(data.data(), magic.data(), magic.size()) == 0, "not a resource archive");
+    ensure(read_value<std::uint32_t>(data, 4u) == version, "unsupported archive version");
+
+    const auto entry_count = read_value<std::uint32_t>(data, 8u);
+    const auto names_size = read_value<std::uint32_t>(data, 12u);
+    const auto names_offset = header_size + (static_cast<std::uint64_t>(entry_count) * record_size);
+
+    ensure(names_offset + names_size <= data.size(), "archive index truncated");
+
+    const std::string_view names{reinterpret_cast<const char *>(data.data()) + names_offset, names_size};
+
+    entries_.reserve(entry_count);
+
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+        const auto record = header_size + (i * record_size);
+
+        const auto offset = read_value<std::uint64_t>(data, record);
+        const auto size = read_value<std::uint64_t>(data, record + 8u);
+        const auto stored_size = read_value<std::uint64_t>(data, record + 16u);
+        const auto name_offset = read_value<std::uint32_t>(data, record + 24u);
+        const auto name_size = read_value<std::uint32_t>(data, record + 28u);
+        const auto compression = static_cast<ArchiveCompression>(read_value<std::uint32_t>(data, record + 32u));
+
+        ensure(
+            (static_cast<std::uint64_t>(name_offset) + name_size <= names.size()) && (offset <= data.size()) &&
+                (stored_size <= data.size() - offset),
+            "archive entry out of bounds");
+        ensure(
+            (compression == ArchiveCompression::NONE) || (compression == ArchiveCompression::DEFLATE),
+            "unknown archive compression");
+
+        entries_.push_back({names.substr(name_offset, name_size), offset, size, stored_size, compression});
+
+        // lookup relies on the index being sorted
+        ensure((i == 0u) || (entries_[i - 1u].name < entries_[i].name), "archive index not sorted");
+    }
+}
+
+bool ResourceArchive::contains(std::string_view name) const
+{
+    return find(name) != nullptr;
+}
+
+ResourceView ResourceArchive::read(std::string_view name) const
+{
+    const auto *entry = find(name);
+    ensure(entry != nullptr, "resource not in archive: " + std::string{name});
+
+    const auto stored = file_->data().subspan(entry->offset, entry->stored_size);
+
+    if (entry->compression == ArchiveCompression::NONE)
+    {
+        // a view into the shared mapping, the archive keeps it alive so it is not memory this resource owns
+        return {stored, file_, false};
+    }
+
+    ensure(
+        (entry->size <= std::numeric_limits<::uLongf>::max()) &&
+            (entry->stored_size <= std::numeric_limits<::uLong>::max()),
+        "archive entry too large");
+
+    DataBuffer data(entry->size);
+    auto size = static_cast<::uLongf>(entry->size);
+
+    const auto result = ::uncompress(
+        reinterpret_cast<::Bytef *>(data.data()),
+        &size,
+        reinterpret_cast<const ::Bytef *>(stored.data()),
+        static_cast<::uLong>(stored.size()));
+
+    ensure((result == Z_OK) && (size == entry->size), "failed to decompress: " + std::string{name});
+
+    return ResourceView{std::move(data)};
+}
+
+std::size_t ResourceArchive::size() const
+{
+    return entries_.size();
+}
+
+const ResourceArchive::Entry *ResourceArchive::find(std::string_view name) const
+{
+    const auto entry = std::lower_bound(
+        std::cbegin(entries_),
+        std::cend(entries_),
+        name,
+        [](const Entry &element, std::string_view value) { return element.name < value; });
+
+    return ((entry != std::cend(entries_)) && (entry->name == name)) ? std::addressof(*entry) : nullptr;
+}
+
+ResourceArchiveWriter::ResourceArchiveWriter()
+    : entries_()
+{
+}
+
+void ResourceArchiveWriter::add(std::string name, std::span<const std::byte> data, ArchiveCompression compression)
+{
+    ensure(name.size() <= std::numeric_limits<std::uint32_t>::max(), "name too long");
+
+    if (compression == ArchiveCompression::DEFLATE)
+    {
+        ensure(data.size() <= std::numeric_limits<::uLong>::max(), "entry too large to compress");
+
+        auto compressed_size = ::compressBound(static_cast<::uLong>(data.size()));
+        DataBuffer compressed(compressed_size);
+
+        const auto result = ::compress2(
+            reinterpret_cast<::Bytef *>(compressed.data()),
+            &compressed_size,
+            reinterpret_cast<const ::Bytef *>(data.data()),
+            static_cast<::uLong>(data.size()),
+            Z_BEST_COMPRESSION);
+
+        ensure(result == Z_OK, "failed to compress: " + name);
+
+        // already compressed formats (e.g. png) won't get any smaller, so it's not worth decompressing them
+        if (compressed_size < data.size())
+        {
+            compressed.resize(compressed_size);
+            entries_.push_back({std::move(name), std::move(compressed), data.size(), ArchiveCompression::DEFLATE});
+            return;
+        }
+    }
+
+    entries_.push_back(
+        {std::move(name), DataBuffer(std::cbegin(data), std::cend(data)), data.size(), ArchiveCompression::NONE});
+}
+
+void ResourceArchiveWriter::write(const std::filesystem::path &path)
+{
+    std::sort(
+        std::begin(entries_),
+        std::end(entries_),
+        [](const Entry &a, const Entry &b) { return a.name < b.name; });
+
+    ensure(
+        std::adjacent_find(
+            std::cbegin(entries_),
+            std::cend(entries_),
+            [](const Entry &a, const Entry &b) { return a.name == b.name; }) == std::cend(entries_),
+        "duplicate archive entry");
+
+    std::string names{};
+    for (const auto &entry : entries_)
+    {
+        names.append(entry.name);
+    }
+
+    ensure(entries_.size() <= std::numeric_limits<std::uint32_t>::max(), "too many entries");
+    ensure(names.size() <= std::numeric_limits<std::uint32_t>::max(), "names too large");
+
+    DataBuffer index{};
+    index.insert(
+        std::cend(index),
+        reinterpret_cast<const std::byte *>(magic.data()),
+        reinterpret_cast<const std::byte *>(magic.data() + magic.size()));
+    write_value(index, version);
+    write_value(index, static_cast<std::uint32_t>(entries_.size()));
+    write_value(index, static_cast<std::uint32_t>(names.size()));
+
+    auto offset = align(header_size + (entries_.size() * record_size) + names.size());
+    std::uint32_t name_offset = 0u;
+
+    for (const auto &entry : entries_)
+    {
+        write_value(index, offset);
+        write_value(index, entry.size);
+        write_value(index, static_cast<std::uint64_t>(entry.data.size()));
+        write_value(index, name_offset);
+        write_value(index, static_cast<std::uint32_t>(entry.name.size()));
+        write_value(index, static_cast<std::uint32_t>(entry.compression));
+        write_value(index, std::uint32_t{0u});
+
+        offset = align(offset + entry.data.size());
+        name_offset += static_cast<std::uint32_t>(entry.name.size());
+    }
+
+    std::ofstream file{path, std::ios::out | std::ios::binary | std::ios::trunc};
+    ensure(file.good(), "could not open: " + path.string());
+
+    static constexpr std::array<char, data_alignment> padding{};
+
+    file.write(reinterpret_cast<const char *>(index.data()), index.size());
+    file.write(names.data(), names.size());
+
+    auto position = static_cast<std::uint64_t>(index.size() + names.size());
+
+    for (const auto &entry : entries_)
+    {
+        file.write(padding.data(), align(position) - position);
+        file.write(reinterpret_cast<const char *>(entry.data.data()), entry.data.size());
+
+        position = align(position) + entry.data.size();
+    }
+
+    ensure(file.good(), "failed to write: " + path.string());
+}
+
+std::size_t ResourceArchiveWriter::size() const
+{
+    return entries_.size();
+}
+
+}
@@ -6,34 +6,218 @@
 
 #include "core/resource_manager.h"
 
+#include <cstddef>
+#include <exception>
 #include <filesystem>
-#include <fstream>
-#include <sstream>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
 
-#include "core/error_handling.h"
+#include "core/preload_handle.h"
+#include "core/resource_cache_stats.h"
+#include "core/resource_view.h"
+#include "jobs/inline_job.h"
+#include "jobs/job_system_config.h"
+#include "jobs/task.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+namespace
+{
+
+/** Number of I/O threads, enough to keep a disk busy without competing with the job system for cores. */
+constexpr auto io_worker_count = 2u;
+
+/** Stride to touch resources with, the smallest page size of any supported platform. */
+constexpr std::size_t page_stride = 4096u;
+
+/**
+ * Read one byte from every page of a resource, so any I/O happens now rather than when it is first used.
+ *
+ * @param view
+ *   Resource to touch.
+ */
+void touch_pages(const iris::ResourceView &view)
+{
+    const auto *data = reinterpret_cast<const volatile std::byte *>(view.data());
+
+    for (std::size_t offset = 0u; offset < view.size(); offset += page_stride)
+    {
+        static_cast<void>(data[offset]);
+    }
+}
+
+}
 
 namespace iris
 {
 
 ResourceManager::ResourceManager()
     : root_(".")
+    , mutex_()
+    , resources_()
+    , lru_()
+    , memory_budget_(std::numeric_limits<std::size_t>::max())
+    , stats_()
+    , io_jobs_created_()
+    , io_jobs_()
+{
+}
+
+// out of line so ThreadJobSystemManager can be forward declared
+ResourceManager::~ResourceManager() = default;
+
+ResourceView ResourceManager::load(std::string_view resource)
+{
+    std::promise<ResourceView> promise{};
+    std::shared_future<ResourceView> loaded_resource{};
+    auto first_load = false;
+
+    {
+        std::unique_lock lock(mutex_);
+        std::tie(loaded_resource, first_load) = find_or_add_locked(resource, promise);
+    }
+
+    // load outside of the lock so different resources can be loaded concurrently
+    if (first_load)
+    {
+        fetch(resource, promise);
+    }
+
+    return loaded_resource.get();
+}
+
+Task<ResourceView> ResourceManager::load_async(std::string resource)
+{
+    {
+        std::unique_lock lock(mutex_);
+
+        if (const auto cached = resources_.find(resource);
+            (cached != std::cend(resources_)) && cached->second.loaded)
+        {
+            ++stats_.hits;
+            lru_.splice(std::begin(lru_), lru_, cached->second.lru_position);
+
+            co_return cached->second.view.get();
+        }
+    }
+
+    co_await schedule_on(io_jobs());
+
+    const auto view = load(resource);
+    touch_pages(view);
+
+    co_return view;
+}
+
+PreloadHandle ResourceManager::preload(std::span<const std::string> resources)
 {
+    auto state = std::make_shared<PreloadHandle::State>(
+        std::vector<std::string>(std::cbegin(resources), std::cend(resources)));
+
+    std::vector<InlineJob> jobs{};
+    jobs.reserve(resources.size());
+
+    for (auto i = 0u; i < resources.size(); ++i)
+    {
+        jobs.emplace_back(
+            [this, state, i]()
+            {
+                try
+                {
+                    const auto view = load(state->resources[i]);
+                    touch_pages(view);
+                    state->finish(view.size(), true);
+                }
+                catch (...)
+                {
+                    state->finish(0u, false);
+                }
+            });
+    }
+
+    if (!jobs.empty())
+    {
+        io_jobs().add(jobs);
+    }
+
+    return PreloadHandle{std::move(state)};
 }
 
-const DataBuffer &ResourceManager::load(std::string_view resource)
+ResourceView ResourceManager::pin(std::string_view resource)
 {
-    // lookup resource
-    auto loaded_resource = resources_.find(resource);
+    std::promise<ResourceView> promise{};
+    std::shared_future<ResourceView> loaded_resource{};
+    auto first_load = false;
 
-    // if not found load from disk, treat resource as a path relative to
-    // root
-    if (loaded_resource == std::cend(resources_))
     {
-        const auto [iter, _] = resources_.insert({std::string{resource}, do_load(resource)});
-        loaded_resource = iter;
+        std::unique_lock lock(mutex_);
+        std::tie(loaded_resource, first_load) = find_or_add_locked(resource, promise);
+
+        // pin before fetching, so it can't be evicted as soon as it's loaded
+        ++resources_.find(resource)->second.pin_count;
     }
 
-    return loaded_resource->second;
+    if (first_load)
+    {
+        fetch(resource, promise);
+    }
+
+    return loaded_resource.get();
+}
+
+void ResourceManager::unpin(std::string_view resource)
+{
+    std::unique_lock lock(mutex_);
+
+    if (const auto cached = resources_.find(resource);
+        (cached != std::cend(resources_)) && (cached->second.pin_count != 0u))
+    {
+        --cached->second.pin_count;
+        evict_locked();
+    }
+}
+
+bool ResourceManager::release(std::string_view resource)
+{
+    std::unique_lock lock(mutex_);
+
+    const auto cached = resources_.find(resource);
+    if ((cached == std::cend(resources_)) || !cached->second.loaded)
+    {
+        return false;
+    }
+
+    erase_locked(cached);
+
+    return true;
+}
+
+void ResourceManager::set_memory_budget(std::size_t bytes)
+{
+    std::unique_lock lock(mutex_);
+
+    memory_budget_ = bytes;
+    evict_locked();
+}
+
+std::size_t ResourceManager::memory_budget() const
+{
+    std::unique_lock lock(mutex_);
+    return memory_budget_;
+}
+
+ResourceCacheStats ResourceManager::stats() const
+{
+    std::unique_lock lock(mutex_);
+    return stats_;
 }
 
 void ResourceManager::set_root_directory(const std::filesystem::path &root)
@@ -41,4 +225,116 @@ void ResourceManager::set_root_directory(const std::filesystem::path &root)
     root_ = root;
 }
 
+std::pair<std::shared_future<ResourceView>, bool> ResourceManager::find_or_add_locked(
+    std::string_view resource,
+    std::promise<ResourceView> &promise)
+{
+    if (const auto cached = resources_.find(resource); cached != std::cend(resources_))
+    {
+        ++stats_.hits;
+
+        // resources still loading aren't in the lru list yet
+        if (cached->second.loaded)
+        {
+            lru_.splice(std::begin(lru_), lru_, cached->second.lru_position);
+        }
+
+        return {cached->second.view, false};
+    }
+
+    // add a placeholder so other threads wait on us to load it
+    ++stats_.misses;
+    auto loaded_resource = promise.get_future().share();
+    resources_.emplace(std::string{resource}, CachedResource{loaded_resource, 0u, 0u, false, {}});
+
+    return {std::move(loaded_resource), true};
+}
+
+void ResourceManager::fetch(std::string_view resource, std::promise<ResourceView> &promise)
+{
+    ResourceView view{};
+
+    try
+    {
+        view = do_load(resource);
+    }
+    catch (...)
+    {
+        // don't cache failures, so the resource can be retried
+        {
+            std::unique_lock lock(mutex_);
+            resources_.erase(resources_.find(resource));
+        }
+
+        promise.set_exception(std::current_exception());
+        return;
+    }
+
+    // views borrowing from shared memory (e.g. an archive mapping) cannot be freed by eviction, so they don't count
+    // towards the budget
+    const auto size = view.owns_data() ? view.size() : 0u;
+    promise.set_value(std::move(view));
+
+    std::unique_lock lock(mutex_);
+
+    // placeholders can't be released or evicted, so it must still be there
+    const auto cached = resources_.find(resource);
+    cached->second.size = size;
+    cached->second.loaded = true;
+
+    lru_.emplace_front(cached->first);
+    cached->second.lru_position = std::begin(lru_);
+
+    stats_.resident_bytes += size;
+    ++stats_.resident_count;
+
+    evict_locked();
+}
+
+void ResourceManager::evict_locked()
+{
+    auto position = std::end(lru_);
+
+    while ((stats_.resident_bytes > memory_budget_) && (position != std::begin(lru_)))
+    {
+        const auto cached = resources_.find(*std::prev(position));
+
+        // evicting a resource which is still in use (or doesn't own its data) wouldn't free anything
+        if ((cached->second.pin_count == 0u) && (cached->second.size != 0u) && cached->second.view.get().is_unique())
+        {
+            erase_locked(cached);
+            ++stats_.evictions;
+        }
+        else
+        {
+            --position;
+        }
+    }
+}
+
+void ResourceManager::erase_locked(
+    std::unordered_map<std::string, CachedResource, StringHash, std::equal_to<>>::iterator cached)
+{
+    stats_.resident_bytes -= cached->second.size;
+    --stats_.resident_count;
+
+    // the lru entry is a view of the key, so remove it first
+    lru_.erase(cached->second.lru_position);
+    resources_.erase(cached);
+}
+
+ThreadJobSystemManager &ResourceManager::io_jobs()
+{
+    std::call_once(
+        io_jobs_created_,
+        [this]()
+        {
+            io_jobs_ = std::make_unique<ThreadJobSystemManager>();
+            io_jobs_->create_job_system(
+                {.worker_count = io_worker_count, .worker_names = {"iris io 0", "iris io 1"}});
+        });
+
+    return *io_jobs_;
+}
+
 }
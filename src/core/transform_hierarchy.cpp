@@ -0,0 +1,482 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/transform_hierarchy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "core/matrix4.h"
+#include "core/transform.h"
+#include "jobs/job_system_manager.h"
+
+namespace
+{
+
+/** Sentinel position for a node with no parent. */
+constexpr auto no_parent = std::numeric_limits<std::uint32_t>::max();
+
+/** Node has had its local transform changed. */
+constexpr std::uint8_t dirty_flag = 1u << 0u;
+
+/** Node or one of its descendants is dirty. */
+constexpr std::uint8_t subtree_dirty_flag = 1u << 1u;
+
+/** Node had its world transform recomputed in the current (or last) update, so its children must be recomputed. */
+constexpr std::uint8_t changed_flag = 1u << 2u;
+
+/**
+ * Rearrange a vector.
+ *
+ * @param values
+ *   Vector to rearrange.
+ *
+ * @param order
+ *   The old index of each element in the new order.
+ */
+template <class T>
+void gather(std::vector<T> &values, const std::vector<std::uint32_t> &order)
+{
+    std::vector<T> reordered{};
+    reordered.reserve(values.size());
+
+    for (const auto index : order)
+    {
+        reordered.emplace_back(std::move(values[index]));
+    }
+
+    values = std::move(reordered);
+}
+
+}
+
+namespace iris
+{
+
+TransformHierarchy::TransformHierarchy()
+    : local_()
+    , world_()
+    , normal_()
+    , parent_()
+    , subtree_size_()
+    , flags_()
+    , id_of_()
+    , position_of_()
+    , generation_()
+    , free_ids_()
+    , dirty_roots_()
+    , dirty_(false)
+{
+}
+
+TransformNode TransformHierarchy::create(const Transform &local, TransformNode parent)
+{
+    ensure(local_.size() < no_parent, "too many nodes");
+
+    auto parent_position = no_parent;
+    auto insert_position = static_cast<std::uint32_t>(local_.size());
+
+    // new node goes at the end of its parents subtree, to keep everything in depth-first order
+    if (parent != TransformNode{})
+    {
+        parent_position = position(parent);
+        insert_position = parent_position + subtree_size_[parent_position];
+    }
+
+    std::uint32_t id = 0u;
+    if (free_ids_.empty())
+    {
+        id = static_cast<std::uint32_t>(position_of_.size());
+        position_of_.emplace_back(insert_position);
+        generation_.emplace_back(0u);
+    }
+    else
+    {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+        position_of_[id] = insert_position;
+    }
+
+    local_.insert(std::next(std::begin(local_), insert_position), local);
+    world_.insert(std::next(std::begin(world_), insert_position), Matrix4{});
+    normal_.insert(std::next(std::begin(normal_), insert_position), Matrix4{});
+    parent_.insert(std::next(std::begin(parent_), insert_position), parent_position);
+    subtree_size_.insert(std::next(std::begin(subtree_size_), insert_position), 1u);
+    flags_.insert(std::next(std::begin(flags_), insert_position), std::uint8_t{0u});
+    id_of_.insert(std::next(std::begin(id_of_), insert_position), id);
+
+    // everything after the new node has moved up one
+    for (auto i = insert_position + 1u; i < local_.size(); ++i)
+    {
+        position_of_[id_of_[i]] = i;
+
+        if ((parent_[i] != no_parent) && (parent_[i] >= insert_position))
+        {
+            ++parent_[i];
+        }
+    }
+
+    for (auto ancestor = parent_position; ancestor != no_parent; ancestor = parent_[ancestor])
+    {
+        ++subtree_size_[ancestor];
+    }
+
+    mark_dirty(insert_position);
+
+    return {id, generation_[id]};
+}
+
+void TransformHierarchy::remove(TransformNode node)
+{
+    if (!contains(node))
+    {
+        return;
+    }
+
+    const auto removed = position(node);
+    const auto parent_position = parent_[removed];
+
+    for (auto ancestor = parent_position; ancestor != no_parent; ancestor = parent_[ancestor])
+    {
+        --subtree_size_[ancestor];
+    }
+
+    // children will have a new parent so need updating, store their positions after the erase
+    std::vector<std::uint32_t> children{};
+    for (auto child = removed + 1u; child < removed + subtree_size_[removed]; child += subtree_size_[child])
+    {
+        children.emplace_back(child - 1u);
+    }
+
+    local_.erase(std::next(std::begin(local_), removed));
+    world_.erase(std::next(std::begin(world_), removed));
+    normal_.erase(std::next(std::begin(normal_), removed));
+    parent_.erase(std::next(std::begin(parent_), removed));
+    subtree_size_.erase(std::next(std::begin(subtree_size_), removed));
+    flags_.erase(std::next(std::begin(flags_), removed));
+    id_of_.erase(std::next(std::begin(id_of_), removed));
+
+    // everything after the removed node has moved down one
+    for (auto i = removed; i < local_.size(); ++i)
+    {
+        position_of_[id_of_[i]] = i;
+
+        if (parent_[i] == removed)
+        {
+            parent_[i] = parent_position;
+        }
+        else if ((parent_[i] != no_parent) && (parent_[i] > removed))
+        {
+            --parent_[i];
+        }
+    }
+
+    ++generation_[node.id];
+    free_ids_.emplace_back(node.id);
+
+    for (const auto child : children)
+    {
+        mark_dirty(child);
+    }
+}
+
+bool TransformHierarchy::contains(TransformNode node) const
+{
+    return (node.id < generation_.size()) && (generation_[node.id] == node.generation);
+}
+
+TransformNode TransformHierarchy::parent(TransformNode node) const
+{
+    const auto parent_position = parent_[position(node)];
+
+    if (parent_position == no_parent)
+    {
+        return {};
+    }
+
+    const auto id = id_of_[parent_position];
+    return {id, generation_[id]};
+}
+
+void TransformHierarchy::set_parent(TransformNode node, TransformNode parent)
+{
+    const auto moved = position(node);
+    const auto count = subtree_size_[moved];
+
+    auto parent_position = no_parent;
+    auto insert_position = static_cast<std::uint32_t>(local_.size());
+
+    if (parent != TransformNode{})
+    {
+        parent_position = position(parent);
+        expect((parent_position < moved) || (parent_position >= moved + count), "cannot parent to self or descendant");
+
+        insert_position = parent_position + subtree_size_[parent_position];
+    }
+
+    for (auto ancestor = parent_[moved]; ancestor != no_parent; ancestor = parent_[ancestor])
+    {
+        subtree_size_[ancestor] -= count;
+    }
+
+    for (auto ancestor = parent_position; ancestor != no_parent; ancestor = parent_[ancestor])
+    {
+        subtree_size_[ancestor] += count;
+    }
+
+    parent_[moved] = parent_position;
+
+    // build the new order, which is the old order with the moved subtree cut out and inserted before insert_position
+    std::vector<std::uint32_t> order{};
+    order.reserve(local_.size());
+
+    const auto append_moved = [&order, moved, count]
+    {
+        for (auto i = moved; i < moved + count; ++i)
+        {
+            order.emplace_back(i);
+        }
+    };
+
+    for (auto i = 0u; i < local_.size(); ++i)
+    {
+        if (i == insert_position)
+        {
+            append_moved();
+        }
+
+        if ((i < moved) || (i >= moved + count))
+        {
+            order.emplace_back(i);
+        }
+    }
+
+    if (insert_position == local_.size())
+    {
+        append_moved();
+    }
+
+    reorder(order);
+
+    mark_dirty(position(node));
+}
+
+const Transform &TransformHierarchy::local(TransformNode node) const
+{
+    return local_[position(node)];
+}
+
+void TransformHierarchy::set_local(TransformNode node, const Transform &local)
+{
+    const auto node_position = position(node);
+
+    local_[node_position] = local;
+    mark_dirty(node_position);
+}
+
+Matrix4 TransformHierarchy::world(TransformNode node) const
+{
+    const auto node_position = position(node);
+
+    if (!is_stale(node_position))
+    {
+        return world_[node_position];
+    }
+
+    // find the highest dirty node, everything above it has a valid cached transform
+    auto top = node_position;
+    for (auto ancestor = node_position; ancestor != no_parent; ancestor = parent_[ancestor])
+    {
+        if ((flags_[ancestor] & dirty_flag) != 0u)
+        {
+            top = ancestor;
+        }
+    }
+
+    auto matrix = (parent_[top] == no_parent) ? local_[top].matrix() : world_[parent_[top]] * local_[top].matrix();
+
+    // multiply back down in the same order as update, so the result is identical, as nodes are in depth-first order the
+    // next node on the path is whichever child has node in its subtree
+    for (auto current = top; current != node_position;)
+    {
+        auto child = current + 1u;
+        while (node_position >= child + subtree_size_[child])
+        {
+            child += subtree_size_[child];
+        }
+
+        matrix = matrix * local_[child].matrix();
+        current = child;
+    }
+
+    return matrix;
+}
+
+Matrix4 TransformHierarchy::normal(TransformNode node) const
+{
+    const auto node_position = position(node);
+
+    return is_stale(node_position) ? Matrix4::make_normal_transform(world(node)) : normal_[node_position];
+}
+
+void TransformHierarchy::update()
+{
+    if (!dirty_)
+    {
+        return;
+    }
+
+    update_range(0u, local_.size());
+    dirty_ = false;
+}
+
+void TransformHierarchy::update(JobSystemManager &jobs_manager)
+{
+    if (!dirty_)
+    {
+        return;
+    }
+
+    // roots are independent so each dirty one can be updated concurrently
+    dirty_roots_.clear();
+    for (auto root = 0u; root < local_.size(); root += subtree_size_[root])
+    {
+        if ((flags_[root] & subtree_dirty_flag) != 0u)
+        {
+            dirty_roots_.emplace_back(root);
+        }
+    }
+
+    jobs_manager.parallel_for(
+        0u,
+        dirty_roots_.size(),
+        1u,
+        [this](std::size_t index)
+        {
+            const auto root = dirty_roots_[index];
+            update_range(root, root + subtree_size_[root]);
+        });
+
+    dirty_ = false;
+}
+
+bool TransformHierarchy::is_dirty() const
+{
+    return dirty_;
+}
+
+std::size_t TransformHierarchy::size() const
+{
+    return local_.size();
+}
+
+std::uint32_t TransformHierarchy::position(TransformNode node) const
+{
+    expect(contains(node), "node not in hierarchy");
+
+    return position_of_[node.id];
+}
+
+void TransformHierarchy::mark_dirty(std::uint32_t position)
+{
+    flags_[position] |= dirty_flag;
+
+    // once we find an ancestor already marked we can stop, as all its ancestors will be marked too
+    for (auto ancestor = position; ancestor != no_parent; ancestor = parent_[ancestor])
+    {
+        if ((ancestor != position) && ((flags_[ancestor] & subtree_dirty_flag) != 0u))
+        {
+            break;
+        }
+
+        flags_[ancestor] |= subtree_dirty_flag;
+    }
+
+    dirty_ = true;
+}
+
+bool TransformHierarchy::is_stale(std::uint32_t position) const
+{
+    for (auto ancestor = position; ancestor != no_parent; ancestor = parent_[ancestor])
+    {
+        if ((flags_[ancestor] & dirty_flag) != 0u)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TransformHierarchy::update_range(std::size_t begin, std::size_t end)
+{
+    auto i = begin;
+
+    while (i < end)
+    {
+        const auto parent_position = parent_[i];
+        const auto parent_changed = (parent_position != no_parent) && ((flags_[parent_position] & changed_flag) != 0u);
+
+        if (!parent_changed && ((flags_[i] & (dirty_flag | subtree_dirty_flag)) == 0u))
+        {
+            // nothing in this subtree has changed, so skip all of it
+            i += subtree_size_[i];
+            continue;
+        }
+
+        if (parent_changed || ((flags_[i] & dirty_flag) != 0u))
+        {
+            world_[i] = (parent_position == no_parent) ? local_[i].matrix()
+                                                       : world_[parent_position] * local_[i].matrix();
+            normal_[i] = Matrix4::make_normal_transform(world_[i]);
+            flags_[i] = changed_flag;
+        }
+        else
+        {
+            flags_[i] = 0u;
+        }
+
+        ++i;
+    }
+}
+
+void TransformHierarchy::reorder(const std::vector<std::uint32_t> &order)
+{
+    // parents are stored as positions, so map them to the new positions
+    std::vector<std::uint32_t> new_position(order.size());
+    for (auto i = 0u; i < order.size(); ++i)
+    {
+        new_position[order[i]] = i;
+    }
+
+    for (auto &parent_position : parent_)
+    {
+        if (parent_position != no_parent)
+        {
+            parent_position = new_position[parent_position];
+        }
+    }
+
+    gather(local_, order);
+    gather(world_, order);
+    gather(normal_, order);
+    gather(parent_, order);
+    gather(subtree_size_, order);
+    gather(flags_, order);
+    gather(id_of_, order);
+
+    for (auto i = 0u; i < id_of_.size(); ++i)
+    {
+        position_of_[id_of_[i]] = i;
+    }
+}
+
+}
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/mapped_file.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#include <Windows.h>
+
+#include "core/auto_release.h"
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+struct MappedFile::implementation
+{
+    std::byte *region;
+    std::size_t size;
+};
+
+MappedFile::MappedFile(const std::filesystem::path &path)
+    : impl_(std::make_unique<implementation>())
+{
+    impl_->region = nullptr;
+    impl_->size = 0u;
+
+    const auto file_handle = ::CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    ensure(file_handle != INVALID_HANDLE_VALUE, "failed to open file");
+
+    AutoRelease<HANDLE, nullptr> file{file_handle, ::CloseHandle};
+
+    ::LARGE_INTEGER size{};
+    ensure(::GetFileSizeEx(file, &size) != 0, "failed to get file size");
+
+    impl_->size = static_cast<std::size_t>(size.QuadPart);
+
+    // mapping zero bytes is an error, so leave empty files unmapped
+    if (impl_->size != 0u)
+    {
+        AutoRelease<HANDLE, nullptr> mapping{
+            ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL), ::CloseHandle};
+        ensure(mapping, "failed to create file mapping");
+
+        auto *region = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ensure(region != nullptr, "failed to map file");
+
+        impl_->region = static_cast<std::byte *>(region);
+    }
+
+    // the view keeps its own reference to the file, so both handles can be closed here
+}
+
+MappedFile::~MappedFile()
+{
+    if (impl_->region != nullptr)
+    {
+        ::UnmapViewOfFile(impl_->region);
+    }
+}
+
+std::span<const std::byte> MappedFile::data() const
+{
+    return {impl_->region, impl_->size};
+}
+
+std::size_t MappedFile::size() const
+{
+    return impl_->size;
+}
+
+}
@@ -47,4 +47,12 @@ void Semaphore::acquire()
     expect(wait != WAIT_FAILED, "could not acquire semaphore");
 }
 
+bool Semaphore::try_acquire()
+{
+    const auto wait = ::WaitForSingleObject(impl_->semaphore, 0u);
+    expect(wait != WAIT_FAILED, "could not acquire semaphore");
+
+    return wait == WAIT_OBJECT_0;
+}
+
 }
@@ -6,7 +6,11 @@
 
 #include "core/thread.h"
 
+#include <cstddef>
+#include <iterator>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <Windows.h>
 
@@ -42,4 +46,27 @@ void Thread::bind_to_core(std::size_t core)
     expect(::SetThreadAffinityMask(thread_.native_handle(), affinity_mask) != 0u, "could not bind thread to core");
 }
 
+void Thread::bind_to_cores(const std::vector<std::size_t> &cores)
+{
+    ensure(!cores.empty(), "must bind to at least one core");
+
+    DWORD_PTR affinity_mask = 0u;
+
+    for (const auto core : cores)
+    {
+        ensure(core < sizeof(DWORD_PTR) * 8u, "invalid core id");
+        affinity_mask |= (DWORD_PTR{1u} << core);
+    }
+
+    expect(::SetThreadAffinityMask(thread_.native_handle(), affinity_mask) != 0u, "could not bind thread to cores");
+}
+
+void Thread::set_name(const std::string &name)
+{
+    // thread names are expected to be ascii, so a simple widening is enough
+    const std::wstring wide_name(std::cbegin(name), std::cend(name));
+
+    expect(SUCCEEDED(::SetThreadDescription(thread_.native_handle(), wide_name.c_str())), "could not set thread name");
+}
+
 }
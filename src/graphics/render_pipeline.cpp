@@ -301,7 +301,15 @@ std::vector<RenderCommand> RenderPipeline::build()
 
 std::vector<RenderCommand> RenderPipeline::rebuild()
 {
-    std::vector<RenderCommand> render_queue;
+    std::vector<RenderCommand> render_queue{};
+    rebuild(render_queue);
+
+    return render_queue;
+}
+
+void RenderPipeline::rebuild(std::vector<RenderCommand> &render_queue)
+{
+    render_queue.clear();
     RenderCommand cmd{};
 
     // convert each pass into a series of commands which will render it
@@ -371,8 +379,6 @@ std::vector<RenderCommand> RenderPipeline::rebuild()
 
     cmd.set_type(RenderCommandType::PRESENT);
     render_queue.push_back(cmd);
-
-    return render_queue;
 }
 
 std::vector<RenderPass *> RenderPipeline::render_passes() const
@@ -390,6 +396,14 @@ void RenderPipeline::clear_dirty_bit()
     dirty_ = false;
 }
 
+void RenderPipeline::update_transforms()
+{
+    for (auto &scene : scenes_)
+    {
+        scene->update_transforms();
+    }
+}
+
 RenderPass *RenderPipeline::create_engine_render_pass(Scene *scene)
 {
     // using new to access private ctor
@@ -9,6 +9,7 @@
 #include <cassert>
 
 #include "core/exception.h"
+#include "core/frame_arena.h"
 #include "graphics/material_manager.h"
 
 namespace iris
@@ -27,10 +28,14 @@ void Renderer::render()
 {
     if (render_pipeline_->is_dirty())
     {
-        render_queue_ = render_pipeline_->rebuild();
+        // refill the existing queue rather than building a new one, so once warmed up a rebuild does not allocate
+        render_pipeline_->rebuild(render_queue_);
         render_pipeline_->clear_dirty_bit();
     }
 
+    // entities only mark their transforms as dirty when changed, so recompute them all once before drawing
+    render_pipeline_->update_transforms();
+
     pre_render();
 
     // update time
@@ -51,6 +56,9 @@ void Renderer::render()
     }
 
     post_render();
+
+    // this is the end of the frame, so anything allocated from frame arenas can now be reclaimed
+    advance_frame();
 }
 
 void Renderer::set_render_pipeline(std::unique_ptr<RenderPipeline> render_pipeline)
@@ -6,18 +6,26 @@
 
 #include "graphics/scene.h"
 
+#include <tuple>
 #include <vector>
 
 #include "core/colour.h"
 #include "core/error_handling.h"
+#include "core/slot_map.h"
+#include "core/transform_hierarchy.h"
 #include "graphics/lights/lighting_rig.h"
 #include "graphics/render_entity.h"
+#include "graphics/render_entity_type.h"
 #include "graphics/render_graph/render_graph.h"
+#include "graphics/single_entity.h"
 
 namespace iris
 {
 Scene::Scene(RenderGraph *default_render_graph, bool *dirty_pipeline)
     : entities_()
+    , entity_handles_()
+    , front_count_(0u)
+    , transforms_()
     , render_graphs_()
     , lighting_rig_()
     , default_render_graph_(default_render_graph)
@@ -36,9 +44,11 @@ RenderEntity *Scene::add(RenderGraph *render_graph, std::unique_ptr<RenderEntity
         entity->set_receive_shadow(false);
     }
 
-    entities_.emplace_back(render_graph, std::move(entity));
+    auto *ptr = entity.get();
+    entity_handles_[ptr] = entities_.emplace(render_graph, std::move(entity));
+    add_transform(ptr);
 
-    return std::get<1>(entities_.back()).get();
+    return ptr;
 }
 
 RenderEntity *Scene::add_at_front(RenderGraph *render_graph, std::unique_ptr<RenderEntity> entity)
@@ -51,21 +61,45 @@ RenderEntity *Scene::add_at_front(RenderGraph *render_graph, std::unique_ptr<Ren
         entity->set_receive_shadow(false);
     }
 
-    entities_.insert(std::begin(entities_), {render_graph, std::move(entity)});
+    auto *ptr = entity.get();
+    const auto handle = entities_.emplace(render_graph, std::move(entity));
+    entity_handles_[ptr] = handle;
+    add_transform(ptr);
 
-    return std::get<1>(entities_.front()).get();
+    // move the new entity to the end of the front entities
+    entities_.swap_positions(handle, entities_.handle(front_count_));
+    ++front_count_;
+
+    return ptr;
 }
 
 void Scene::remove(RenderEntity *entity)
 {
     *dirty_pipeline_ = true;
 
-    entities_.erase(
-        std::remove_if(
-            std::begin(entities_),
-            std::end(entities_),
-            [entity](const auto &e) { return std::get<1>(e).get() == entity; }),
-        std::end(entities_));
+    const auto found = entity_handles_.find(entity);
+    if (found == std::cend(entity_handles_))
+    {
+        return;
+    }
+
+    const auto handle = found->second;
+
+    if (entity->type() == RenderEntityType::SINGLE)
+    {
+        transforms_.remove(static_cast<SingleEntity *>(entity)->node_);
+    }
+
+    // if this is a front entity then first swap it to the end of the front entities, so erasing doesn't move a regular
+    // entity into the front
+    if (entities_.position(handle) < front_count_)
+    {
+        --front_count_;
+        entities_.swap_positions(handle, entities_.handle(front_count_));
+    }
+
+    entities_.erase(handle);
+    entity_handles_.erase(found);
 }
 
 PointLight *Scene::add(std::unique_ptr<PointLight> light)
@@ -98,21 +132,32 @@ void Scene::set_ambient_light(const Colour &colour)
 
 RenderGraph *Scene::render_graph(RenderEntity *entity) const
 {
-    auto found = std::find_if(std::cbegin(entities_), std::cend(entities_), [entity](const auto &element) {
-        return std::get<1>(element).get() == entity;
-    });
+    const auto found = entity_handles_.find(entity);
 
-    expect(found == std::cend(entities_), "entity not in scene");
+    expect(found != std::cend(entity_handles_), "entity not in scene");
 
-    return std::get<0>(*found);
+    return std::get<0>(entities_[found->second]);
 }
 
-std::vector<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &Scene::entities()
+void Scene::set_parent(SingleEntity *entity, SingleEntity *parent)
+{
+    expect(entity->hierarchy_ == &transforms_, "entity not in scene");
+    expect((parent == nullptr) || (parent->hierarchy_ == &transforms_), "parent not in scene");
+
+    transforms_.set_parent(entity->node_, (parent == nullptr) ? TransformNode{} : parent->node_);
+}
+
+void Scene::update_transforms()
+{
+    transforms_.update();
+}
+
+SlotMap<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &Scene::entities()
 {
     return entities_;
 }
 
-const std::vector<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &Scene::entities() const
+const SlotMap<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> &Scene::entities() const
 {
     return entities_;
 }
@@ -122,4 +167,18 @@ const LightingRig *Scene::lighting_rig() const
     return &lighting_rig_;
 }
 
+void Scene::add_transform(RenderEntity *entity)
+{
+    if (entity->type() != RenderEntityType::SINGLE)
+    {
+        return;
+    }
+
+    auto *single_entity = static_cast<SingleEntity *>(entity);
+    expect(single_entity->hierarchy_ == nullptr, "entity already in a scene");
+
+    single_entity->node_ = transforms_.create(single_entity->transform_);
+    single_entity->hierarchy_ = &transforms_;
+}
+
 }
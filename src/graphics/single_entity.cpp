@@ -14,38 +14,12 @@
 #include "core/matrix4.h"
 #include "core/quaternion.h"
 #include "core/transform.h"
+#include "core/transform_hierarchy.h"
 #include "core/vector3.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_entity_type.h"
 #include "graphics/skeleton.h"
 
-namespace
-{
-
-/**
- * Helper function to create a normal transformation matrix from a model
- * matrix.
- *
- * @param model
- *   The model matrix to calculate from.
- *
- * @returns
- *   Normal transformation matrix.
- */
-iris::Matrix4 create_normal_transform(const iris::Matrix4 &model)
-{
-    auto normal = iris::Matrix4::transpose(iris::Matrix4::invert(model));
-
-    // remove the translation components
-    normal[3] = 0.0f;
-    normal[7] = 0.0f;
-    normal[11] = 0.0f;
-
-    return normal;
-}
-
-}
-
 namespace iris
 {
 
@@ -76,12 +50,13 @@ SingleEntity::SingleEntity(
     : RenderEntity(mesh, primitive_type)
     , transform_(transform)
     , normal_()
+    , normal_dirty_(true)
+    , hierarchy_(nullptr)
+    , node_()
     , skeleton_(skeleton)
     , has_transparency_(has_transparency)
 {
     ensure(mesh != nullptr, "must supply mesh");
-
-    normal_ = create_normal_transform(transform_.matrix());
 }
 
 RenderEntityType SingleEntity::type() const
@@ -91,46 +66,48 @@ RenderEntityType SingleEntity::type() const
 
 Vector3 SingleEntity::position() const
 {
-    return transform_.translation();
+    return local_transform().translation();
 }
 
 void SingleEntity::set_position(const Vector3 &position)
 {
-    transform_.set_translation(position);
-    normal_ = create_normal_transform(transform_.matrix());
+    auto transform = local_transform();
+    transform.set_translation(position);
+    set_local_transform(transform);
 }
 
 Quaternion SingleEntity::orientation() const
 {
-    return transform_.rotation();
+    return local_transform().rotation();
 }
 
 void SingleEntity::set_orientation(const Quaternion &orientation)
 {
-    transform_.set_rotation(orientation);
-    normal_ = create_normal_transform(transform_.matrix());
+    auto transform = local_transform();
+    transform.set_rotation(orientation);
+    set_local_transform(transform);
 }
 
 Vector3 SingleEntity::scale() const
 {
-    return transform_.scale();
+    return local_transform().scale();
 }
 
 void SingleEntity::set_scale(const Vector3 &scale)
 {
-    transform_.set_scale(scale);
-    normal_ = create_normal_transform(transform_.matrix());
+    auto transform = local_transform();
+    transform.set_scale(scale);
+    set_local_transform(transform);
 }
 
 Matrix4 SingleEntity::transform() const
 {
-    return transform_.matrix();
+    return (hierarchy_ == nullptr) ? transform_.matrix() : hierarchy_->world(node_);
 }
 
 void SingleEntity::set_transform(const Matrix4 &transform)
 {
-    transform_.set_matrix(transform);
-    normal_ = create_normal_transform(transform_.matrix());
+    set_local_transform(Transform{transform});
 }
 
 void SingleEntity::set_transform(const Transform &transform)
@@ -140,6 +117,18 @@ void SingleEntity::set_transform(const Transform &transform)
 
 Matrix4 SingleEntity::normal_transform() const
 {
+    if (hierarchy_ != nullptr)
+    {
+        return hierarchy_->normal(node_);
+    }
+
+    // not in a hierarchy, so calculate on demand, this means multiple changes only cost one inversion
+    if (normal_dirty_)
+    {
+        normal_ = Matrix4::make_normal_transform(transform_.matrix());
+        normal_dirty_ = false;
+    }
+
     return normal_;
 }
 
@@ -163,4 +152,22 @@ bool SingleEntity::has_transparency() const
     return has_transparency_;
 }
 
+const Transform &SingleEntity::local_transform() const
+{
+    return (hierarchy_ == nullptr) ? transform_ : hierarchy_->local(node_);
+}
+
+void SingleEntity::set_local_transform(const Transform &transform)
+{
+    if (hierarchy_ == nullptr)
+    {
+        transform_ = transform;
+        normal_dirty_ = true;
+    }
+    else
+    {
+        hierarchy_->set_local(node_, transform);
+    }
+}
+
 }
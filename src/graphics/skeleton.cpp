@@ -8,12 +8,14 @@
 
 #include <cassert>
 #include <cstddef>
+#include <memory_resource>
 #include <queue>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "core/error_handling.h"
+#include "core/frame_arena.h"
 #include "core/matrix4.h"
 #include "graphics/animation/animation.h"
 #include "graphics/animation/bone_query.h"
@@ -53,7 +55,8 @@ void update_transforms(
     // them, this allows us to look up a parents transform
     // we don't want to update the actual bones transform as this causes issues
     // when we change animation
-    std::vector<iris::Matrix4> cache(transforms.size());
+    // this is only needed for this call, so comes from the frame arena
+    std::pmr::vector<iris::Matrix4> cache(transforms.size(), iris::frame_resource());
     transforms[0] = bones.front().transform();
 
     // walk remaining bones - these are in hierarchal order so we will always
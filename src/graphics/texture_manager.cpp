@@ -6,10 +6,12 @@
 
 #include "graphics/texture_manager.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -25,12 +27,14 @@
 #include "graphics/sampler.h"
 #include "graphics/texture.h"
 #include "graphics/texture_usage.h"
+#include "jobs/job_system_manager.h"
+#include "jobs/task.h"
 
 namespace
 {
 
 /**
- * Load an image from a data buffer.
+ * Load an image from its encoded bytes, e.g. a view of a loaded resource.
  *
  * @param data
  *   Image data.
@@ -39,7 +43,7 @@ namespace
  *   Tuple of <data, width, height, number of channels>.
  */
 std::tuple<iris::DataBuffer, std::uint32_t, std::uint32_t> parse_image(
-    const iris::DataBuffer &data,
+    std::span<const std::byte> data,
     bool flip_on_load = true)
 {
     int width = 0;
@@ -48,7 +52,8 @@ std::tuple<iris::DataBuffer, std::uint32_t, std::uint32_t> parse_image(
 
     // ensure that images are flipped along the y axis when loaded, this is so
     // they work with what the graphics api treats as the origin
-    ::stbi_set_flip_vertically_on_load(flip_on_load);
+    // images may be decoded on several threads at once, so only set the flag for this one
+    ::stbi_set_flip_vertically_on_load_thread(flip_on_load);
 
     // load image using stb library
     iris::AutoRelease<::stbi_uc *, nullptr> raw_data(
@@ -220,6 +225,48 @@ Texture *TextureManager::load(const std::string &resource, TextureUsage usage, c
     return loaded_textures_[resource].asset.get();
 }
 
+Task<Texture *> TextureManager::load_async(
+    std::string resource,
+    JobSystemManager &jobs_manager,
+    TextureUsage usage,
+    const Sampler *sampler)
+{
+    expect((usage == TextureUsage::IMAGE) || (usage == TextureUsage::DATA), "can only load IMAGE or DATA from file");
+
+    // the cache is only accessed from the main thread
+    co_await switch_to_main_thread(jobs_manager);
+
+    if (!loaded_textures_.contains(resource))
+    {
+        // resumes on an io thread, so move to a worker to decode
+        const auto file_data = co_await resource_manager_.load_async(resource);
+        co_await schedule_on(jobs_manager);
+
+        auto [data, width, height] = parse_image(file_data, true);
+
+        // textures can only be created on the main thread
+        co_await switch_to_main_thread(jobs_manager);
+
+        // another task may have loaded the texture whilst we were decoding
+        if (!loaded_textures_.contains(resource))
+        {
+            auto texture = do_create(
+                data,
+                width,
+                height,
+                sampler == nullptr ? default_texture_sampler() : sampler,
+                usage,
+                next_texture_index());
+
+            loaded_textures_[resource] = {1u, std::move(texture)};
+            co_return loaded_textures_[resource].asset.get();
+        }
+    }
+
+    ++loaded_textures_[resource].ref_count;
+    co_return loaded_textures_[resource].asset.get();
+}
+
 CubeMap *TextureManager::load(
     const std::string &right_resource,
     const std::string &left_resource,
@@ -7,36 +7,108 @@
 #include "jobs/fiber/counter.h"
 
 #include <atomic>
-#include <mutex>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include "core/error_handling.h"
+#include "jobs/fiber/fiber.h"
+
+namespace
+{
+
+/**
+ * Sentinel value for the head of the wait list, indicating the counter has reached zero and no more fibers can wait.
+ *
+ * @returns
+ *   Closed sentinel.
+ */
+iris::Fiber *closed()
+{
+    return reinterpret_cast<iris::Fiber *>(std::uintptr_t{1u});
+}
+
+}
 
 namespace iris
 {
 
 Counter::Counter(int value)
     : value_(value)
-    , mutex_()
+    , waiters_(value <= 0 ? closed() : nullptr)
+    , has_exception_(false)
+    , exception_(nullptr)
 {
 }
 
-Counter::operator int()
+Counter::operator int() const
 {
-    std::unique_lock lock(mutex_);
-
-    return value_;
+    return value_.load(std::memory_order_acquire);
 }
 
 void Counter::operator--()
 {
-    std::unique_lock lock(mutex_);
-
-    --value_;
+    [[maybe_unused]] const auto *waiters = decrement();
+    expect(waiters == nullptr, "fibers waiting on counter have been dropped");
 }
 
 void Counter::operator--(int)
 {
-    std::unique_lock lock(mutex_);
+    [[maybe_unused]] const auto *waiters = decrement();
+    expect(waiters == nullptr, "fibers waiting on counter have been dropped");
+}
+
+Fiber *Counter::decrement()
+{
+    Fiber *waiters = nullptr;
+
+    if (value_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // we dropped the counter to zero, close the list (so no new fibers can wait) and take ownership of everything
+        // currently waiting
+        waiters = waiters_.exchange(closed(), std::memory_order_acq_rel);
+    }
+
+    return waiters;
+}
+
+void Counter::increment(int count)
+{
+    [[maybe_unused]] const auto previous = value_.fetch_add(count, std::memory_order_relaxed);
+    expect(previous > 0, "cannot increment a counter that has reached zero");
+}
+
+bool Counter::add_waiter(Fiber *fiber)
+{
+    auto *head = waiters_.load(std::memory_order_acquire);
+
+    do
+    {
+        if (head == closed())
+        {
+            return false;
+        }
+
+        fiber->set_next_waiter(head);
+    } while (!waiters_.compare_exchange_weak(head, fiber, std::memory_order_release, std::memory_order_acquire));
 
-    --value_;
+    return true;
+}
+
+void Counter::set_exception(std::exception_ptr exception)
+{
+    auto expected = false;
+
+    // first one wins, the release of the following decrement publishes the write to the waiting fiber
+    if (has_exception_.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+    {
+        exception_ = std::move(exception);
+    }
+}
+
+std::exception_ptr Counter::exception() const
+{
+    return exception_;
 }
 
 }
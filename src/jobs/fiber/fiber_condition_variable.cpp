@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_condition_variable.h"
+
+#include <mutex>
+
+#include "core/error_handling.h"
+#include "jobs/fiber/fiber_mutex.h"
+#include "jobs/fiber/fiber_wait_list.h"
+
+namespace iris
+{
+
+FiberConditionVariable::FiberConditionVariable()
+    : waiters_()
+{
+}
+
+void FiberConditionVariable::wait(std::unique_lock<FiberMutex> &lock)
+{
+    expect(lock.owns_lock(), "must hold lock to wait");
+
+    FiberWaitList::Waiter waiter{};
+
+    // we must be on the wait list before releasing the mutex, otherwise a notify between the two would be missed
+    waiters_.lock();
+    waiters_.push(waiter);
+    waiters_.unlock();
+
+    lock.unlock();
+    waiter.block();
+    lock.lock();
+}
+
+void FiberConditionVariable::notify_one()
+{
+    waiters_.lock();
+    auto *waiter = waiters_.pop();
+    waiters_.unlock();
+
+    if (waiter != nullptr)
+    {
+        waiter->wake();
+    }
+}
+
+void FiberConditionVariable::notify_all()
+{
+    waiters_.lock();
+    auto *waiter = waiters_.pop_all();
+    waiters_.unlock();
+
+    while (waiter != nullptr)
+    {
+        // read next before waking, as once woken the waiter can return and be destroyed
+        auto *next = FiberWaitList::next(waiter);
+        waiter->wake();
+        waiter = next;
+    }
+}
+
+}
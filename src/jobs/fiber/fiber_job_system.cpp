@@ -6,114 +6,378 @@
 
 #include "jobs/fiber/fiber_job_system.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <sstream>
 #include <string>
-#include <tuple>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "core/auto_release.h"
+#include "core/error_handling.h"
+#include "core/exception.h"
+#include "core/frame_arena.h"
 #include "core/semaphore.h"
 #include "core/thread.h"
-#include "jobs/concurrent_queue.h"
+#include "jobs/chunk_function.h"
 #include "jobs/fiber/counter.h"
 #include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_pool.h"
+#include "jobs/fiber/worker_stats.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
+#include "jobs/job_system_config.h"
+#include "jobs/job_utils.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/work_stealing_queue.h"
 #include "log/log.h"
 
 namespace
 {
 
+/** Per-lane, per-worker queues (indexed [lane][worker]). */
+using WorkerQueues =
+    std::array<std::vector<std::unique_ptr<iris::WorkStealingQueue<iris::Fiber *>>>, iris::job_priority_count>;
+
+/** Per-lane shared queues. */
+using SharedQueues = std::array<iris::MpmcQueue<iris::Fiber *>, iris::job_priority_count>;
+
+/**
+ * Identifies the worker queues owned by the calling thread.
+ */
+struct WorkerContext
+{
+    /** Job system the worker belongs to, nullptr if not a worker. */
+    iris::FiberJobSystem *job_system;
+
+    /** Collection of queues the worker belongs to, nullptr if not a worker. */
+    const WorkerQueues *queues;
+
+    /** Index of the worker in queues. */
+    std::size_t index;
+};
+
+/**
+ * Get the worker context for the calling thread.
+ *
+ * Note that this must not be cached across a fiber suspend, as the fiber may be resumed on a different thread.
+ *
+ * @returns
+ *   Reference to thread local WorkerContext.
+ */
+WorkerContext &this_worker()
+{
+    thread_local WorkerContext worker{.job_system = nullptr, .queues = nullptr, .index = 0u};
+    return worker;
+}
+
+/**
+ * Simple xorshift random number generator, used for picking a victim to steal from. This is cheap enough to call in
+ * the scheduling hot path.
+ *
+ * @param state
+ *   Generator state, updated in place.
+ *
+ * @returns
+ *   Next random number.
+ */
+std::uint32_t next_random(std::uint32_t &state)
+{
+    state ^= state << 13u;
+    state ^= state >> 17u;
+    state ^= state << 5u;
+
+    return state;
+}
+
+/**
+ * Try and steal a fiber from another worker. Victims are visited in order starting from a random worker.
+ *
+ * @param id
+ *   Index of calling worker (which will not be stolen from).
+ *
+ * @param worker_queues
+ *   Queues of all workers for a single lane.
+ *
+ * @param random_state
+ *   State for random number generator.
+ *
+ * @param fiber
+ *   Reference to store stolen fiber.
+ *
+ * @returns
+ *   True if a fiber was stolen, otherwise false.
+ */
+bool try_steal(
+    std::size_t id,
+    const std::vector<std::unique_ptr<iris::WorkStealingQueue<iris::Fiber *>>> &worker_queues,
+    std::uint32_t &random_state,
+    iris::Fiber *&fiber)
+{
+    const auto worker_count = worker_queues.size();
+    const auto start = static_cast<std::size_t>(next_random(random_state)) % worker_count;
+
+    for (auto i = 0u; i < worker_count; ++i)
+    {
+        const auto victim = (start + i) % worker_count;
+
+        if ((victim != id) && worker_queues[victim]->steal(fiber))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Find a fiber to run, checking each lane in priority order. Within a lane our own queue is checked first (no
+ * contention), then the shared queue and finally we try and steal from another worker.
+ *
+ * @param id
+ *   Index of calling worker.
+ *
+ * @param worker_queues
+ *   Queues of all workers.
+ *
+ * @param fibers
+ *   Shared queues.
+ *
+ * @param random_state
+ *   State for random number generator.
+ *
+ * @param fiber
+ *   Reference to store found fiber.
+ *
+ * @param stolen
+ *   Reference to store whether the fiber was stolen from another worker.
+ *
+ * @returns
+ *   True if a fiber was found, otherwise false.
+ */
+bool find_fiber(
+    std::size_t id,
+    const WorkerQueues &worker_queues,
+    SharedQueues &fibers,
+    std::uint32_t &random_state,
+    iris::Fiber *&fiber,
+    bool &stolen)
+{
+    for (auto i = 0u; i < iris::job_priority_count; ++i)
+    {
+        if (worker_queues[i][id]->pop(fiber) || fibers[i].try_dequeue(fiber))
+        {
+            stolen = false;
+            return true;
+        }
+
+        if (try_steal(id, worker_queues[i], random_state, fiber))
+        {
+            stolen = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * This is the main function for the worker threads. It's responsible for
- * taking fibers off the queue, executing them and performing all necessary
+ * taking fibers off the queues, executing them and performing all necessary
  * bookkeeping.
  *
  * @param id
- *   Unique id for thread.
+ *   Unique id for thread, also the index of its queue in worker_queues.
+ *
+ * @param job_system
+ *   Job system the thread belongs to.
  *
  * @param jobs_semaphore
  *   Semaphore signaling how many fibers are available to run.
  *
+ * @param idle_policy
+ *   What to do before waiting on jobs_semaphore.
+ *
  * @param running
  *   Flag to indicate if this thread should keep running.
  *
+ * @param worker_queues
+ *   Per-lane, per-worker queues, the ones at index id are owned by this thread.
+ *
  * @param fibers
- *   Queue of fibers to pop from.e
+ *   Shared queues of fibers to pop from.
+ *
+ * @param fiber_pool
+ *   Pool to return finished fire-and-forget fibers to.
+ *
+ * @param counters
+ *   Counters for this worker.
+ *
+ * @param trace
+ *   Trace buffer for this worker.
+ *
+ * @param tracing
+ *   Flag to indicate if trace events should be recorded.
  */
 void job_thread(
-    [[maybe_unused]] int id,
+    std::size_t id,
+    iris::FiberJobSystem *job_system,
     iris::Semaphore &jobs_semaphore,
+    const std::atomic<iris::IdlePolicy> &idle_policy,
     std::atomic<bool> &running,
-    iris::ConcurrentQueue<std::tuple<iris::Fiber *, iris::Counter *>> &fibers)
+    const WorkerQueues &worker_queues,
+    SharedQueues &fibers,
+    iris::FiberPool &fiber_pool,
+    iris::WorkerCounters &counters,
+    iris::WorkerTrace &trace,
+    const std::atomic<bool> &tracing)
 {
     iris::Fiber::thread_to_fiber();
 
+    this_worker() = {.job_system = job_system, .queues = &worker_queues, .index = id};
+    auto random_state = static_cast<std::uint32_t>(id + 1u) * 2654435761u;
+
     LOG_DEBUG("job_system", "{} thread start [{}]", id, (void *)*iris::Fiber::this_fiber());
 
+    auto idle_start = std::chrono::steady_clock::now();
+
     while (running)
     {
-        // wait for jobs to become available
-        jobs_semaphore.acquire();
+        // wait for jobs to become available, spinning first (as set by the idle policy) so if work arrives shortly we
+        // don't pay for a trip into the kernel to sleep and be woken
+        const auto try_acquire = [&jobs_semaphore]() { return jobs_semaphore.try_acquire(); };
+        if (!iris::idle_wait(idle_policy.load(std::memory_order_relaxed), try_acquire))
+        {
+            jobs_semaphore.acquire();
+        }
 
         if (!running)
         {
             break;
         }
 
-        // block and wait for fiber from queue, this should be low contention
-        // as most of the waiting is handled by the semaphore
-        auto [fiber, wait_counter] = fibers.dequeue();
+        iris::Fiber *fiber = nullptr;
+        auto stolen = false;
+
+        // every semaphore release is paired with a fiber being put on a queue, so having acquired it we know there is
+        // at least one fiber for us somewhere, we may just lose a race for it so keep looking until we find it
+        while (!find_fiber(id, worker_queues, fibers, random_state, fiber, stolen))
+        {
+            iris::cpu_relax();
+        }
+
+        if (stolen)
+        {
+            counters.add_steal();
+        }
 
         // we cannot safely use a fiber whilst it is resuming
         // as a fiber should never be in the resuming state for long (the time
         // it takes to suspend and return to previous context) we use a
-        // primitive spin lock
-        while (!fiber->is_safe())
+        // primitive spin lock, backing off in case the suspending thread has
+        // been descheduled
+        iris::spin_until([fiber]() { return fiber->is_safe(); });
+
+        // if another fiber is waiting on this one then this is the counter it
+        // is waiting on, otherwise it was a fire-and-forget job
+        // this has to be read up front, as a fiber which suspends may be
+        // resumed (and finish) on another thread before we get it back
+        auto *counter = fiber->counter();
+
+        const auto busy_start = std::chrono::steady_clock::now();
+        counters.add_idle_time(busy_start - idle_start);
+        counters.add_queue_wait(busy_start - fiber->scheduled_at());
+
+        // a fiber on a queue is either new, or was suspended waiting on a
+        // counter which has now reached zero
+        const auto resumed = fiber->is_started();
+        const auto fiber_address = reinterpret_cast<std::uintptr_t>(fiber);
+        const auto finished = resumed ? fiber->resume() : fiber->start();
+
+        // a suspended fiber may already have been resumed by another worker, so from here we can only use it if it
+        // finished
+        idle_start = std::chrono::steady_clock::now();
+        counters.add_busy_time(idle_start - busy_start);
+
+        if (resumed)
         {
+            counters.add_resume();
         }
 
-        if (wait_counter == nullptr)
+        if (tracing.load(std::memory_order_relaxed))
         {
-            // if we have no wait counter then this is the first time we are
-            // seeing this fibre - so start it
-            fiber->start();
+            trace.record(
+                {.fiber = fiber_address,
+                 .begin = busy_start,
+                 .end = idle_start,
+                 .resumed = resumed,
+                 .suspended = !finished});
+        }
+
+        if (!finished)
+        {
+            counters.add_suspend();
         }
         else
         {
-            // if we have a wait counter then this is a suspended fiber thats
-            // been put back on the queue
+            counters.add_job_run();
+
+            // hand any exception to whoever is waiting, this has to happen
+            // before the fiber is recycled and before we decrement
+            if ((counter != nullptr) && fiber->exception())
+            {
+                counter->set_exception(fiber->exception());
+            }
 
-            if (*wait_counter == 0)
+            // nothing else references a finished fiber, so we can always
+            // recycle it here
+            fiber_pool.release(fiber);
+
+            if (counter != nullptr)
             {
-                // wait counter of zero means all its children jobs have
-                // finished so we can resume
-                fiber->resume();
+                // if we were the last job the waiting fibers are handed to us,
+                // so schedule them straight onto our own queues
+                auto *waiter = counter->decrement();
+                const auto now = std::chrono::steady_clock::now();
 
-                // if nothing is waiting on us then we were a fire-and-forget
-                // job so need to cleanup
-                if (!fiber->is_being_waited_on())
+                while (waiter != nullptr)
                 {
-                    delete fiber;
+                    // read next before we publish the fiber, as once it's on
+                    // the queue it can be resumed (and wait again)
+                    auto *next = waiter->next_waiter();
+
+                    waiter->set_scheduled_at(now);
+                    worker_queues[lane(waiter->priority())][id]->push(waiter);
+                    jobs_semaphore.release();
+
+                    waiter = next;
                 }
             }
-            else
-            {
-                // we are still waiting on at least one child job to finish so
-                // put the fiber back on the queue
-                fibers.enqueue(fiber, wait_counter);
-                jobs_semaphore.release();
-            }
         }
+
+        // we are back on the thread fiber, so no job is running on this thread and it's safe to reset our frame arena
+        // if the frame has moved on (a suspended fiber must not be holding arena memory, as it may resume elsewhere)
+        iris::reclaim_frame_arena();
     }
 
     LOG_DEBUG("job_system", "{} thread end [{}]", id, (void *)*iris::Fiber::this_fiber());
 
+    this_worker() = {.job_system = nullptr, .queues = nullptr, .index = 0u};
+
     // safe to cleanup fiber we created for thread
     delete *iris::Fiber::this_fiber();
     *iris::Fiber::this_fiber() = nullptr;
@@ -123,13 +387,17 @@ void job_thread(
  * If the main thread (which is not a fiber) wants to wait on a job then it
  * cannot. We bootstrap that by using traditional signaling primitives.
  *
- * @param jobs
- *   Jobs to wait on
+ * @param wait
+ *   Callable which waits on the jobs, will be called from within a fiber.
+ *
+ * @param priority
+ *   Lane to run wrapping job in.
  *
  * @param js
  *   Pointer to JoSystem.
  */
-void bootstrap_first_job(const std::vector<iris::Job> &jobs, iris::FiberJobSystem *js)
+template <class Wait>
+void bootstrap_first_job(const Wait &wait, iris::JobPriority priority, iris::FiberJobSystem *js)
 {
     std::mutex m;
     std::condition_variable cv;
@@ -137,30 +405,35 @@ void bootstrap_first_job(const std::vector<iris::Job> &jobs, iris::FiberJobSyste
     std::exception_ptr exception;
 
     // wrap everything up in a fire-and-forget job
-    js->add_jobs({{[&cv, &done, &jobs, &exception, js]()
-                   {
-                       LOG_ENGINE_INFO("job_system", "bootstrap started");
-
-                       try
-                       {
-                           // we can now call wait for jobs because we are
-                           // within another fiber
-                           js->wait_for_jobs(jobs);
-                       }
-                       catch (...)
-                       {
-                           // capture any exception
-                           exception = std::current_exception();
-                       }
-
-                       // signal calling thread we are finished
-                       done = true;
-                       cv.notify_one();
-                       LOG_ENGINE_INFO("job_system", "bootstrap lambda done");
-                   }}});
+    const auto job = [&m, &cv, &done, &wait, &exception]()
+    {
+        LOG_ENGINE_INFO("job_system", "bootstrap started");
+
+        try
+        {
+            // we can now wait because we are within another fiber
+            wait();
+        }
+        catch (...)
+        {
+            // capture any exception
+            exception = std::current_exception();
+        }
+
+        LOG_ENGINE_INFO("job_system", "bootstrap lambda done");
+
+        // signal calling thread we are finished, this is done under the lock
+        // as once the calling thread sees done it will destroy everything we
+        // reference
+        std::unique_lock lock(m);
+        done = true;
+        cv.notify_one();
+    };
+
+    std::array<iris::InlineJob, 1u> bootstrap{{job}};
+    js->add_jobs(bootstrap, priority);
 
     // block and wait for wrapping fiber to finish
-    if (!done)
     {
         std::unique_lock lock(m);
         cv.wait(lock, [&done]() { return done.load(); });
@@ -181,17 +454,75 @@ namespace iris
 {
 
 FiberJobSystem::FiberJobSystem()
+    : FiberJobSystem(JobSystemConfig{})
+{
+}
+
+FiberJobSystem::FiberJobSystem(std::uint32_t worker_count)
+    : FiberJobSystem(worker_count, 1024u)
+{
+}
+
+FiberJobSystem::FiberJobSystem(std::uint32_t worker_count, std::size_t fiber_pool_size)
+    : FiberJobSystem(fixed_worker_config(worker_count), fiber_pool_size)
+{
+}
+
+FiberJobSystem::FiberJobSystem(const JobSystemConfig &config)
+    : FiberJobSystem(config, 1024u)
+{
+}
+
+FiberJobSystem::FiberJobSystem(const JobSystemConfig &config, std::size_t fiber_pool_size)
     : running_(true)
     , jobs_semaphore_()
+    , idle_policy_(IdlePolicy::balanced())
+    , fiber_pool_(fiber_pool_size)
+    , worker_layout_(resolve_worker_layout(config, std::max(1u, std::thread::hardware_concurrency())))
     , workers_()
+    , worker_queues_()
     , fibers_()
+    , main_thread_jobs_()
+    , worker_counters_()
+    , worker_traces_()
+    , tracing_(false)
+    , trace_start_()
 {
-    auto thread_count = std::max(1u, std::thread::hardware_concurrency() - 1u);
+    const auto worker_count = static_cast<std::uint32_t>(worker_layout_.size());
+
+    for (auto i = 0u; i < worker_count; ++i)
+    {
+        worker_counters_.emplace_back(std::make_unique<WorkerCounters>());
+        worker_traces_.emplace_back(std::make_unique<WorkerTrace>());
+    }
+
+    // create all queues before starting any threads, as workers will steal from each other
+    for (auto &lane_queues : worker_queues_)
+    {
+        for (auto i = 0u; i < worker_count; ++i)
+        {
+            lane_queues.emplace_back(std::make_unique<WorkStealingQueue<Fiber *>>());
+        }
+    }
 
-    LOG_ENGINE_INFO("job_system", "creating {} threads", thread_count);
-    for (auto i = 0u; i < thread_count; ++i)
+    LOG_ENGINE_INFO("job_system", "creating {} threads", worker_count);
+    for (auto i = 0u; i < worker_count; ++i)
     {
-        workers_.emplace_back(job_thread, i + 1, std::ref(jobs_semaphore_), std::ref(running_), std::ref(fibers_));
+        workers_.emplace_back(
+            job_thread,
+            std::size_t{i},
+            this,
+            std::ref(jobs_semaphore_),
+            std::cref(idle_policy_),
+            std::ref(running_),
+            std::cref(worker_queues_),
+            std::ref(fibers_),
+            std::ref(fiber_pool_),
+            std::ref(*worker_counters_[i]),
+            std::ref(*worker_traces_[i]),
+            std::cref(tracing_));
+
+        apply_layout(workers_.back(), worker_layout_[i], i);
     }
 }
 
@@ -212,66 +543,295 @@ FiberJobSystem::~FiberJobSystem()
 
 void FiberJobSystem::add_jobs(const std::vector<Job> &jobs)
 {
-    for (const auto &job : jobs)
+    add_jobs_impl(jobs, JobPriority::NORMAL);
+}
+
+void FiberJobSystem::add_jobs(std::span<InlineJob> jobs)
+{
+    add_jobs_impl(jobs, JobPriority::NORMAL);
+}
+
+void FiberJobSystem::add_jobs(std::span<InlineJob> jobs, JobPriority priority)
+{
+    add_jobs_impl(jobs, priority);
+}
+
+void FiberJobSystem::wait_for_jobs(const std::vector<Job> &jobs)
+{
+    wait_for_jobs_impl(jobs, JobPriority::NORMAL);
+}
+
+void FiberJobSystem::wait_for_jobs(std::span<InlineJob> jobs)
+{
+    wait_for_jobs_impl(jobs, JobPriority::NORMAL);
+}
+
+void FiberJobSystem::wait_for_jobs(std::span<InlineJob> jobs, JobPriority priority)
+{
+    wait_for_jobs_impl(jobs, priority);
+}
+
+void FiberJobSystem::add_continuation_jobs(std::span<InlineJob> jobs)
+{
+    auto *current_fiber = *Fiber::this_fiber();
+    auto *counter = (current_fiber != nullptr) ? current_fiber->counter() : nullptr;
+
+    if (counter == nullptr)
     {
-        // we rely on the worker thread to clean up after us
-        auto *f = new Fiber{job};
+        add_jobs_impl(jobs, JobPriority::NORMAL);
+        return;
+    }
 
-        fibers_.enqueue(f, nullptr);
-        jobs_semaphore_.release();
+    // the current fiber has not yet decremented the counter, so it cannot have reached zero and we can safely extend
+    // it with the new jobs
+    counter->increment(static_cast<int>(jobs.size()));
+
+    const auto priority = current_fiber->priority();
+    auto *queue = local_queue(priority);
+
+    for (auto &job : jobs)
+    {
+        auto *fiber = fiber_pool_.acquire(take_job(job), counter);
+        fiber->set_priority(priority);
+
+        schedule(fiber, queue);
     }
 }
 
-void FiberJobSystem::wait_for_jobs(const std::vector<Job> &jobs)
+void FiberJobSystem::add_main_thread_jobs(const std::vector<Job> &jobs)
+{
+    main_thread_jobs_.enqueue(jobs);
+}
+
+void FiberJobSystem::add_main_thread_jobs(std::span<InlineJob> jobs)
+{
+    main_thread_jobs_.enqueue(jobs);
+}
+
+std::size_t FiberJobSystem::run_main_thread_jobs()
+{
+    return main_thread_jobs_.run();
+}
+
+JobQueueDepths FiberJobSystem::queue_depths() const
+{
+    std::array<std::size_t, job_priority_count> depths{};
+
+    for (auto i = 0u; i < job_priority_count; ++i)
+    {
+        depths[i] = fibers_[i].size();
+
+        for (const auto &queue : worker_queues_[i])
+        {
+            depths[i] += queue->size();
+        }
+    }
+
+    return {
+        .high = depths[lane(JobPriority::HIGH)],
+        .normal = depths[lane(JobPriority::NORMAL)],
+        .background = depths[lane(JobPriority::BACKGROUND)],
+        .main_thread = main_thread_jobs_.size()};
+}
+
+void FiberJobSystem::set_idle_policy(const IdlePolicy &policy)
+{
+    idle_policy_.store(policy, std::memory_order_relaxed);
+}
+
+IdlePolicy FiberJobSystem::idle_policy() const
+{
+    return idle_policy_.load(std::memory_order_relaxed);
+}
+
+void FiberJobSystem::run_chunks(std::size_t chunk_count, ChunkFunction function)
+{
+    if (chunk_count != 0u)
+    {
+        run_chunk_range(0u, chunk_count, function);
+    }
+}
+
+std::uint32_t FiberJobSystem::worker_count() const
+{
+    return static_cast<std::uint32_t>(workers_.size());
+}
+
+std::vector<WorkerLayout> FiberJobSystem::worker_layout() const
+{
+    return worker_layout_;
+}
+
+FiberPoolStats FiberJobSystem::fiber_pool_stats() const
+{
+    return fiber_pool_.stats();
+}
+
+std::vector<WorkerStats> FiberJobSystem::worker_stats() const
+{
+    std::vector<WorkerStats> stats{};
+    stats.reserve(worker_counters_.size());
+
+    for (const auto &counters : worker_counters_)
+    {
+        stats.emplace_back(counters->snapshot());
+    }
+
+    return stats;
+}
+
+void FiberJobSystem::start_trace()
+{
+    tracing_ = false;
+
+    for (auto &trace : worker_traces_)
+    {
+        trace->clear();
+    }
+
+    trace_start_ = std::chrono::steady_clock::now();
+    tracing_ = true;
+}
+
+void FiberJobSystem::stop_trace()
+{
+    tracing_ = false;
+}
+
+FiberJobSystem *FiberJobSystem::current()
+{
+    return this_worker().job_system;
+}
+
+void FiberJobSystem::reschedule(Fiber *fiber)
+{
+    schedule(fiber, local_queue(fiber->priority()));
+}
+
+std::string FiberJobSystem::chrome_trace() const
+{
+    std::vector<std::vector<JobTraceEvent>> events{};
+
+    for (const auto &trace : worker_traces_)
+    {
+        events.emplace_back(trace->events());
+    }
+
+    return to_chrome_trace(events, trace_start_);
+}
+
+template <class Jobs>
+void FiberJobSystem::add_jobs_impl(Jobs &jobs, JobPriority priority)
+{
+    auto *queue = local_queue(priority);
+
+    for (auto &job : jobs)
+    {
+        // we rely on the worker thread to return the fiber to the pool
+        auto *fiber = fiber_pool_.acquire(take_job(job));
+        fiber->set_priority(priority);
+
+        schedule(fiber, queue);
+    }
+}
+
+template <class Jobs>
+void FiberJobSystem::wait_for_jobs_impl(Jobs &jobs, JobPriority priority)
 {
     if (*Fiber::this_fiber() == nullptr)
     {
-        bootstrap_first_job(jobs, this);
+        bootstrap_first_job([this, &jobs, priority]() { wait_for_jobs_impl(jobs, priority); }, priority, this);
     }
     else
     {
-        auto counter = std::make_unique<Counter>(static_cast<int>(jobs.size()));
-        std::vector<std::unique_ptr<Fiber>> fibers{};
+        // this lives on our stack, which is kept alive whilst we are suspended
+        Counter counter{static_cast<int>(std::size(jobs))};
 
-        // create fibers and add to the queue
-        for (const auto &job : jobs)
+        // we are running in a fiber, so if it's one of our workers we can push straight onto its queue
+        // this must be looked up before we suspend, as we may be resumed on a different thread
+        auto *queue = local_queue(priority);
+
+        // create fibers and add to the queue, workers recycle them when they finish so we don't need to keep hold of
+        // them
+        for (auto &job : jobs)
         {
-            fibers.emplace_back(std::make_unique<Fiber>(job, counter.get()));
+            auto *fiber = fiber_pool_.acquire(take_job(job), &counter);
+            fiber->set_priority(priority);
 
-            fibers_.enqueue(fibers.back().get(), nullptr);
-            jobs_semaphore_.release();
+            schedule(fiber, queue);
         }
 
-        // mark current fiber as unsafe (so another thread doesn't preemptively
-        // try to resume it), stick it on the queue
-        (*Fiber::this_fiber())->set_unsafe();
-        fibers_.enqueue(*Fiber::this_fiber(), counter.get());
-        jobs_semaphore_.release();
-
-        // suspend current thread - this will internally mark the fiber as safe
-        (*Fiber::this_fiber())->suspend();
+        auto *current_fiber = *Fiber::this_fiber();
 
-        // the above line will not return
-        // if we get there then all children jobs have finished and resume has
-        // been called
+        // mark current fiber as unsafe (so another thread doesn't preemptively
+        // try to resume it) and add it to the counters wait list, whichever
+        // worker finishes the last job will reschedule us
+        current_fiber->set_unsafe();
 
-        std::exception_ptr job_exception;
+        if (counter.add_waiter(current_fiber))
+        {
+            // suspend current thread - this will internally mark the fiber as
+            // safe
+            current_fiber->suspend();
 
-        for (const auto &fiber : fibers)
+            // the above line will not return
+            // if we get there then all children jobs have finished and resume
+            // has been called
+        }
+        else
         {
-            // find first exception that was throw, first come first served
-            if ((fiber->exception() != nullptr) && !job_exception)
-            {
-                job_exception = fiber->exception();
-                break;
-            }
+            // all jobs finished before we could wait, so carry on
+            current_fiber->set_safe();
         }
 
-        if (job_exception)
+        // rethrow the first exception any child threw
+        if (const auto job_exception = counter.exception(); job_exception)
         {
             std::rethrow_exception(job_exception);
         }
     }
 }
 
+void FiberJobSystem::run_chunk_range(std::size_t first, std::size_t last, ChunkFunction function)
+{
+    if ((last - first) == 1u)
+    {
+        function(first);
+        return;
+    }
+
+    // split in half and wait on both, each half is pushed to our queue so an idle worker can steal the whole half and
+    // split it further itself
+    const auto middle = first + ((last - first) / 2u);
+
+    std::array<InlineJob, 2u> halves{
+        {[this, first, middle, function]() { run_chunk_range(first, middle, function); },
+         [this, middle, last, function]() { run_chunk_range(middle, last, function); }}};
+
+    wait_for_jobs(halves);
+}
+
+WorkStealingQueue<Fiber *> *FiberJobSystem::local_queue(JobPriority priority) const
+{
+    const auto &worker = this_worker();
+
+    return (worker.queues == &worker_queues_) ? worker_queues_[lane(priority)][worker.index].get() : nullptr;
+}
+
+void FiberJobSystem::schedule(Fiber *fiber, WorkStealingQueue<Fiber *> *local_queue)
+{
+    fiber->set_scheduled_at(std::chrono::steady_clock::now());
+
+    if (local_queue != nullptr)
+    {
+        local_queue->push(fiber);
+    }
+    else
+    {
+        fibers_[lane(fiber->priority())].enqueue(fiber);
+    }
+
+    jobs_semaphore_.release();
+}
+
 }
@@ -6,22 +6,36 @@
 
 #include "jobs/fiber/fiber_job_system_manager.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "core/error_handling.h"
+#include "jobs/chunk_function.h"
 #include "jobs/fiber/fiber_job_system.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
+#include "jobs/job_system_config.h"
 #include "jobs/job_system_manager.h"
 
 namespace iris
 {
 
 JobSystem *FiberJobSystemManager::create_job_system()
+{
+    return create_job_system(JobSystemConfig{});
+}
+
+JobSystem *FiberJobSystemManager::create_job_system(const JobSystemConfig &config)
 {
     ensure(!job_system_, "job system already created");
 
-    job_system_ = std::make_unique<FiberJobSystem>();
+    job_system_ = std::make_unique<FiberJobSystem>(config);
     return job_system_.get();
 }
 
@@ -30,8 +44,79 @@ void FiberJobSystemManager::add(const std::vector<Job> &jobs)
     job_system_->add_jobs(jobs);
 }
 
+void FiberJobSystemManager::add(std::span<InlineJob> jobs)
+{
+    job_system_->add_jobs(jobs);
+}
+
 void FiberJobSystemManager::wait(const std::vector<Job> &jobs)
 {
     job_system_->wait_for_jobs(jobs);
 }
+
+void FiberJobSystemManager::wait(std::span<InlineJob> jobs)
+{
+    job_system_->wait_for_jobs(jobs);
+}
+
+void FiberJobSystemManager::add(std::span<InlineJob> jobs, JobPriority priority)
+{
+    job_system_->add_jobs(jobs, priority);
+}
+
+void FiberJobSystemManager::wait(std::span<InlineJob> jobs, JobPriority priority)
+{
+    job_system_->wait_for_jobs(jobs, priority);
+}
+
+void FiberJobSystemManager::add_continuation(std::span<InlineJob> jobs)
+{
+    job_system_->add_continuation_jobs(jobs);
+}
+
+void FiberJobSystemManager::add_main_thread(const std::vector<Job> &jobs)
+{
+    job_system_->add_main_thread_jobs(jobs);
+}
+
+void FiberJobSystemManager::add_main_thread(std::span<InlineJob> jobs)
+{
+    job_system_->add_main_thread_jobs(jobs);
+}
+
+std::size_t FiberJobSystemManager::run_main_thread_jobs()
+{
+    return job_system_->run_main_thread_jobs();
+}
+
+JobQueueDepths FiberJobSystemManager::queue_depths() const
+{
+    return job_system_->queue_depths();
+}
+
+void FiberJobSystemManager::set_idle_policy(const IdlePolicy &policy)
+{
+    job_system_->set_idle_policy(policy);
+}
+
+IdlePolicy FiberJobSystemManager::idle_policy() const
+{
+    return job_system_->idle_policy();
+}
+
+void FiberJobSystemManager::run_chunks(std::size_t chunk_count, ChunkFunction function)
+{
+    job_system_->run_chunks(chunk_count, function);
+}
+
+std::uint32_t FiberJobSystemManager::worker_count() const
+{
+    return job_system_->worker_count();
+}
+
+std::vector<WorkerLayout> FiberJobSystemManager::worker_layout() const
+{
+    return job_system_->worker_layout();
+}
+
 }
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_mutex.h"
+
+#include <atomic>
+
+#include "jobs/fiber/fiber_wait_list.h"
+
+namespace iris
+{
+
+FiberMutex::FiberMutex()
+    : locked_(false)
+    , waiters_()
+{
+}
+
+void FiberMutex::lock()
+{
+    if (try_lock())
+    {
+        return;
+    }
+
+    FiberWaitList::Waiter waiter{};
+
+    waiters_.lock();
+
+    // unlock() only clears the flag with the wait list locked, so if we fail here we are guaranteed to be woken
+    if (try_lock())
+    {
+        waiters_.unlock();
+        return;
+    }
+
+    waiters_.push(waiter);
+    waiters_.unlock();
+
+    // when we are woken the mutex has been handed to us, so we don't need to try and lock it again
+    waiter.block();
+}
+
+bool FiberMutex::try_lock()
+{
+    auto expected = false;
+    return locked_.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+void FiberMutex::unlock()
+{
+    waiters_.lock();
+
+    auto *waiter = waiters_.pop();
+
+    if (waiter == nullptr)
+    {
+        locked_.store(false, std::memory_order_release);
+    }
+
+    waiters_.unlock();
+
+    // if there is a waiter we leave the mutex locked, handing ownership straight to it
+    if (waiter != nullptr)
+    {
+        waiter->wake();
+    }
+}
+
+}
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "jobs/fiber/counter.h"
+#include "jobs/fiber/fiber.h"
+#include "jobs/inline_job.h"
+
+namespace
+{
+
+/** Index used to mark the end of a stack. */
+constexpr auto empty_index = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * Pack an index and tag into a stack head, the tag changes on every update to prevent ABA.
+ *
+ * @param index
+ *   Index of slot at the top of the stack.
+ *
+ * @param tag
+ *   Tag for this version of the head.
+ *
+ * @returns
+ *   Packed head.
+ */
+constexpr std::uint64_t make_head(std::uint32_t index, std::uint32_t tag)
+{
+    return (static_cast<std::uint64_t>(tag) << 32u) | index;
+}
+
+/**
+ * Pop a slot off a stack.
+ *
+ * @param head
+ *   Head of stack.
+ *
+ * @param next
+ *   Next slot array for stack.
+ *
+ * @returns
+ *   Index of popped slot, or empty_index if the stack was empty.
+ */
+std::uint32_t pop(std::atomic<std::uint64_t> &head, std::atomic<std::uint32_t> *next)
+{
+    auto current = head.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const auto index = static_cast<std::uint32_t>(current);
+        if (index == empty_index)
+        {
+            return empty_index;
+        }
+
+        // may be stale if another thread pops this slot first, but then the tag will have changed and the CAS fails
+        const auto next_index = next[index].load(std::memory_order_relaxed);
+
+        if (head.compare_exchange_weak(
+                current,
+                make_head(next_index, static_cast<std::uint32_t>(current >> 32u) + 1u),
+                std::memory_order_acquire,
+                std::memory_order_acquire))
+        {
+            return index;
+        }
+    }
+}
+
+/**
+ * Push a slot onto a stack.
+ *
+ * @param head
+ *   Head of stack.
+ *
+ * @param next
+ *   Next slot array for stack.
+ *
+ * @param index
+ *   Index of slot to push.
+ */
+void push(std::atomic<std::uint64_t> &head, std::atomic<std::uint32_t> *next, std::uint32_t index)
+{
+    auto current = head.load(std::memory_order_relaxed);
+
+    // release so whoever pops this slot sees what we wrote to it
+    do
+    {
+        next[index].store(static_cast<std::uint32_t>(current), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(
+        current,
+        make_head(index, static_cast<std::uint32_t>(current >> 32u) + 1u),
+        std::memory_order_release,
+        std::memory_order_relaxed));
+}
+
+}
+
+namespace iris
+{
+
+FiberPool::FiberPool(std::size_t max_pooled)
+    : FiberPool(max_pooled, {Fiber::default_stack_size})
+{
+}
+
+FiberPool::FiberPool(std::size_t max_pooled, std::vector<std::size_t> stack_sizes)
+    : max_pooled_(max_pooled)
+    , size_classes_()
+    , hits_(0u)
+    , misses_(0u)
+    , live_(0u)
+    , peak_live_(0u)
+{
+    ensure(!stack_sizes.empty(), "must have at least one stack size class");
+    ensure(max_pooled_ < empty_index, "too many pooled fibers");
+
+    std::sort(std::begin(stack_sizes), std::end(stack_sizes));
+    stack_sizes.erase(std::unique(std::begin(stack_sizes), std::end(stack_sizes)), std::end(stack_sizes));
+
+    for (const auto stack_size : stack_sizes)
+    {
+        auto size_class = std::make_unique<SizeClass>();
+        size_class->stack_size = stack_size;
+        size_class->fibers = std::make_unique<Fiber *[]>(max_pooled_);
+        size_class->next = std::make_unique<std::atomic<std::uint32_t>[]>(max_pooled_);
+        size_class->pooled = make_head(empty_index, 0u);
+
+        // all slots start empty, wire them up so each points to the one after it
+        const auto slot_count = static_cast<std::uint32_t>(max_pooled_);
+        for (auto i = 0u; i < slot_count; ++i)
+        {
+            size_class->next[i] = (i + 1u == slot_count) ? empty_index : i + 1u;
+        }
+
+        size_class->empty = make_head((slot_count == 0u) ? empty_index : 0u, 0u);
+
+        size_classes_.emplace_back(std::move(size_class));
+    }
+}
+
+FiberPool::~FiberPool()
+{
+    for (auto &size_class : size_classes_)
+    {
+        for (auto index = pop(size_class->pooled, size_class->next.get()); index != empty_index;
+             index = pop(size_class->pooled, size_class->next.get()))
+        {
+            delete size_class->fibers[index];
+        }
+    }
+}
+
+Fiber *FiberPool::acquire(InlineJob job, Counter *counter, std::size_t stack_size)
+{
+    auto &pooled = size_class(stack_size);
+    Fiber *fiber = nullptr;
+
+    if (const auto index = pop(pooled.pooled, pooled.next.get()); index != empty_index)
+    {
+        fiber = std::exchange(pooled.fibers[index], nullptr);
+        push(pooled.empty, pooled.next.get(), index);
+    }
+
+    if (fiber != nullptr)
+    {
+        fiber->reset(std::move(job), counter);
+        hits_.fetch_add(1u, std::memory_order_relaxed);
+    }
+    else
+    {
+        fiber = new Fiber{std::move(job), counter, pooled.stack_size};
+        misses_.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    // update high water mark
+    const auto live = live_.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    auto peak_live = peak_live_.load(std::memory_order_relaxed);
+    while ((live > peak_live) && !peak_live_.compare_exchange_weak(peak_live, live, std::memory_order_relaxed))
+    {
+    }
+
+    return fiber;
+}
+
+void FiberPool::release(Fiber *fiber)
+{
+    live_.fetch_sub(1u, std::memory_order_relaxed);
+
+    // drop the job now, so anything it captured is released as soon as possible
+    fiber->reset(nullptr, nullptr);
+
+    auto &pooled = size_class(fiber->stack_size());
+
+    if (const auto index = pop(pooled.empty, pooled.next.get()); index != empty_index)
+    {
+        pooled.fibers[index] = fiber;
+        push(pooled.pooled, pooled.next.get(), index);
+    }
+    else
+    {
+        // pool was full
+        delete fiber;
+    }
+}
+
+FiberPoolStats FiberPool::stats() const
+{
+    return {
+        .hits = hits_.load(std::memory_order_relaxed),
+        .misses = misses_.load(std::memory_order_relaxed),
+        .live = live_.load(std::memory_order_relaxed),
+        .peak_live = peak_live_.load(std::memory_order_relaxed)};
+}
+
+FiberPool::SizeClass &FiberPool::size_class(std::size_t stack_size)
+{
+    const auto size_class = std::find_if(
+        std::cbegin(size_classes_),
+        std::cend(size_classes_),
+        [stack_size](const auto &element) { return element->stack_size >= stack_size; });
+
+    ensure(size_class != std::cend(size_classes_), "stack size too large for pool");
+
+    return **size_class;
+}
+
+}
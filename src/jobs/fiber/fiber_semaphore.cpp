@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_semaphore.h"
+
+#include <cstddef>
+
+#include "core/error_handling.h"
+#include "jobs/fiber/fiber_wait_list.h"
+
+namespace iris
+{
+
+FiberSemaphore::FiberSemaphore(std::ptrdiff_t initial)
+    : count_(initial)
+    , waiters_()
+{
+    ensure(initial >= 0, "initial count cannot be negative");
+}
+
+void FiberSemaphore::release(std::ptrdiff_t count)
+{
+    expect(count >= 0, "release count cannot be negative");
+
+    waiters_.lock();
+
+    // hand permits straight to waiters, anything left over goes back in the pool
+    auto *waiter = waiters_.pop(static_cast<std::size_t>(count));
+
+    for (auto *woken = waiter; woken != nullptr; woken = FiberWaitList::next(woken))
+    {
+        --count;
+    }
+
+    count_ += count;
+
+    waiters_.unlock();
+
+    while (waiter != nullptr)
+    {
+        // read next before waking, as once woken the waiter can return and be destroyed
+        auto *next = FiberWaitList::next(waiter);
+        waiter->wake();
+        waiter = next;
+    }
+}
+
+void FiberSemaphore::acquire()
+{
+    FiberWaitList::Waiter waiter{};
+
+    waiters_.lock();
+
+    if (count_ > 0)
+    {
+        --count_;
+        waiters_.unlock();
+        return;
+    }
+
+    waiters_.push(waiter);
+    waiters_.unlock();
+
+    // when we are woken a permit has been handed to us
+    waiter.block();
+}
+
+bool FiberSemaphore::try_acquire()
+{
+    waiters_.lock();
+
+    const auto acquired = count_ > 0;
+    if (acquired)
+    {
+        --count_;
+    }
+
+    waiters_.unlock();
+
+    return acquired;
+}
+
+}
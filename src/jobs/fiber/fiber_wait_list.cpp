@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_wait_list.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+#include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/idle_policy.h"
+
+namespace iris
+{
+
+FiberWaitList::Waiter::Waiter()
+    : fiber_(nullptr)
+    , job_system_(FiberJobSystem::current())
+    , next_(nullptr)
+    , woken_(false)
+    , mutex_()
+    , condition_()
+{
+    // we can only suspend if we are a fiber running on a job system worker, anything else blocks the thread
+    if (job_system_ != nullptr)
+    {
+        fiber_ = *Fiber::this_fiber();
+    }
+}
+
+void FiberWaitList::Waiter::block()
+{
+    if (fiber_ != nullptr)
+    {
+        // push() marked us as unsafe, suspending will mark us as safe again (once we have fully switched away) so any
+        // worker that picks us up after a wake() will wait until then before resuming us
+        fiber_->suspend();
+    }
+    else
+    {
+        std::unique_lock lock(mutex_);
+        condition_.wait(lock, [this]() { return woken_; });
+    }
+}
+
+void FiberWaitList::Waiter::wake()
+{
+    if (fiber_ != nullptr)
+    {
+        job_system_->reschedule(fiber_);
+    }
+    else
+    {
+        // notify under the lock, as once the waiter sees woken_ it will return and destroy this object
+        std::unique_lock lock(mutex_);
+        woken_ = true;
+        condition_.notify_one();
+    }
+}
+
+FiberWaitList::FiberWaitList()
+    : locked_(false)
+    , head_(nullptr)
+    , tail_(nullptr)
+{
+}
+
+void FiberWaitList::lock()
+{
+    spin_until([this]() { return !locked_.exchange(true, std::memory_order_acquire); });
+}
+
+void FiberWaitList::unlock()
+{
+    locked_.store(false, std::memory_order_release);
+}
+
+void FiberWaitList::push(Waiter &waiter)
+{
+    if (waiter.fiber_ != nullptr)
+    {
+        // as soon as we are in the list we can be woken, so this must happen first
+        waiter.fiber_->set_unsafe();
+    }
+
+    waiter.next_ = nullptr;
+
+    if (tail_ == nullptr)
+    {
+        head_ = &waiter;
+    }
+    else
+    {
+        tail_->next_ = &waiter;
+    }
+
+    tail_ = &waiter;
+}
+
+FiberWaitList::Waiter *FiberWaitList::pop()
+{
+    auto *waiter = head_;
+
+    if (waiter != nullptr)
+    {
+        head_ = waiter->next_;
+
+        if (head_ == nullptr)
+        {
+            tail_ = nullptr;
+        }
+    }
+
+    return waiter;
+}
+
+FiberWaitList::Waiter *FiberWaitList::pop(std::size_t count)
+{
+    if ((count == 0u) || (head_ == nullptr))
+    {
+        return nullptr;
+    }
+
+    auto *waiters = head_;
+    auto *last = head_;
+
+    for (auto i = 1u; (i < count) && (last->next_ != nullptr); ++i)
+    {
+        last = last->next_;
+    }
+
+    // detach the popped waiters from the rest of the list
+    head_ = last->next_;
+    last->next_ = nullptr;
+
+    if (head_ == nullptr)
+    {
+        tail_ = nullptr;
+    }
+
+    return waiters;
+}
+
+FiberWaitList::Waiter *FiberWaitList::pop_all()
+{
+    auto *waiters = head_;
+    head_ = nullptr;
+    tail_ = nullptr;
+
+    return waiters;
+}
+
+FiberWaitList::Waiter *FiberWaitList::next(Waiter *waiter)
+{
+    return waiter->next_;
+}
+
+bool FiberWaitList::empty() const
+{
+    return head_ == nullptr;
+}
+
+}
@@ -7,15 +7,18 @@
 #include "jobs/fiber/fiber.h"
 
 #include <atomic>
+#include <chrono>
 #include <cassert>
 #include <cstddef>
 #include <exception>
 #include <memory>
+#include <utility>
 
 #include "core/error_handling.h"
 #include "core/static_buffer.h"
 #include "jobs/context.h"
-#include "jobs/job.h"
+#include "jobs/inline_job.h"
+#include "jobs/job_priority.h"
 #include "log/log.h"
 
 #if defined(__clang__)
@@ -112,55 +115,66 @@ struct Fiber::implementation
     }
 };
 
-Fiber::Fiber(Job job)
-    : Fiber(job, nullptr)
+Fiber::Fiber(InlineJob job)
+    : Fiber(std::move(job), nullptr)
 {
 }
 
-Fiber::Fiber(Job job, Counter *counter)
-    : job_(nullptr)
+Fiber::Fiber(InlineJob job, Counter *counter)
+    : Fiber(std::move(job), counter, default_stack_size)
+{
+}
+
+Fiber::Fiber(InlineJob job, Counter *counter, std::size_t stack_size)
+    : job_(std::move(job))
     , counter_(counter)
+    , next_waiter_(nullptr)
+    , priority_(JobPriority::NORMAL)
+    , scheduled_at_()
+    , started_(false)
     , parent_fiber_(nullptr)
     , exception_(nullptr)
     , safe_(true)
+    , stack_size_(stack_size)
     , impl_(std::make_unique<implementation>())
 {
-    job_ = job;
+    // round up to a whole number of pages, plus an extra one as we need some
+    // space to copy the previous stack frame
+    const auto page_size = StaticBuffer::page_size();
+    const auto stack_pages = ((stack_size + page_size - 1u) / page_size) + 1u;
 
-    impl_->stack_buffer = std::make_unique<StaticBuffer>(10u);
+    impl_->stack_buffer = std::make_unique<StaticBuffer>(stack_pages);
 
     // stack grows from high -> low memory so move our pointer down, not all the
     // way as we need some space to copy the previous stack frame
-    impl_->stack = *impl_->stack_buffer + (StaticBuffer::page_size() * 9);
+    impl_->stack = *impl_->stack_buffer + (page_size * (stack_pages - 1u));
 }
 
 Fiber::~Fiber() = default;
 
-void Fiber::start()
+bool Fiber::start()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
     *this_fiber() = this;
+    started_ = true;
 
     // save our context and kick off the job, we will return from here when the
     // job is done (but possible on a different thread)
     save_context(&impl_->context);
     implementation::do_start(this);
 
+    auto finished = true;
+
     if (!safe_)
     {
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
+        finished = false;
         safe_ = true;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            (*counter_)--;
-        }
-    }
+
+    return finished;
 }
 
 void Fiber::suspend()
@@ -177,7 +191,7 @@ void Fiber::suspend()
     }
 }
 
-void Fiber::resume()
+bool Fiber::resume()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
@@ -185,20 +199,34 @@ void Fiber::resume()
 
     implementation::do_resume(this);
 
+    auto finished = true;
+
     if (!safe_)
     {
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
+        finished = false;
         safe_ = true;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            (*counter_)--;
-        }
-    }
+
+    return finished;
+}
+
+void Fiber::reset(InlineJob job, Counter *counter)
+{
+    job_ = std::move(job);
+    counter_ = counter;
+    next_waiter_ = nullptr;
+    priority_ = JobPriority::NORMAL;
+    started_ = false;
+    parent_fiber_ = nullptr;
+    exception_ = nullptr;
+    safe_ = true;
+}
+
+std::size_t Fiber::stack_size() const
+{
+    return stack_size_;
 }
 
 bool Fiber::is_safe() const
@@ -211,11 +239,56 @@ void Fiber::set_unsafe()
     safe_ = false;
 }
 
+void Fiber::set_safe()
+{
+    safe_ = true;
+}
+
+bool Fiber::is_started() const
+{
+    return started_;
+}
+
 bool Fiber::is_being_waited_on() const
 {
     return counter_ != nullptr;
 }
 
+Counter *Fiber::counter() const
+{
+    return counter_;
+}
+
+JobPriority Fiber::priority() const
+{
+    return priority_;
+}
+
+void Fiber::set_priority(JobPriority priority)
+{
+    priority_ = priority;
+}
+
+std::chrono::steady_clock::time_point Fiber::scheduled_at() const
+{
+    return scheduled_at_;
+}
+
+void Fiber::set_scheduled_at(std::chrono::steady_clock::time_point time)
+{
+    scheduled_at_ = time;
+}
+
+Fiber *Fiber::next_waiter() const
+{
+    return next_waiter_;
+}
+
+void Fiber::set_next_waiter(Fiber *fiber)
+{
+    next_waiter_ = fiber;
+}
+
 std::exception_ptr Fiber::exception() const
 {
     return exception_;
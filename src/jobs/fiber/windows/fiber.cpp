@@ -7,13 +7,16 @@
 #include "jobs/fiber/fiber.h"
 
 #include <cassert>
+#include <chrono>
 #include <exception>
+#include <utility>
 
 #include <Windows.h>
 
 #include "core/auto_release.h"
 #include "core/error_handling.h"
-#include "jobs/job.h"
+#include "jobs/inline_job.h"
+#include "jobs/job_priority.h"
 
 namespace iris
 {
@@ -28,49 +31,65 @@ struct Fiber::implementation
     /**
      * Start function for win32 fiber.
      *
+     * A win32 fiber must never return from its start function, so we loop
+     * forever. Each time the fiber is switched to after finishing a job it
+     * will run the next job it was reset with, allowing it to be reused.
+     *
      * @param data
      *   Data passed to start function.
      */
     static void job_runner(void *data)
     {
-
         auto *fiber = static_cast<Fiber *>(data);
-        *this_fiber() = fiber;
 
-        try
-        {
-            fiber->job_();
-        }
-        catch (...)
+        for (;;)
         {
-            // store any exceptions so it can possibly be rethrown later
-            if (fiber->exception_ == nullptr)
+            *this_fiber() = fiber;
+
+            try
             {
-                fiber->exception_ = std::current_exception();
+                fiber->job_();
+            }
+            catch (...)
+            {
+                // store any exceptions so it can possibly be rethrown later
+                if (fiber->exception_ == nullptr)
+                {
+                    fiber->exception_ = std::current_exception();
+                }
             }
-        }
 
-        fiber->parent_fiber_->resume();
+            fiber->parent_fiber_->resume();
+        }
     }
 };
 #pragma optimize("", on)
 
-Fiber::Fiber(Job job)
-    : Fiber(job, nullptr)
+Fiber::Fiber(InlineJob job)
+    : Fiber(std::move(job), nullptr)
+{
+}
+
+Fiber::Fiber(InlineJob job, Counter *counter)
+    : Fiber(std::move(job), counter, default_stack_size)
 {
 }
 
-Fiber::Fiber(Job job, Counter *counter)
-    : job_()
+Fiber::Fiber(InlineJob job, Counter *counter, std::size_t stack_size)
+    : job_(std::move(job))
     , counter_(counter)
+    , next_waiter_(nullptr)
+    , priority_(JobPriority::NORMAL)
+    , scheduled_at_()
+    , started_(false)
     , parent_fiber_(nullptr)
     , exception_(nullptr)
     , safe_(true)
+    , stack_size_(stack_size)
     , impl_(std::make_unique<Fiber::implementation>())
 {
-    job_ = job;
     impl_->handle = {
-        ::CreateFiberEx(0, 0, FIBER_FLAG_FLOAT_SWITCH, reinterpret_cast<LPFIBER_START_ROUTINE>(implementation::job_runner), static_cast<void *>(this)),
+        ::CreateFiberEx(0, stack_size, FIBER_FLAG_FLOAT_SWITCH, reinterpret_cast<LPFIBER_START_ROUTINE>(implementation::job_runner), static_cast<void *>(this)),
         ::DeleteFiber};
 
     expect(impl_->handle, "create fiber failed");
@@ -78,29 +97,27 @@ Fiber::Fiber(Job job, Counter *counter)
 
 Fiber::~Fiber() = default;
 
-void Fiber::start()
+bool Fiber::start()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
     *this_fiber() = this;
+    started_ = true;
 
     // switch to fiber (this will kick-off the job)
     ::SwitchToFiber(impl_->handle);
 
+    auto finished = true;
+
     if (!safe_)
     {
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
+        finished = false;
         safe_ = true;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            --(*counter_);
-        }
-    }
+
+    return finished;
 }
 
 void Fiber::suspend()
@@ -117,7 +134,7 @@ void Fiber::suspend()
     }
 }
 
-void Fiber::resume()
+bool Fiber::resume()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
@@ -125,20 +142,34 @@ void Fiber::resume()
 
     ::SwitchToFiber(impl_->handle);
 
+    auto finished = true;
+
     if (!safe_)
     {
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
+        finished = false;
         safe_ = true;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            --(*counter_);
-        }
-    }
+
+    return finished;
+}
+
+void Fiber::reset(InlineJob job, Counter *counter)
+{
+    job_ = std::move(job);
+    counter_ = counter;
+    next_waiter_ = nullptr;
+    priority_ = JobPriority::NORMAL;
+    started_ = false;
+    parent_fiber_ = nullptr;
+    exception_ = nullptr;
+    safe_ = true;
+}
+
+std::size_t Fiber::stack_size() const
+{
+    return stack_size_;
 }
 
 bool Fiber::is_safe() const
@@ -151,11 +182,56 @@ void Fiber::set_unsafe()
     safe_ = false;
 }
 
+void Fiber::set_safe()
+{
+    safe_ = true;
+}
+
+bool Fiber::is_started() const
+{
+    return started_;
+}
+
 bool Fiber::is_being_waited_on() const
 {
     return counter_ != nullptr;
 }
 
+Counter *Fiber::counter() const
+{
+    return counter_;
+}
+
+JobPriority Fiber::priority() const
+{
+    return priority_;
+}
+
+void Fiber::set_priority(JobPriority priority)
+{
+    priority_ = priority;
+}
+
+std::chrono::steady_clock::time_point Fiber::scheduled_at() const
+{
+    return scheduled_at_;
+}
+
+void Fiber::set_scheduled_at(std::chrono::steady_clock::time_point time)
+{
+    scheduled_at_ = time;
+}
+
+Fiber *Fiber::next_waiter() const
+{
+    return next_waiter_;
+}
+
+void Fiber::set_next_waiter(Fiber *fiber)
+{
+    next_waiter_ = fiber;
+}
+
 std::exception_ptr Fiber::exception() const
 {
     return exception_;
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/worker_stats.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Get the histogram bucket for a queue wait.
+ *
+ * @param duration
+ *   Time fiber was queued.
+ *
+ * @returns
+ *   Index of bucket.
+ */
+std::size_t queue_wait_bucket(std::chrono::nanoseconds duration)
+{
+    auto bucket = 0u;
+
+    while (duration >= iris::queue_wait_bucket_upper_bound(bucket))
+    {
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+}
+
+namespace iris
+{
+
+WorkerCounters::WorkerCounters()
+    : jobs_run_(0u)
+    , busy_ns_(0u)
+    , idle_ns_(0u)
+    , queue_wait_()
+    , fibers_suspended_(0u)
+    , fibers_resumed_(0u)
+    , steals_(0u)
+{
+    for (auto &bucket : queue_wait_)
+    {
+        bucket.store(0u, std::memory_order_relaxed);
+    }
+}
+
+void WorkerCounters::add_queue_wait(std::chrono::nanoseconds duration)
+{
+    increment(queue_wait_[queue_wait_bucket(duration)], 1u);
+}
+
+WorkerStats WorkerCounters::snapshot() const
+{
+    WorkerStats stats{
+        .jobs_run = jobs_run_.load(std::memory_order_relaxed),
+        .busy_time = std::chrono::nanoseconds(busy_ns_.load(std::memory_order_relaxed)),
+        .idle_time = std::chrono::nanoseconds(idle_ns_.load(std::memory_order_relaxed)),
+        .queue_wait = {},
+        .fibers_suspended = fibers_suspended_.load(std::memory_order_relaxed),
+        .fibers_resumed = fibers_resumed_.load(std::memory_order_relaxed),
+        .steals = steals_.load(std::memory_order_relaxed)};
+
+    for (auto i = 0u; i < queue_wait_bucket_count; ++i)
+    {
+        stats.queue_wait[i] = queue_wait_[i].load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+WorkerTrace::WorkerTrace()
+    : events_()
+    , mutex_()
+{
+}
+
+void WorkerTrace::record(const JobTraceEvent &event)
+{
+    std::unique_lock lock(mutex_);
+    events_.emplace_back(event);
+}
+
+void WorkerTrace::clear()
+{
+    std::unique_lock lock(mutex_);
+    events_.clear();
+}
+
+std::vector<JobTraceEvent> WorkerTrace::events() const
+{
+    std::unique_lock lock(mutex_);
+    return events_;
+}
+
+std::string to_chrome_trace(
+    const std::vector<std::vector<JobTraceEvent>> &traces,
+    std::chrono::steady_clock::time_point start)
+{
+    // chrome expects timestamps in (fractional) microseconds
+    const auto to_us = [](std::chrono::steady_clock::duration duration)
+    { return std::chrono::duration<double, std::micro>(duration).count(); };
+
+    std::stringstream strm{};
+    strm << std::fixed << std::setprecision(3);
+    strm << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+    auto first = true;
+
+    for (auto worker = 0u; worker < traces.size(); ++worker)
+    {
+        if (!first)
+        {
+            strm << ',';
+        }
+        first = false;
+
+        // name the thread so it shows up as "worker n" rather than just the tid
+        strm << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << worker << R"(,"args":{"name":"worker )"
+             << worker << R"("}})";
+
+        for (const auto &event : traces[worker])
+        {
+            strm << R"(,{"name":"job","cat":"job","ph":"X","pid":0,"tid":)" << worker << R"(,"ts":)"
+                 << to_us(event.begin - start) << R"(,"dur":)" << to_us(event.end - event.begin)
+                 << R"(,"args":{"fiber":")" << std::hex << event.fiber << std::dec << R"(","resumed":)"
+                 << (event.resumed ? "true" : "false") << R"(,"suspended":)" << (event.suspended ? "true" : "false")
+                 << "}}";
+        }
+    }
+
+    strm << "]}";
+
+    return strm.str();
+}
+
+}
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/job_system_config.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "core/exception.h"
+#include "core/thread.h"
+#include "log/log.h"
+
+namespace
+{
+
+/**
+ * Split a string on a delimiter.
+ *
+ * @param str
+ *   String to split.
+ *
+ * @param delimiter
+ *   Character to split on.
+ *
+ * @returns
+ *   Collection of parts, empty parts are kept.
+ */
+std::vector<std::string_view> split(std::string_view str, char delimiter)
+{
+    std::vector<std::string_view> parts{};
+
+    for (;;)
+    {
+        const auto position = str.find(delimiter);
+        parts.emplace_back(str.substr(0u, position));
+
+        if (position == std::string_view::npos)
+        {
+            break;
+        }
+
+        str.remove_prefix(position + 1u);
+    }
+
+    return parts;
+}
+
+/**
+ * Parse an unsigned integer.
+ *
+ * @param str
+ *   String to parse, must only contain the integer.
+ *
+ * @returns
+ *   Parsed value.
+ */
+template <class T>
+T parse_number(std::string_view str)
+{
+    T value{};
+    const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+
+    iris::ensure((error == std::errc{}) && (end == str.data() + str.size()), "invalid number in job system config");
+
+    return value;
+}
+
+/**
+ * Parse a comma separated list of cores.
+ *
+ * @param str
+ *   String to parse, may be empty.
+ *
+ * @returns
+ *   Parsed cores.
+ */
+std::vector<std::size_t> parse_cores(std::string_view str)
+{
+    std::vector<std::size_t> cores{};
+
+    if (!str.empty())
+    {
+        for (const auto part : split(str, ','))
+        {
+            cores.emplace_back(parse_number<std::size_t>(part));
+        }
+    }
+
+    return cores;
+}
+
+}
+
+namespace iris
+{
+
+JobSystemConfig parse_job_system_config(const std::vector<std::string> &args)
+{
+    JobSystemConfig config{};
+
+    for (const std::string_view arg : args)
+    {
+        // split into key and (optional) value
+        const auto equals = arg.find('=');
+        const auto key = arg.substr(0u, equals);
+        const auto value = (equals == std::string_view::npos) ? std::string_view{} : arg.substr(equals + 1u);
+
+        if (key == "--jobs-workers")
+        {
+            config.worker_count = parse_number<std::uint32_t>(value);
+        }
+        else if (key == "--jobs-reserve")
+        {
+            config.reserved_cores = parse_cores(value);
+        }
+        else if (key == "--jobs-affinity")
+        {
+            config.worker_affinity.clear();
+
+            for (const auto worker : split(value, '/'))
+            {
+                config.worker_affinity.emplace_back(parse_cores(worker));
+            }
+        }
+        else if (key == "--jobs-names")
+        {
+            config.worker_names.clear();
+
+            for (const auto name : split(value, ','))
+            {
+                config.worker_names.emplace_back(name);
+            }
+        }
+        else if (key == "--jobs-pin")
+        {
+            config.pin_workers = true;
+        }
+    }
+
+    return config;
+}
+
+std::vector<WorkerLayout> resolve_worker_layout(const JobSystemConfig &config, std::uint32_t core_count)
+{
+    ensure(core_count > 0u, "must have at least one core");
+
+    const auto is_reserved = [&config](std::size_t core)
+    { return std::ranges::find(config.reserved_cores, core) != std::cend(config.reserved_cores); };
+
+    for (const auto core : config.reserved_cores)
+    {
+        ensure(core < core_count, "reserved core out of range");
+    }
+
+    std::vector<std::size_t> available{};
+    for (auto core = 0u; core < core_count; ++core)
+    {
+        if (!is_reserved(core))
+        {
+            available.emplace_back(core);
+        }
+    }
+
+    ensure(!available.empty(), "all cores reserved");
+
+    // with nothing reserved we leave a core for the main thread, otherwise it's assumed the main thread has one of the
+    // reserved cores
+    auto worker_count = config.worker_count;
+    if (worker_count == 0u)
+    {
+        worker_count = config.reserved_cores.empty() ? std::max(1u, core_count - 1u)
+                                                     : static_cast<std::uint32_t>(available.size());
+    }
+
+    ensure(config.worker_affinity.size() <= worker_count, "affinity set for more workers than exist");
+    ensure(config.worker_names.size() <= worker_count, "name set for more workers than exist");
+
+    std::vector<WorkerLayout> layout{};
+
+    for (auto i = 0u; i < worker_count; ++i)
+    {
+        WorkerLayout worker{};
+
+        worker.name = ((i < config.worker_names.size()) && !config.worker_names[i].empty())
+                          ? config.worker_names[i]
+                          : "iris worker " + std::to_string(i);
+
+        if ((i < config.worker_affinity.size()) && !config.worker_affinity[i].empty())
+        {
+            worker.cores = config.worker_affinity[i];
+
+            for (const auto core : worker.cores)
+            {
+                ensure(core < core_count, "affinity core out of range");
+                ensure(!is_reserved(core), "affinity includes a reserved core");
+            }
+
+            std::ranges::sort(worker.cores);
+            const auto [first, last] = std::ranges::unique(worker.cores);
+            worker.cores.erase(first, last);
+        }
+        else if (config.pin_workers)
+        {
+            worker.cores = {available[i % available.size()]};
+        }
+        else if (!config.reserved_cores.empty())
+        {
+            // not pinned, but still keep off the reserved cores
+            worker.cores = available;
+        }
+
+        layout.emplace_back(std::move(worker));
+    }
+
+    return layout;
+}
+
+JobSystemConfig fixed_worker_config(std::uint32_t worker_count)
+{
+    ensure(worker_count > 0u, "must have at least one worker");
+
+    return {.worker_count = worker_count};
+}
+
+void apply_layout(Thread &worker, const WorkerLayout &layout, std::size_t index)
+{
+    worker.set_name(layout.name);
+
+    if (!layout.cores.empty())
+    {
+        // the worker is already running, so if the kernel refuses we carry on unpinned rather than unwind with a
+        // joinable thread
+        try
+        {
+            worker.bind_to_cores(layout.cores);
+        }
+        catch (const Exception &)
+        {
+            LOG_ENGINE_WARN("job_system", "could not pin worker {}", index);
+        }
+    }
+
+    LOG_ENGINE_INFO("job_system", "worker {}: {}", index, layout);
+}
+
+}
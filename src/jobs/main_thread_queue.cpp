@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/main_thread_queue.h"
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+
+namespace iris
+{
+
+MainThreadQueue::MainThreadQueue()
+    : jobs_()
+    , running_()
+    , mutex_()
+{
+}
+
+void MainThreadQueue::enqueue(const std::vector<Job> &jobs)
+{
+    std::unique_lock lock(mutex_);
+
+    for (const auto &job : jobs)
+    {
+        jobs_.emplace_back(job);
+    }
+}
+
+void MainThreadQueue::enqueue(std::span<InlineJob> jobs)
+{
+    std::unique_lock lock(mutex_);
+
+    for (auto &job : jobs)
+    {
+        jobs_.emplace_back(std::move(job));
+    }
+}
+
+std::size_t MainThreadQueue::run()
+{
+    {
+        std::unique_lock lock(mutex_);
+        std::swap(jobs_, running_);
+    }
+
+    std::exception_ptr exception = nullptr;
+
+    for (auto &job : running_)
+    {
+        try
+        {
+            job();
+        }
+        catch (...)
+        {
+            if (!exception)
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+
+    const auto count = running_.size();
+    running_.clear();
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    return count;
+}
+
+std::size_t MainThreadQueue::size() const
+{
+    std::unique_lock lock(mutex_);
+    return jobs_.size();
+}
+
+}
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/task_graph.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+#include "jobs/job_system_manager.h"
+
+namespace iris
+{
+
+TaskGraph::TaskGraph()
+    : nodes_()
+    , roots_()
+    , root_jobs_()
+    , pending_()
+    , jobs_manager_(nullptr)
+    , dirty_(false)
+{
+}
+
+TaskGraph::NodeId TaskGraph::add_node(Job job)
+{
+    ensure(static_cast<bool>(job), "node must have a job");
+
+    nodes_.push_back({.job = std::move(job), .successors = {}, .dependency_count = 0u});
+    dirty_ = true;
+
+    return nodes_.size() - 1u;
+}
+
+void TaskGraph::add_edge(NodeId before, NodeId after)
+{
+    ensure((before < nodes_.size()) && (after < nodes_.size()), "unknown node");
+    ensure(before != after, "node cannot depend on itself");
+
+    nodes_[before].successors.emplace_back(after);
+    ++nodes_[after].dependency_count;
+    dirty_ = true;
+}
+
+TaskGraph::NodeId TaskGraph::add_continuation(NodeId node, Job job)
+{
+    ensure(node < nodes_.size(), "unknown node");
+
+    const auto id = add_node(std::move(job));
+    add_edge(node, id);
+
+    return id;
+}
+
+std::size_t TaskGraph::size() const
+{
+    return nodes_.size();
+}
+
+void TaskGraph::run(JobSystemManager &jobs_manager)
+{
+    if (dirty_)
+    {
+        prepare();
+    }
+
+    if (nodes_.empty())
+    {
+        return;
+    }
+
+    for (auto i = 0u; i < nodes_.size(); ++i)
+    {
+        pending_[i].store(nodes_[i].dependency_count, std::memory_order_relaxed);
+    }
+
+    jobs_manager_ = &jobs_manager;
+
+    for (auto i = 0u; i < roots_.size(); ++i)
+    {
+        root_jobs_[i] = [this, root = roots_[i]]() { execute(root); };
+    }
+
+    // every other node is added as a continuation of a root, so waiting on the roots waits on the whole graph
+    jobs_manager.wait(root_jobs_);
+}
+
+void TaskGraph::prepare()
+{
+    roots_.clear();
+
+    for (auto i = 0u; i < nodes_.size(); ++i)
+    {
+        if (nodes_[i].dependency_count == 0u)
+        {
+            roots_.emplace_back(i);
+        }
+    }
+
+    // check every node is reachable by walking the graph in dependency order (Kahn's algorithm), anything left over
+    // is part of a cycle and would never run
+    std::vector<std::size_t> remaining{};
+    remaining.reserve(nodes_.size());
+    for (const auto &node : nodes_)
+    {
+        remaining.emplace_back(node.dependency_count);
+    }
+
+    auto ready = roots_;
+    auto visited = 0u;
+
+    while (!ready.empty())
+    {
+        const auto node = ready.back();
+        ready.pop_back();
+        ++visited;
+
+        for (const auto successor : nodes_[node].successors)
+        {
+            if (--remaining[successor] == 0u)
+            {
+                ready.emplace_back(successor);
+            }
+        }
+    }
+
+    ensure(visited == nodes_.size(), "task graph contains a cycle");
+
+    root_jobs_.resize(roots_.size());
+    pending_ = std::make_unique<std::atomic<std::size_t>[]>(nodes_.size());
+    dirty_ = false;
+}
+
+void TaskGraph::execute(NodeId node)
+{
+    // rather than scheduling every node that becomes ready we carry on with one of them on this worker, so a chain of
+    // nodes runs without going back through the job system
+    for (;;)
+    {
+        nodes_[node].job();
+
+        auto next = nodes_.size();
+
+        for (const auto successor : nodes_[node].successors)
+        {
+            // acq_rel so the successor sees everything done by all of its dependencies
+            if (pending_[successor].fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            {
+                if (next == nodes_.size())
+                {
+                    next = successor;
+                }
+                else
+                {
+                    std::array<InlineJob, 1u> continuation{{[this, successor]() { execute(successor); }}};
+                    jobs_manager_->add_continuation(continuation);
+                }
+            }
+        }
+
+        if (next == nodes_.size())
+        {
+            break;
+        }
+
+        node = next;
+    }
+}
+
+}
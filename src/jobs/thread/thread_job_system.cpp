@@ -6,49 +6,413 @@
 
 #include "jobs/thread/thread_job_system.h"
 
-#include <chrono>
-#include <future>
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "core/error_handling.h"
+#include "core/exception.h"
+#include "core/frame_arena.h"
+#include "core/thread.h"
+#include "jobs/chunk_function.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
+#include "jobs/job_system_config.h"
+#include "jobs/job_utils.h"
 #include "log/log.h"
 
 namespace iris
 {
 
+/**
+ * Tracks a collection of jobs being waited on. This lives on the stack of the waiting thread.
+ */
+struct ThreadJobSystem::WaitGroup
+{
+    /**
+     * Construct a new WaitGroup.
+     *
+     * @param count
+     *   Number of jobs to wait on.
+     */
+    explicit WaitGroup(std::size_t count)
+        : remaining(count)
+        , exception(nullptr)
+        , mutex()
+        , condition()
+    {
+    }
+
+    /** Number of jobs yet to finish. */
+    std::size_t remaining;
+
+    /** First exception thrown by a job. */
+    std::exception_ptr exception;
+
+    /** Lock for group. */
+    std::mutex mutex;
+
+    /** Signals waiting thread when remaining reaches zero. */
+    std::condition_variable condition;
+};
+
 ThreadJobSystem::ThreadJobSystem()
+    : ThreadJobSystem(JobSystemConfig{})
+{
+}
+
+ThreadJobSystem::ThreadJobSystem(std::uint32_t worker_count)
+    : ThreadJobSystem(fixed_worker_config(worker_count))
+{
+}
+
+ThreadJobSystem::ThreadJobSystem(const JobSystemConfig &config)
     : running_(true)
+    , tasks_()
+    , task_count_(0u)
+    , idle_policy_(IdlePolicy::balanced())
+    , mutex_()
+    , condition_()
+    , worker_layout_(resolve_worker_layout(config, std::max(1u, std::thread::hardware_concurrency())))
+    , workers_()
+    , main_thread_jobs_()
 {
+    LOG_ENGINE_INFO("job_system", "creating {} threads", worker_layout_.size());
+
+    for (auto i = 0u; i < worker_layout_.size(); ++i)
+    {
+        workers_.emplace_back(&ThreadJobSystem::worker_thread, this);
+        apply_layout(workers_.back(), worker_layout_[i], i);
+    }
 }
 
-void ThreadJobSystem::add_jobs(const std::vector<Job> &jobs)
+ThreadJobSystem::~ThreadJobSystem()
 {
-    for (const auto &job : jobs)
     {
-        // we cannot simply call std::async here as the std::future destructor
-        // will block and wait for the job to finish
-        // instead we create a shared_ptr for the future and copy it by value
-        // into the async task
-        // this ensures it keeps a reference to itself and won't go out of
-        // scope until the job is complete
-        auto future = std::make_shared<std::future<void>>();
+        std::unique_lock lock(mutex_);
+        running_ = false;
+    }
+
+    condition_.notify_all();
 
-        *future = std::async(std::launch::async, [future, job] { job(); });
+    for (auto &worker : workers_)
+    {
+        worker.join();
     }
 }
 
+void ThreadJobSystem::add_jobs(const std::vector<Job> &jobs)
+{
+    enqueue(jobs, nullptr, JobPriority::NORMAL);
+}
+
+void ThreadJobSystem::add_jobs(std::span<InlineJob> jobs)
+{
+    enqueue(jobs, nullptr, JobPriority::NORMAL);
+}
+
+void ThreadJobSystem::add_jobs(std::span<InlineJob> jobs, JobPriority priority)
+{
+    enqueue(jobs, nullptr, priority);
+}
+
 void ThreadJobSystem::wait_for_jobs(const std::vector<Job> &jobs)
 {
-    std::vector<std::future<void>> waiting_jobs{};
+    wait_for_jobs_impl(jobs, JobPriority::NORMAL);
+}
+
+void ThreadJobSystem::wait_for_jobs(std::span<InlineJob> jobs)
+{
+    wait_for_jobs_impl(jobs, JobPriority::NORMAL);
+}
+
+void ThreadJobSystem::wait_for_jobs(std::span<InlineJob> jobs, JobPriority priority)
+{
+    wait_for_jobs_impl(jobs, priority);
+}
+
+void ThreadJobSystem::add_continuation_jobs(std::span<InlineJob> jobs)
+{
+    const auto *task = current_task();
+
+    if ((task == nullptr) || (task->group == nullptr))
+    {
+        enqueue(jobs, nullptr, JobPriority::NORMAL);
+        return;
+    }
+
+    // the current task has not yet signalled its group, so the waiting thread cannot have finished and we can safely
+    // extend it with the new jobs
+    {
+        std::unique_lock lock(task->group->mutex);
+        task->group->remaining += jobs.size();
+    }
+
+    enqueue(jobs, task->group, task->priority);
+}
+
+void ThreadJobSystem::add_main_thread_jobs(const std::vector<Job> &jobs)
+{
+    main_thread_jobs_.enqueue(jobs);
+}
+
+void ThreadJobSystem::add_main_thread_jobs(std::span<InlineJob> jobs)
+{
+    main_thread_jobs_.enqueue(jobs);
+}
+
+std::size_t ThreadJobSystem::run_main_thread_jobs()
+{
+    return main_thread_jobs_.run();
+}
+
+JobQueueDepths ThreadJobSystem::queue_depths() const
+{
+    std::unique_lock lock(mutex_);
+
+    return {
+        .high = tasks_[lane(JobPriority::HIGH)].size(),
+        .normal = tasks_[lane(JobPriority::NORMAL)].size(),
+        .background = tasks_[lane(JobPriority::BACKGROUND)].size(),
+        .main_thread = main_thread_jobs_.size()};
+}
+
+void ThreadJobSystem::set_idle_policy(const IdlePolicy &policy)
+{
+    idle_policy_.store(policy, std::memory_order_relaxed);
+}
+
+IdlePolicy ThreadJobSystem::idle_policy() const
+{
+    return idle_policy_.load(std::memory_order_relaxed);
+}
+
+void ThreadJobSystem::run_chunks(std::size_t chunk_count, ChunkFunction function)
+{
+    // all workers share one queue so there's nothing to gain from splitting recursively, queue one job per chunk in a
+    // single go instead
+    std::vector<InlineJob> jobs{};
+    jobs.reserve(chunk_count);
+
+    for (std::size_t chunk = 0u; chunk < chunk_count; ++chunk)
+    {
+        jobs.emplace_back([function, chunk]() { function(chunk); });
+    }
+
+    wait_for_jobs(jobs);
+}
+
+std::uint32_t ThreadJobSystem::worker_count() const
+{
+    return static_cast<std::uint32_t>(workers_.size());
+}
+
+std::vector<WorkerLayout> ThreadJobSystem::worker_layout() const
+{
+    return worker_layout_;
+}
+
+template <class Jobs>
+void ThreadJobSystem::enqueue(Jobs &jobs, WaitGroup *group, JobPriority priority)
+{
+    const auto count = std::size(jobs);
+
+    if (count == 0u)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock lock(mutex_);
+
+        auto &tasks = tasks_[lane(priority)];
+        for (auto &job : jobs)
+        {
+            tasks.push_back({.job = take_job(job), .group = group, .priority = priority});
+        }
+
+        task_count_ += count;
+    }
+
+    if (count == 1u)
+    {
+        condition_.notify_one();
+    }
+    else
+    {
+        condition_.notify_all();
+    }
+}
+
+template <class Jobs>
+void ThreadJobSystem::wait_for_jobs_impl(Jobs &jobs, JobPriority priority)
+{
+    WaitGroup group{std::size(jobs)};
+
+    enqueue(jobs, &group, priority);
+
+    // run our own queued jobs whilst we wait, this means a job can wait on other jobs without tying up a worker and
+    // once none are left queued every one of them is already running somewhere so it's safe to block
+    //
+    // we never pick up anyone else's jobs, a fire-and-forget job may never return (e.g. a blocking read loop) and
+    // would then take the waiting thread with it
+    Task task{};
+    while (try_pop(task, &group))
+    {
+        run(task);
+
+        std::unique_lock lock(group.mutex);
+        if (group.remaining == 0u)
+        {
+            break;
+        }
+    }
+
+    std::unique_lock lock(group.mutex);
+    group.condition.wait(lock, [&group]() { return group.remaining == 0u; });
+
+    if (group.exception)
+    {
+        std::rethrow_exception(group.exception);
+    }
+}
+
+bool ThreadJobSystem::try_pop(Task &task, const WaitGroup *group)
+{
+    std::unique_lock lock(mutex_);
+
+    for (auto &tasks : tasks_)
+    {
+        const auto iter =
+            std::find_if(std::begin(tasks), std::end(tasks), [group](const Task &t) { return t.group == group; });
+
+        if (iter != std::end(tasks))
+        {
+            task = std::move(*iter);
+            tasks.erase(iter);
+            --task_count_;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadJobSystem::pop_locked(Task &task)
+{
+    for (auto &tasks : tasks_)
+    {
+        if (!tasks.empty())
+        {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            --task_count_;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const ThreadJobSystem::Task *&ThreadJobSystem::current_task()
+{
+    thread_local const Task *task = nullptr;
+    return task;
+}
+
+void ThreadJobSystem::run(Task &task)
+{
+    std::exception_ptr exception = nullptr;
+
+    // tasks can be run whilst waiting inside another task, so restore whatever was running before
+    const auto *previous_task = std::exchange(current_task(), &task);
 
-    for (const auto &job : jobs)
+    try
+    {
+        task.job();
+    }
+    catch (...)
     {
-        waiting_jobs.emplace_back(std::async(std::launch::async, job));
+        exception = std::current_exception();
     }
 
-    for (auto &waiting_job : waiting_jobs)
+    current_task() = previous_task;
+
+    // drop anything the job captured before we signal it's done
+    task.job = nullptr;
+
+    if (task.group == nullptr)
     {
-        waiting_job.get();
+        if (exception)
+        {
+            LOG_ENGINE_ERROR("job_system", "exception thrown from fire-and-forget job");
+        }
+
+        return;
+    }
+
+    // we notify whilst holding the lock, as once the waiting thread can see remaining is zero the group may be
+    // destroyed
+    std::unique_lock lock(task.group->mutex);
+
+    if (exception && !task.group->exception)
+    {
+        task.group->exception = exception;
+    }
+
+    if (--task.group->remaining == 0u)
+    {
+        task.group->condition.notify_all();
     }
 }
+
+void ThreadJobSystem::worker_thread()
+{
+    LOG_ENGINE_DEBUG("job_system", "thread start");
+
+    for (;;)
+    {
+        // spin first (as set by the idle policy) so if work arrives shortly we don't pay for a trip into the kernel to
+        // sleep and be woken
+        iris::idle_wait(
+            idle_policy_.load(std::memory_order_relaxed),
+            [this]() { return !running_ || (task_count_.load(std::memory_order_relaxed) != 0u); });
+
+        Task task{};
+
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this]() { return !running_ || (task_count_ != 0u); });
+
+            if (!running_)
+            {
+                break;
+            }
+
+            pop_locked(task);
+        }
+
+        run(task);
+
+        // no job is running on this thread, so it's safe to reset our frame arena if the frame has moved on
+        reclaim_frame_arena();
+    }
+
+    LOG_ENGINE_DEBUG("job_system", "thread end");
+}
+
 }
@@ -6,11 +6,20 @@
 
 #include "jobs/thread/thread_job_system_manager.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "core/error_handling.h"
+#include "jobs/chunk_function.h"
+#include "jobs/idle_policy.h"
+#include "jobs/inline_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_queue_depths.h"
+#include "jobs/job_system_config.h"
 #include "jobs/job_system_manager.h"
 #include "jobs/thread/thread_job_system.h"
 
@@ -18,10 +27,15 @@ namespace iris
 {
 
 JobSystem *ThreadJobSystemManager::create_job_system()
+{
+    return create_job_system(JobSystemConfig{});
+}
+
+JobSystem *ThreadJobSystemManager::create_job_system(const JobSystemConfig &config)
 {
     ensure(job_system_ == nullptr, "job system already created");
 
-    job_system_ = std::make_unique<ThreadJobSystem>();
+    job_system_ = std::make_unique<ThreadJobSystem>(config);
     return job_system_.get();
 }
 
@@ -30,9 +44,79 @@ void ThreadJobSystemManager::add(const std::vector<Job> &jobs)
     job_system_->add_jobs(jobs);
 }
 
+void ThreadJobSystemManager::add(std::span<InlineJob> jobs)
+{
+    job_system_->add_jobs(jobs);
+}
+
 void ThreadJobSystemManager::wait(const std::vector<Job> &jobs)
 {
     job_system_->wait_for_jobs(jobs);
 }
 
+void ThreadJobSystemManager::wait(std::span<InlineJob> jobs)
+{
+    job_system_->wait_for_jobs(jobs);
+}
+
+void ThreadJobSystemManager::add(std::span<InlineJob> jobs, JobPriority priority)
+{
+    job_system_->add_jobs(jobs, priority);
+}
+
+void ThreadJobSystemManager::wait(std::span<InlineJob> jobs, JobPriority priority)
+{
+    job_system_->wait_for_jobs(jobs, priority);
+}
+
+void ThreadJobSystemManager::add_continuation(std::span<InlineJob> jobs)
+{
+    job_system_->add_continuation_jobs(jobs);
+}
+
+void ThreadJobSystemManager::add_main_thread(const std::vector<Job> &jobs)
+{
+    job_system_->add_main_thread_jobs(jobs);
+}
+
+void ThreadJobSystemManager::add_main_thread(std::span<InlineJob> jobs)
+{
+    job_system_->add_main_thread_jobs(jobs);
+}
+
+std::size_t ThreadJobSystemManager::run_main_thread_jobs()
+{
+    return job_system_->run_main_thread_jobs();
+}
+
+JobQueueDepths ThreadJobSystemManager::queue_depths() const
+{
+    return job_system_->queue_depths();
+}
+
+void ThreadJobSystemManager::set_idle_policy(const IdlePolicy &policy)
+{
+    job_system_->set_idle_policy(policy);
+}
+
+IdlePolicy ThreadJobSystemManager::idle_policy() const
+{
+    return job_system_->idle_policy();
+}
+
+void ThreadJobSystemManager::run_chunks(std::size_t chunk_count, ChunkFunction function)
+{
+    job_system_->run_chunks(chunk_count, function);
+}
+
+std::uint32_t ThreadJobSystemManager::worker_count() const
+{
+    return job_system_->worker_count();
+}
+
+std::vector<WorkerLayout> ThreadJobSystemManager::worker_layout() const
+{
+    return job_system_->worker_layout();
+}
+
 }
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "log/logger.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "jobs/spsc_ring.h"
+#include "log/colour_formatter.h"
+#include "log/log_level.h"
+#include "log/stdout_outputter.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/** Number of messages a single thread can have waiting to be output. */
+constexpr auto ring_capacity = 1024u;
+
+}
+
+namespace iris
+{
+
+Logger::Logger()
+    : formatter_(std::make_unique<ColourFormatter>())
+    , outputter_(std::make_unique<StdoutFormatter>())
+    , ignore_()
+    , min_level_(LogLevel::DEBUG)
+    , log_engine_(false)
+    , mutex_()
+    , rings_mutex_()
+    , rings_()
+    , free_rings_()
+    , drain_batch_(ring_capacity)
+    , pending_(false)
+    , running_(true)
+    , wake_()
+    , writer_()
+{
+    writer_ = std::thread{&Logger::write_loop, this};
+}
+
+Logger::~Logger()
+{
+    running_ = false;
+    wake_.notify_one();
+    writer_.join();
+
+    flush();
+}
+
+void Logger::log(
+    const LogLevel level,
+    const std::string &tag,
+    const std::string &filename,
+    const int line,
+    const bool engine,
+    const std::string &message)
+{
+    // check if we want to process this log message
+    if ((!engine || log_engine_) && (level >= min_level_) && (ignore_.find(tag) == std::cend(ignore_)))
+    {
+        auto log = formatter_->format(level, tag, message, filename, line);
+        auto &ring = producer_ring();
+
+        // if our ring is full then the writer thread has fallen behind, so drain it ourselves
+        while (!ring.try_push(std::move(log)))
+        {
+            flush();
+        }
+
+        if (level == LogLevel::ERR)
+        {
+            // errors are often the last thing logged before something goes wrong, so don't leave them in a ring
+            flush();
+        }
+        else if (!pending_.exchange(true))
+        {
+            wake_.notify_one();
+        }
+    }
+}
+
+void Logger::flush()
+{
+    std::unique_lock lock(mutex_);
+    drain();
+}
+
+SpscRing<std::string> &Logger::producer_ring()
+{
+    /**
+     * Owns the calling thread's ring and hands it back when the thread exits, so a process that keeps creating threads
+     * reuses rings rather than growing rings_ forever.
+     */
+    struct RingOwner
+    {
+        ~RingOwner()
+        {
+            if (ring != nullptr)
+            {
+                logger->release_ring(ring);
+            }
+        }
+
+        Logger *logger = nullptr;
+        SpscRing<std::string> *ring = nullptr;
+    };
+
+    thread_local RingOwner owner{};
+
+    if (owner.ring == nullptr)
+    {
+        owner.logger = this;
+        owner.ring = acquire_ring();
+    }
+
+    return *owner.ring;
+}
+
+SpscRing<std::string> *Logger::acquire_ring()
+{
+    std::unique_lock lock(rings_mutex_);
+
+    // a released ring may still hold messages from its previous thread, they are output before anything we push as
+    // the ring is fifo
+    if (!free_rings_.empty())
+    {
+        auto *ring = free_rings_.back();
+        free_rings_.pop_back();
+        return ring;
+    }
+
+    rings_.emplace_back(std::make_unique<SpscRing<std::string>>(ring_capacity));
+    return rings_.back().get();
+}
+
+void Logger::release_ring(SpscRing<std::string> *ring)
+{
+    std::unique_lock lock(rings_mutex_);
+    free_rings_.emplace_back(ring);
+}
+
+void Logger::write_loop()
+{
+    std::unique_lock lock(mutex_);
+
+    while (running_)
+    {
+        // producers only notify when they set pending_, so a wake up can be missed if it races with us going to sleep,
+        // the timeout puts an upper bound on how long a message can sit in a ring
+        wake_.wait_for(lock, 10ms, [this] { return pending_.load() || !running_; });
+        pending_ = false;
+
+        drain();
+    }
+}
+
+void Logger::drain()
+{
+    std::unique_lock lock(rings_mutex_);
+
+    for (auto &ring : rings_)
+    {
+        for (;;)
+        {
+            const auto count = ring->pop(drain_batch_);
+
+            for (const auto &log : std::span{drain_batch_}.first(count))
+            {
+                outputter_->output(log);
+            }
+
+            if (count < drain_batch_.size())
+            {
+                break;
+            }
+        }
+    }
+}
+
+}
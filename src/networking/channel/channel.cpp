@@ -12,15 +12,29 @@ namespace iris
 std::vector<Packet> Channel::yield_send_queue()
 {
     std::vector<Packet> queue;
-    std::swap(queue, send_queue_);
+    yield_send_queue(queue);
     return queue;
 }
 
+void Channel::yield_send_queue(std::vector<Packet> &queue)
+{
+    // swap buffers, so we keep the storage of the callers old queue
+    queue.clear();
+    std::swap(queue, send_queue_);
+}
+
 std::vector<Packet> Channel::yield_receive_queue()
 {
     std::vector<Packet> queue;
-    std::swap(queue, receive_queue_);
+    yield_receive_queue(queue);
     return queue;
 }
 
+void Channel::yield_receive_queue(std::vector<Packet> &queue)
+{
+    // swap buffers, so we keep the storage of the callers old queue
+    queue.clear();
+    std::swap(queue, receive_queue_);
+}
+
 }
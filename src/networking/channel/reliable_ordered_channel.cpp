@@ -78,15 +78,15 @@ void ReliableOrderedChannel::enqueue_receive(Packet packet)
     }
 }
 
-std::vector<Packet> ReliableOrderedChannel::yield_send_queue()
+void ReliableOrderedChannel::yield_send_queue(std::vector<Packet> &queue)
 {
     // note that we don't yield the queue but return a copy, this is because
     // we want to keep sending packets until we receive an ack
 
-    return send_queue_;
+    queue = send_queue_;
 }
 
-std::vector<Packet> ReliableOrderedChannel::yield_receive_queue()
+void ReliableOrderedChannel::yield_receive_queue(std::vector<Packet> &queue)
 {
     // find the first non-valid packet, everything before that will be a
     // continuous range of valid packets ready to be yielded
@@ -95,20 +95,18 @@ std::vector<Packet> ReliableOrderedChannel::yield_receive_queue()
         std::cend(receive_queue_),
         [](const Packet &element) { return !element.is_valid(); });
 
-    std::vector<Packet> packets{};
+    queue.clear();
 
     if (end_of_valid != std::cbegin(receive_queue_))
     {
         // move packets from queue to output collection
-        packets = std::vector<Packet>(std::cbegin(receive_queue_), end_of_valid);
+        queue.assign(std::cbegin(receive_queue_), end_of_valid);
         receive_queue_.erase(std::begin(receive_queue_), end_of_valid);
 
         // our next expected sequence number will be one greater than the last
         // packet we yield
-        next_receive_seq_ = packets.back().sequence() + 1u;
+        next_receive_seq_ = queue.back().sequence() + 1u;
     }
-
-    return packets;
 }
 
 }
@@ -18,6 +18,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "core/context.h"
 #include "core/data_buffer.h"
@@ -149,6 +150,19 @@ std::chrono::milliseconds handle_sync_finish(const iris::Packet &packet)
     return server_to_client + client_to_server;
 }
 
+/**
+ * Get scratch space for yielding packets to send. This is per thread, so send() and flush() can be called from
+ * different threads, and is swapped with the channel's queue so once warmed up sending does not allocate.
+ *
+ * @returns
+ *   Send batch for calling thread.
+ */
+std::vector<iris::Packet> &send_batch()
+{
+    thread_local std::vector<iris::Packet> batch{};
+    return batch;
+}
+
 }
 
 namespace iris
@@ -181,6 +195,9 @@ ClientConnectionHandler::ClientConnectionHandler(Context &context, std::unique_p
     context.jobs_manager().add(
         {[this]()
          {
+             // reused for every packet, so once warmed up yielding from a channel does not allocate
+             std::vector<Packet> receive_queue{};
+
              for (;;)
              {
                  // block and read the next Packet
@@ -193,7 +210,8 @@ ClientConnectionHandler::ClientConnectionHandler(Context &context, std::unique_p
                  channel->enqueue_receive(std::move(packet));
 
                  // handle all received packets from that channel
-                 for (const auto &p : channel->yield_receive_queue())
+                 channel->yield_receive_queue(receive_queue);
+                 for (const auto &p : receive_queue)
                  {
                      switch (p.type())
                      {
@@ -231,21 +249,30 @@ void ClientConnectionHandler::send(const DataBuffer &data, ChannelType channel_t
     channel->enqueue_send(std::move(packet));
 
     // send all packets
-    for (const auto &p : channel->yield_send_queue())
+    auto &batch = send_batch();
+    channel->yield_send_queue(batch);
+    for (const auto &p : batch)
     {
         socket_->write(p.data(), p.packet_size());
     }
+
+    batch.clear();
 }
 
 void ClientConnectionHandler::flush()
 {
+    auto &batch = send_batch();
+
     for (auto &[type, channel] : channels_)
     {
-        for (const auto &p : channel->yield_send_queue())
+        channel->yield_send_queue(batch);
+        for (const auto &p : batch)
         {
             socket_->write(p.data(), p.packet_size());
         }
     }
+
+    batch.clear();
 }
 
 std::uint32_t ClientConnectionHandler::id() const
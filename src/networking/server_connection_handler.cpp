@@ -16,13 +16,15 @@
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include "core/context.h"
 #include "core/data_buffer.h"
-#include "jobs/concurrent_queue.h"
 #include "jobs/job.h"
 #include "jobs/job_system_manager.h"
+#include "jobs/spsc_ring.h"
 #include "log/log.h"
 #include "networking/channel/channel_type.h"
 #include "networking/channel/reliable_ordered_channel.h"
@@ -36,6 +38,9 @@
 namespace
 {
 
+/** Number of events that can wait for update(), enough for several frames of heavy traffic. */
+constexpr auto event_capacity = 4096u;
+
 /**
  * Helper function to handle a hello message. This is the first part of the
  * handshake and the server needs to respond with CONNECTED. We also use this
@@ -144,13 +149,18 @@ ServerConnectionHandler::ServerConnectionHandler(
     , start_(std::chrono::steady_clock::now())
     , connections_()
     , mutex_()
-    , messages_()
+    , events_(event_capacity)
+    , event_batch_(events_.capacity())
+    , send_batch_()
 {
     // we want to always be accepting connections, so we do this in a background
     // job
     context.jobs_manager().add(
         {[this]()
          {
+             // reused for every packet, so once warmed up yielding from a channel does not allocate
+             std::vector<Packet> receive_queue{};
+
              for (;;)
              {
                  auto [client_socket, raw_packet, new_connection] = socket_->read();
@@ -181,12 +191,10 @@ ServerConnectionHandler::ServerConnectionHandler(
                  const auto channel_type = packet.channel();
                  auto *channel = connection->channels.at(channel_type).get();
 
-                 std::vector<Packet> receive_queue{};
-
                  {
                      std::unique_lock lock(mutex_);
                      channel->enqueue_receive(std::move(packet));
-                     receive_queue = channel->yield_receive_queue();
+                     channel->yield_receive_queue(receive_queue);
                  }
 
                  // handle all received packets from that channel
@@ -198,15 +206,16 @@ ServerConnectionHandler::ServerConnectionHandler(
                          {
                              handle_hello(id, channel, connection->socket, mutex_);
 
-                             // we got a new client, fire it back to the
+                             // we got a new client, pass it back to the
                              // application
-                             new_connection_callback_(id);
+                             push_event({.id = id, .new_connection = true, .data = {}, .channel = p.channel()});
                              break;
                          }
                          case PacketType::DATA:
                          {
-                             // we got data, fire it back to the application
-                             recv_callback_(id, p.body_buffer(), p.channel());
+                             // we got data, pass it back to the application
+                             push_event(
+                                 {.id = id, .new_connection = false, .data = p.body_buffer(), .channel = p.channel()});
                              break;
                          }
                          case PacketType::SYNC_RESPONSE:
@@ -225,6 +234,40 @@ ServerConnectionHandler::~ServerConnectionHandler() = default;
 
 void ServerConnectionHandler::update()
 {
+    // fire callbacks for everything the background job has received so far
+    for (;;)
+    {
+        const auto count = events_.pop(event_batch_);
+
+        for (const auto &event : std::span{event_batch_}.first(count))
+        {
+            if (event.new_connection)
+            {
+                new_connection_callback_(event.id);
+            }
+            else
+            {
+                recv_callback_(event.id, event.data, event.channel);
+            }
+        }
+
+        if (count < event_batch_.size())
+        {
+            break;
+        }
+    }
+}
+
+void ServerConnectionHandler::push_event(Event event)
+{
+    // never block the receive job waiting on update(), if it has fallen this far behind drop the event rather than
+    // stop reading from the socket
+    const auto id = event.id;
+
+    if (!events_.try_push(std::move(event)))
+    {
+        LOG_ENGINE_WARN("server_connection_handler", "event queue full, dropping event for {}", id);
+    }
 }
 
 void ServerConnectionHandler::send(std::size_t id, const DataBuffer &message, ChannelType channel_type)
@@ -240,7 +283,8 @@ void ServerConnectionHandler::send(std::size_t id, const DataBuffer &message, Ch
         channel->enqueue_send(std::move(packet));
 
         // send all packets
-        for (const auto &p : channel->yield_send_queue())
+        channel->yield_send_queue(send_batch_);
+        for (const auto &p : send_batch_)
         {
             socket->write(p.data(), p.packet_size());
         }
@@ -11,12 +11,13 @@
 #include <optional>
 #include <random>
 #include <thread>
+#include <tuple>
 
 #include "core/context.h"
 #include "core/random.h"
-#include "jobs/concurrent_queue.h"
 #include "jobs/job.h"
 #include "jobs/job_system_manager.h"
+#include "jobs/mpmc_queue.h"
 #include "log/log.h"
 
 using namespace std::chrono_literals;
@@ -34,27 +35,29 @@ SimulatedSocket::SimulatedSocket(
     , jitter_(jitter)
     , drop_rate_(drop_rate)
     , socket_(socket)
+    , write_queue_()
 {
     // in order to facilitate message delay without blocking we have write()
     // enqueue data with a time point, this job then grabs them and can wait
     // until the delay has passed before sending
     context.jobs_manager().add({[this]()
                                 {
+                                    std::tuple<DataBuffer, std::chrono::steady_clock::time_point> element{};
+
                                     for (;;)
                                     {
-                                        if (write_queue_.empty())
+                                        if (!write_queue_.try_dequeue(element))
                                         {
                                             std::this_thread::sleep_for(10ms);
+                                            continue;
                                         }
-                                        else
-                                        {
-                                            const auto &[buffer, time_point] = write_queue_.dequeue();
 
-                                            // wait until its time to send the data
-                                            std::this_thread::sleep_until(time_point);
+                                        const auto &[buffer, time_point] = element;
 
-                                            socket_->write(buffer);
-                                        }
+                                        // wait until its time to send the data
+                                        std::this_thread::sleep_until(time_point);
+
+                                        socket_->write(buffer);
                                     }
                                 }});
 }
@@ -78,9 +81,10 @@ void SimulatedSocket::write(const DataBuffer &buffer)
         const auto jitter =
             random_int32(static_cast<std::int32_t>(-jitter_.count()), static_cast<std::int32_t>(jitter_.count()));
 
-        // stick the data to be sent on the queue (with the delay time) and
+        // stick the data to be sent on the queue (with the delay time), if the queue is full then the simulated link
+        // is congested so drop the packet
         const auto delay = delay_ + std::chrono::milliseconds(jitter);
-        write_queue_.enqueue(buffer, std::chrono::steady_clock::now() + delay);
+        write_queue_.try_enqueue(buffer, std::chrono::steady_clock::now() + delay);
     }
 }
 
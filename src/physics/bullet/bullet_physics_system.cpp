@@ -111,6 +111,7 @@ BulletPhysicsSystem::BulletPhysicsSystem(MeshManager &mesh_manager)
     , solver_(nullptr)
     , world_(nullptr)
     , bodies_()
+    , body_handles_()
     , character_controllers_()
     , debug_draw_(mesh_manager)
     , collision_shapes_()
@@ -166,9 +167,10 @@ RigidBody *BulletPhysicsSystem::create_rigid_body(
     const CollisionShape *collision_shape,
     RigidBodyType type)
 {
-    bodies_.emplace_back(
-        std::make_unique<BulletRigidBody>(position, static_cast<const BulletCollisionShape *>(collision_shape), type));
-    auto *body = static_cast<BulletRigidBody *>(bodies_.back().get());
+    auto bullet_body =
+        std::make_unique<BulletRigidBody>(position, static_cast<const BulletCollisionShape *>(collision_shape), type);
+    auto *body = bullet_body.get();
+    body_handles_[body] = bodies_.insert(std::move(bullet_body));
 
     if ((body->type() == RigidBodyType::GHOST) || (body->type() == RigidBodyType::CHARACTER_CONTROLLER))
     {
@@ -236,10 +238,11 @@ void BulletPhysicsSystem::remove(RigidBody *body)
     debug_draw_.deregister_rigid_body(body);
     remove_body_from_world(body, world_.get());
 
-    bodies_.erase(
-        std::remove_if(
-            std::begin(bodies_), std::end(bodies_), [body](const auto &element) { return element.get() == body; }),
-        std::end(bodies_));
+    if (const auto found = body_handles_.find(body); found != std::cend(body_handles_))
+    {
+        bodies_.erase(found->second);
+        body_handles_.erase(found);
+    }
 }
 
 void BulletPhysicsSystem::remove(CharacterController *character)
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "allocation_counter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<bool> counting = false;
+std::atomic<std::size_t> allocations = 0u;
+
+/**
+ * Allocate memory, counting the allocation if enabled.
+ *
+ * @param size
+ *   Number of bytes to allocate.
+ *
+ * @param alignment
+ *   Required alignment.
+ *
+ * @returns
+ *   Pointer to allocated memory.
+ */
+void *allocate(std::size_t size, std::size_t alignment)
+{
+    if (counting.load(std::memory_order_relaxed))
+    {
+        allocations.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    size = (size == 0u) ? 1u : size;
+
+#if defined(IRIS_PLATFORM_WIN32)
+    auto *ptr = ::_aligned_malloc(size, alignment);
+#else
+    void *ptr = nullptr;
+    if (::posix_memalign(&ptr, std::max(alignment, sizeof(void *)), size) != 0)
+    {
+        ptr = nullptr;
+    }
+#endif
+
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+
+    return ptr;
+}
+
+/**
+ * Free memory allocated with allocate.
+ *
+ * @param ptr
+ *   Pointer to free.
+ */
+void deallocate(void *ptr)
+{
+#if defined(IRIS_PLATFORM_WIN32)
+    ::_aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}
+
+AllocationCounter::AllocationCounter()
+{
+    allocations = 0u;
+    counting = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    counting = false;
+}
+
+std::size_t AllocationCounter::count() const
+{
+    return allocations.load();
+}
+
+// replace the global allocation functions, the array and nothrow versions are implemented in terms of these
+
+void *operator new(std::size_t size)
+{
+    return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(ptr);
+}
@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * RAII class for counting heap allocations. The unit tests replace the global operator new, whilst an instance of
+ * this class is alive every allocation (on any thread) is counted.
+ *
+ * Only one instance should be alive at a time.
+ */
+class AllocationCounter
+{
+  public:
+    /**
+     * Start counting allocations.
+     */
+    AllocationCounter();
+
+    /**
+     * Stop counting allocations.
+     */
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter &) = delete;
+    AllocationCounter &operator=(const AllocationCounter &) = delete;
+    AllocationCounter(AllocationCounter &&) = delete;
+    AllocationCounter &operator=(AllocationCounter &&) = delete;
+
+    /**
+     * Get the number of allocations since construction.
+     *
+     * @returns
+     *   Number of allocations.
+     */
+    std::size_t count() const;
+};
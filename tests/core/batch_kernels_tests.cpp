@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/batch_kernels.h"
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+// sizes that are not a multiple of the SIMD width, so the scalar tail is also exercised
+constexpr std::size_t count = 39u;
+
+std::vector<iris::Vector3> random_points(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> dist{-100.0f, 100.0f};
+    std::vector<iris::Vector3> points{};
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        points.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+
+    return points;
+}
+
+std::vector<iris::Quaternion> random_quaternions(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    std::vector<iris::Quaternion> quaternions{};
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        quaternions.emplace_back(iris::Quaternion{dist(rng), dist(rng), dist(rng), dist(rng)}.normalise());
+    }
+
+    return quaternions;
+}
+
+iris::Matrix4 random_matrix(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> angle{-3.0f, 3.0f};
+    std::uniform_real_distribution<float> dist{-10.0f, 10.0f};
+
+    return iris::Matrix4::make_translate({dist(rng), dist(rng), dist(rng)}) *
+           iris::Matrix4{iris::Quaternion{angle(rng), angle(rng), angle(rng)}} *
+           iris::Matrix4::make_scale({dist(rng), dist(rng), dist(rng)});
+}
+
+void expect_near(const iris::Quaternion &a, const iris::Quaternion &b)
+{
+    EXPECT_NEAR(a.w, b.w, 1e-6f);
+    EXPECT_NEAR(a.x, b.x, 1e-6f);
+    EXPECT_NEAR(a.y, b.y, 1e-6f);
+    EXPECT_NEAR(a.z, b.z, 1e-6f);
+}
+
+}
+
+TEST(batch_kernels, transform_points)
+{
+    std::mt19937 rng{1u};
+    const auto matrix = random_matrix(rng);
+    const auto points = random_points(rng);
+    std::vector<iris::Vector3> out(points.size());
+
+    iris::transform_points(matrix, points, out);
+
+    for (auto i = 0u; i < points.size(); ++i)
+    {
+        const auto expected = matrix * points[i];
+
+        ASSERT_EQ(out[i].x, expected.x);
+        ASSERT_EQ(out[i].y, expected.y);
+        ASSERT_EQ(out[i].z, expected.z);
+    }
+}
+
+TEST(batch_kernels, transform_points_in_place)
+{
+    std::mt19937 rng{2u};
+    const auto matrix = random_matrix(rng);
+    auto points = random_points(rng);
+    const auto original = points;
+
+    iris::transform_points(matrix, points, points);
+
+    for (auto i = 0u; i < points.size(); ++i)
+    {
+        ASSERT_EQ(points[i], matrix * original[i]);
+    }
+}
+
+TEST(batch_kernels, transform_points_soa)
+{
+    std::mt19937 rng{3u};
+    const auto matrix = random_matrix(rng);
+    const auto points = random_points(rng);
+
+    std::vector<float> x{};
+    std::vector<float> y{};
+    std::vector<float> z{};
+    for (const auto &point : points)
+    {
+        x.emplace_back(point.x);
+        y.emplace_back(point.y);
+        z.emplace_back(point.z);
+    }
+
+    iris::transform_points(matrix, {x, y, z}, {x, y, z});
+
+    for (auto i = 0u; i < points.size(); ++i)
+    {
+        const auto expected = matrix * points[i];
+
+        ASSERT_EQ(x[i], expected.x);
+        ASSERT_EQ(y[i], expected.y);
+        ASSERT_EQ(z[i], expected.z);
+    }
+}
+
+TEST(batch_kernels, transform_points_empty)
+{
+    iris::transform_points(iris::Matrix4{}, std::span<const iris::Vector3>{}, std::span<iris::Vector3>{});
+}
+
+TEST(batch_kernels, multiply_matrices)
+{
+    std::mt19937 rng{4u};
+    std::vector<iris::Matrix4> lhs{};
+    std::vector<iris::Matrix4> rhs{};
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        lhs.emplace_back(random_matrix(rng));
+        rhs.emplace_back(random_matrix(rng));
+    }
+
+    std::vector<iris::Matrix4> out(count);
+    iris::multiply_matrices(lhs, rhs, out);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        ASSERT_EQ(out[i], lhs[i] * rhs[i]);
+    }
+
+    iris::multiply_matrices(lhs.front(), rhs, out);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        ASSERT_EQ(out[i], lhs.front() * rhs[i]);
+    }
+}
+
+TEST(batch_kernels, multiply_matrices_aliased)
+{
+    std::mt19937 rng{5u};
+    std::vector<iris::Matrix4> matrices{};
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        matrices.emplace_back(random_matrix(rng));
+    }
+
+    const auto original = matrices;
+
+    // the common matrix is also the first output
+    iris::multiply_matrices(matrices.front(), matrices, matrices);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        ASSERT_EQ(matrices[i], original.front() * original[i]);
+    }
+}
+
+TEST(batch_kernels, normalise_quaternions)
+{
+    std::mt19937 rng{6u};
+    std::uniform_real_distribution<float> dist{-10.0f, 10.0f};
+    std::vector<iris::Quaternion> quaternions{};
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        quaternions.push_back({dist(rng), dist(rng), dist(rng), dist(rng)});
+    }
+
+    // zero quaternions become identity
+    quaternions[1] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    auto expected = quaternions;
+    for (auto &q : expected)
+    {
+        q.normalise();
+    }
+
+    std::vector<float> w{};
+    std::vector<float> x{};
+    std::vector<float> y{};
+    std::vector<float> z{};
+    for (const auto &q : quaternions)
+    {
+        w.emplace_back(q.w);
+        x.emplace_back(q.x);
+        y.emplace_back(q.y);
+        z.emplace_back(q.z);
+    }
+
+    iris::normalise_quaternions(quaternions);
+    iris::normalise_quaternions(iris::QuaternionSoaView{w, x, y, z});
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        ASSERT_EQ(quaternions[i], expected[i]);
+        ASSERT_EQ((iris::Quaternion{x[i], y[i], z[i], w[i]}), expected[i]);
+    }
+
+    ASSERT_EQ(quaternions[1], iris::Quaternion{});
+}
+
+TEST(batch_kernels, slerp_quaternions)
+{
+    std::mt19937 rng{7u};
+    const auto from = random_quaternions(rng);
+    auto to = random_quaternions(rng);
+
+    // nearly parallel, so uses the nlerp path
+    to[2] = from[2];
+    to[2].x += 0.001f;
+    to[2].normalise();
+
+    // opposite hemisphere, so takes the short way round
+    to[5] = -from[5];
+
+    for (const auto amount : {0.0f, 0.25f, 0.5f, 1.0f})
+    {
+        std::vector<iris::Quaternion> out(count);
+        iris::slerp_quaternions(from, to, amount, out);
+
+        std::vector<float> fw{}, fx{}, fy{}, fz{}, tw{}, tx{}, ty{}, tz{};
+        for (auto i = 0u; i < count; ++i)
+        {
+            fw.emplace_back(from[i].w);
+            fx.emplace_back(from[i].x);
+            fy.emplace_back(from[i].y);
+            fz.emplace_back(from[i].z);
+            tw.emplace_back(to[i].w);
+            tx.emplace_back(to[i].x);
+            ty.emplace_back(to[i].y);
+            tz.emplace_back(to[i].z);
+        }
+
+        std::vector<float> w(count), x(count), y(count), z(count);
+        iris::slerp_quaternions({fw, fx, fy, fz}, {tw, tx, ty, tz}, amount, {w, x, y, z});
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto expected = from[i];
+            expected.slerp(to[i], amount);
+
+            expect_near(out[i], expected);
+            expect_near({x[i], y[i], z[i], w[i]}, expected);
+        }
+    }
+}
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/frame_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+
+TEST(frame_arena, constructor)
+{
+    iris::FrameArena arena{1024u};
+
+    const auto stats = arena.stats();
+    ASSERT_EQ(stats.bytes_allocated, 0u);
+    ASSERT_EQ(stats.high_water_mark, 0u);
+    ASSERT_EQ(stats.capacity, 1024u);
+}
+
+TEST(frame_arena, constructor_invalid)
+{
+    ASSERT_THROW(iris::FrameArena{0u}, iris::Exception);
+}
+
+TEST(frame_arena, allocate_alignment)
+{
+    iris::FrameArena arena{1024u};
+
+    for (const auto alignment : {1u, 2u, 4u, 8u, 16u, 64u})
+    {
+        arena.allocate(1u, 1u);
+        const auto *ptr = arena.allocate(3u, alignment);
+
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0u);
+    }
+}
+
+TEST(frame_arena, allocate_is_contiguous)
+{
+    iris::FrameArena arena{1024u};
+
+    auto *first = static_cast<std::byte *>(arena.allocate(16u, 16u));
+    auto *second = static_cast<std::byte *>(arena.allocate(16u, 16u));
+
+    ASSERT_EQ(second, first + 16u);
+    ASSERT_EQ(arena.stats().bytes_allocated, 32u);
+}
+
+TEST(frame_arena, reset_reuses_memory)
+{
+    iris::FrameArena arena{1024u};
+
+    const auto *first = arena.allocate(100u);
+    arena.reset();
+    const auto *second = arena.allocate(100u);
+
+    ASSERT_EQ(first, second);
+}
+
+TEST(frame_arena, overflow_then_merge)
+{
+    iris::FrameArena arena{256u, false};
+
+    for (auto i = 0u; i < 10u; ++i)
+    {
+        arena.allocate(100u, 1u);
+    }
+
+    auto stats = arena.stats();
+    ASSERT_EQ(stats.bytes_allocated, 1000u);
+    ASSERT_EQ(stats.high_water_mark, 1000u);
+    ASSERT_GT(stats.capacity, 1000u);
+
+    arena.reset();
+
+    // the frame that overflowed should now fit in a single block
+    const auto capacity = arena.stats().capacity;
+    auto *first = static_cast<std::byte *>(arena.allocate(100u, 1u));
+    for (auto i = 1u; i < 10u; ++i)
+    {
+        ASSERT_EQ(arena.allocate(100u, 1u), first + (i * 100u));
+    }
+
+    stats = arena.stats();
+    ASSERT_EQ(stats.capacity, capacity);
+    ASSERT_EQ(stats.high_water_mark, 1000u);
+}
+
+TEST(frame_arena, allocation_larger_than_block)
+{
+    iris::FrameArena arena{64u};
+
+    auto *ptr = static_cast<std::byte *>(arena.allocate(1000u, 64u));
+    std::fill(ptr, ptr + 1000u, std::byte{0x1});
+
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64u, 0u);
+    ASSERT_GE(arena.stats().capacity, 1064u);
+}
+
+TEST(frame_arena, high_water_mark)
+{
+    iris::FrameArena arena{1024u};
+
+    arena.allocate(100u, 1u);
+    arena.reset();
+    arena.allocate(50u, 1u);
+
+    const auto stats = arena.stats();
+    ASSERT_EQ(stats.bytes_allocated, 50u);
+    ASSERT_EQ(stats.high_water_mark, 100u);
+}
+
+TEST(frame_arena, poison)
+{
+    iris::FrameArena arena{1024u, true};
+
+    auto *ptr = static_cast<std::uint8_t *>(arena.allocate(32u));
+    ASSERT_TRUE(std::all_of(ptr, ptr + 32u, [](auto b) { return b == iris::FrameArena::allocated_poison; }));
+
+    std::fill(ptr, ptr + 32u, std::uint8_t{0x1});
+    arena.reset();
+
+    ASSERT_TRUE(std::all_of(ptr, ptr + 32u, [](auto b) { return b == iris::FrameArena::reset_poison; }));
+}
+
+TEST(frame_arena, pmr_vector)
+{
+    iris::FrameArena arena{1024u};
+    std::pmr::vector<int> values{arena.resource()};
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        values.push_back(i);
+    }
+
+    ASSERT_EQ(values.size(), 10u);
+    ASSERT_EQ(values.back(), 9);
+    ASSERT_GT(arena.stats().bytes_allocated, 10u * sizeof(int));
+    ASSERT_TRUE(arena.resource()->is_equal(*arena.resource()));
+}
+
+TEST(frame_arena, thread_arena_reclaimed_on_advance)
+{
+    auto &arena = iris::this_thread_frame_arena();
+    ASSERT_EQ(&arena, &iris::this_thread_frame_arena());
+
+    arena.allocate(128u);
+    ASSERT_GE(arena.stats().bytes_allocated, 128u);
+
+    // reclaiming without a new frame does nothing
+    iris::reclaim_frame_arena();
+    ASSERT_GE(arena.stats().bytes_allocated, 128u);
+
+    iris::advance_frame();
+    ASSERT_EQ(arena.stats().bytes_allocated, 0u);
+}
+
+TEST(frame_arena, thread_arena_stats)
+{
+    std::thread::id id{};
+
+    std::thread thrd{[&id]()
+                     {
+                         id = std::this_thread::get_id();
+                         iris::this_thread_frame_arena().allocate(64u);
+
+                         const auto stats = iris::frame_arena_stats();
+                         const auto found = std::ranges::find_if(
+                             stats, [&id](const auto &element) { return element.thread == id; });
+
+                         ASSERT_NE(found, std::cend(stats));
+                         ASSERT_GE(found->stats.high_water_mark, 64u);
+                     }};
+    thrd.join();
+
+    // arena is unregistered when its thread exits
+    const auto stats = iris::frame_arena_stats();
+    ASSERT_TRUE(std::ranges::none_of(stats, [&id](const auto &element) { return element.thread == id; }));
+}
@@ -6,10 +6,12 @@
 
 #include <array>
 #include <cstring>
+#include <random>
 
 #include <gtest/gtest.h>
 
 #include "core/matrix4.h"
+#include "core/matrix4_kernels.h"
 #include "core/quaternion.h"
 #include "core/vector3.h"
 
@@ -586,3 +588,88 @@ TEST(matrix4, invert_round_trip)
 
     ASSERT_EQ(m * iris::Matrix4::invert(m), iris::Matrix4{});
 }
+
+TEST(matrix4, constant_evaluation)
+{
+    static constexpr auto m = iris::Matrix4::make_translate({1.0f, 2.0f, 3.0f}) * iris::Matrix4::make_scale({2.0f});
+    static constexpr auto inverse = iris::Matrix4::invert(m);
+    static constexpr auto transposed = iris::Matrix4::transpose(m);
+    static constexpr auto point = m * iris::Vector3{1.0f, 1.0f, 1.0f};
+
+    static_assert(inverse[0] == 0.5f);
+    static_assert(inverse[3] == -0.5f);
+    static_assert(transposed[12] == 1.0f);
+    static_assert(point.z == 5.0f);
+
+    ASSERT_EQ(m * inverse, iris::Matrix4{});
+}
+
+#if defined(IRIS_SIMD)
+
+namespace
+{
+
+/**
+ * Create a random matrix, with values in a range where the inverse is well conditioned.
+ */
+iris::matrix4_kernels::Elements random_matrix(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> dist{-10.0f, 10.0f};
+    iris::matrix4_kernels::Elements m{};
+
+    for (auto &e : m)
+    {
+        e = dist(rng);
+    }
+
+    // make it diagonally dominant so it's invertible
+    for (auto i = 0u; i < 16u; i += 5u)
+    {
+        m[i] += 50.0f;
+    }
+
+    return m;
+}
+
+}
+
+TEST(matrix4, simd_matches_scalar)
+{
+    std::mt19937 rng{1234u};
+
+    for (auto i = 0u; i < 1000u; ++i)
+    {
+        const auto a = random_matrix(rng);
+        const auto b = random_matrix(rng);
+        const iris::Vector3 v{a[0], b[0], a[1]};
+
+        // these perform the same operations in the same order, so must be identical
+        ASSERT_EQ(iris::matrix4_kernels::multiply_simd(a, b), iris::matrix4_kernels::multiply_scalar(a, b));
+        ASSERT_EQ(iris::matrix4_kernels::transpose_simd(a), iris::matrix4_kernels::transpose_scalar(a));
+
+        const auto simd_point = iris::matrix4_kernels::transform_simd(a, v);
+        const auto scalar_point = iris::matrix4_kernels::transform_scalar(a, v);
+        ASSERT_EQ(simd_point.x, scalar_point.x);
+        ASSERT_EQ(simd_point.y, scalar_point.y);
+        ASSERT_EQ(simd_point.z, scalar_point.z);
+
+        // invert shares intermediate results, so can differ by rounding
+        const iris::Matrix4 simd_inverse{iris::matrix4_kernels::invert_simd(a)};
+        const iris::Matrix4 scalar_inverse{iris::matrix4_kernels::invert_scalar(a)};
+        for (auto j = 0u; j < 16u; ++j)
+        {
+            ASSERT_NEAR(simd_inverse[j], scalar_inverse[j], 1e-6f);
+        }
+    }
+}
+
+TEST(matrix4, simd_invert_singular)
+{
+    const iris::matrix4_kernels::Elements m{
+        {1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 4.0f, 6.0f, 8.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f}};
+
+    // singular matrices give the adjugate, same as the scalar version
+    ASSERT_EQ(iris::matrix4_kernels::invert_simd(m), iris::matrix4_kernels::invert_scalar(m));
+}
+
+#endif
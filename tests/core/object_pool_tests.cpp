@@ -1,9 +1,18 @@
 #include "core/object_pool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "core/thread.h"
 #include "core/vector3.h"
+#include "jobs/spsc_ring.h"
 
 TEST(object_pool, single)
 {
@@ -104,3 +113,206 @@ TEST(object_pool, thread_safe_next)
     ASSERT_TRUE(std::all_of(
         std::cbegin(vec2), std::cend(vec2), [&vec2](const auto &element) { return vec2.front() == element; }));
 }
+
+TEST(object_pool, release_out_of_order)
+{
+    iris::ObjectPool<int, 3> pool{};
+
+    auto *i1 = pool.next(1);
+    auto *i2 = pool.next(2);
+    auto *i3 = pool.next(3);
+    pool.release(i1);
+    pool.release(i3);
+
+    // both released objects should be handed out again, and never the one still in use
+    const std::set<int *> reused{pool.next(4), pool.next(5)};
+
+    ASSERT_EQ(reused, (std::set<int *>{i1, i3}));
+    ASSERT_EQ(*i2, 2);
+    ASSERT_THROW(pool.next(), iris::Exception);
+}
+
+TEST(object_pool, release_all_then_drain)
+{
+    iris::ObjectPool<int, 100> pool{};
+    std::vector<int *> objects{};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        objects.emplace_back(pool.next(i));
+    }
+
+    std::ranges::reverse(objects);
+    for (auto *object : objects)
+    {
+        pool.release(object);
+    }
+
+    std::set<int *> unique{};
+    for (auto i = 0; i < 100; ++i)
+    {
+        unique.emplace(pool.next(i));
+    }
+
+    ASSERT_EQ(unique.size(), 100u);
+    ASSERT_THROW(pool.next(), iris::Exception);
+}
+
+TEST(object_pool, throwing_constructor)
+{
+    struct Throws
+    {
+        Throws(bool should_throw)
+        {
+            if (should_throw)
+            {
+                throw std::runtime_error("");
+            }
+        }
+    };
+
+    iris::ObjectPool<Throws, 1> pool{};
+
+    ASSERT_THROW(pool.next(true), std::runtime_error);
+    ASSERT_NO_THROW(pool.next(false));
+}
+
+TEST(object_pool, stress)
+{
+    static constexpr auto thread_count = 4u;
+    static constexpr auto iterations = 20000u;
+    static constexpr auto held = 16u;
+
+    // every thread repeatedly takes a batch of objects, stamps them with its id, checks no one else has touched them
+    // and then releases them out of order, if an object is ever handed out twice then the stamps will not match
+    iris::ObjectPool<std::uint32_t, thread_count * held> pool{};
+    std::atomic<bool> start = false;
+    std::atomic<std::uint32_t> failures = 0u;
+    std::vector<iris::Thread> threads{};
+
+    for (auto id = 0u; id < thread_count; ++id)
+    {
+        threads.emplace_back(
+            [&start, &failures, &pool, id]()
+            {
+                while (!start)
+                {
+                }
+
+                std::vector<std::uint32_t *> objects{};
+
+                for (auto i = 0u; i < iterations; ++i)
+                {
+                    objects.emplace_back(pool.next(id));
+
+                    if (objects.size() == held)
+                    {
+                        for (auto *object : objects)
+                        {
+                            if (*object != id)
+                            {
+                                ++failures;
+                            }
+                        }
+
+                        // release every other one first, then the rest
+                        for (auto j = 0u; j < objects.size(); j += 2u)
+                        {
+                            pool.release(objects[j]);
+                        }
+                        for (auto j = 1u; j < objects.size(); j += 2u)
+                        {
+                            pool.release(objects[j]);
+                        }
+
+                        objects.clear();
+                    }
+                }
+
+                for (auto *object : objects)
+                {
+                    pool.release(object);
+                }
+            });
+    }
+
+    start = true;
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(failures, 0u);
+
+    // everything was returned, so the whole pool should be available again
+    std::set<std::uint32_t *> unique{};
+    for (auto i = 0u; i < thread_count * held; ++i)
+    {
+        unique.emplace(pool.next(0u));
+    }
+
+    ASSERT_EQ(unique.size(), thread_count * held);
+}
+
+TEST(object_pool, stress_cross_thread_release)
+{
+    static constexpr auto count = 50000u;
+
+    // one thread takes objects and another releases them, so objects are always returned on a different thread to
+    // the one that took them
+    iris::ObjectPool<std::uint32_t, 64> pool{};
+    iris::SpscRing<std::uint32_t *> ring{64u};
+    std::atomic<std::uint32_t> failures = 0u;
+
+    iris::Thread producer = [&pool, &ring]()
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            std::uint32_t *object = nullptr;
+
+            // the pool may be momentarily drained while the consumer catches up
+            for (;;)
+            {
+                try
+                {
+                    object = pool.next(i);
+                    break;
+                }
+                catch (iris::Exception &)
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            while (!ring.try_push(object))
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    iris::Thread consumer = [&pool, &ring, &failures]()
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            std::uint32_t *object = nullptr;
+            while (!ring.try_pop(object))
+            {
+                std::this_thread::yield();
+            }
+
+            if (*object != i)
+            {
+                ++failures;
+            }
+
+            pool.release(object);
+        }
+    };
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(failures, 0u);
+}
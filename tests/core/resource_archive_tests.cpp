@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "core/archive_resource_manager.h"
+#include "core/exception.h"
+#include "core/resource_archive.h"
+#include "core/resource_view.h"
+
+namespace
+{
+
+/**
+ * Fixture which provides a path to write an archive to.
+ */
+class ResourceArchiveTests : public ::testing::Test
+{
+  protected:
+    ResourceArchiveTests()
+        : root_(std::filesystem::temp_directory_path() / "iris_resource_archive_tests")
+        , path_(root_ / "test.irpk")
+    {
+        std::filesystem::create_directories(root_);
+    }
+
+    ~ResourceArchiveTests() override
+    {
+        std::filesystem::remove_all(root_);
+    }
+
+    std::filesystem::path root_;
+    std::filesystem::path path_;
+};
+
+std::span<const std::byte> as_bytes(std::string_view value)
+{
+    return std::as_bytes(std::span{value});
+}
+
+std::string to_string(std::span<const std::byte> data)
+{
+    return {reinterpret_cast<const char *>(data.data()), data.size()};
+}
+
+}
+
+TEST_F(ResourceArchiveTests, round_trip)
+{
+    iris::ResourceArchiveWriter writer{};
+    writer.add("b.txt", as_bytes("bbb"));
+    writer.add("a/a.txt", as_bytes("hello world"));
+    writer.add("empty.txt", {});
+    writer.write(path_);
+
+    const iris::ResourceArchive archive{path_};
+
+    ASSERT_EQ(archive.size(), 3u);
+    ASSERT_TRUE(archive.contains("a/a.txt"));
+    ASSERT_FALSE(archive.contains("a"));
+    ASSERT_FALSE(archive.contains("c.txt"));
+    ASSERT_EQ(to_string(archive.read("a/a.txt")), "hello world");
+    ASSERT_EQ(to_string(archive.read("b.txt")), "bbb");
+    ASSERT_TRUE(archive.read("empty.txt").empty());
+}
+
+TEST_F(ResourceArchiveTests, data_aligned)
+{
+    iris::ResourceArchiveWriter writer{};
+    writer.add("a", as_bytes("x"));
+    writer.add("b", as_bytes("yyy"));
+    writer.write(path_);
+
+    const iris::ResourceArchive archive{path_};
+
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(archive.read("a").data()) % 16u, 0u);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(archive.read("b").data()) % 16u, 0u);
+}
+
+TEST_F(ResourceArchiveTests, compressed)
+{
+    const std::string repetitive(10000u, 'a');
+
+    iris::ResourceArchiveWriter writer{};
+    writer.add("compressed", as_bytes(repetitive), iris::ArchiveCompression::DEFLATE);
+    writer.add("incompressible", as_bytes("abc"), iris::ArchiveCompression::DEFLATE);
+    writer.write(path_);
+
+    ASSERT_LT(std::filesystem::file_size(path_), repetitive.size());
+
+    const iris::ResourceArchive archive{path_};
+
+    ASSERT_EQ(to_string(archive.read("compressed")), repetitive);
+    ASSERT_EQ(to_string(archive.read("incompressible")), "abc");
+}
+
+TEST_F(ResourceArchiveTests, view_outlives_archive)
+{
+    iris::ResourceArchiveWriter writer{};
+    writer.add("a.txt", as_bytes("hello"));
+    writer.write(path_);
+
+    iris::ResourceView view{};
+
+    {
+        const iris::ResourceArchive archive{path_};
+        view = archive.read("a.txt");
+    }
+
+    ASSERT_EQ(to_string(view), "hello");
+}
+
+TEST_F(ResourceArchiveTests, duplicate_entry)
+{
+    iris::ResourceArchiveWriter writer{};
+    writer.add("a.txt", as_bytes("1"));
+    writer.add("a.txt", as_bytes("2"));
+
+    ASSERT_THROW(writer.write(path_), iris::Exception);
+}
+
+TEST_F(ResourceArchiveTests, invalid_archive)
+{
+    std::ofstream{path_, std::ios::out | std::ios::binary} << "not an archive at all";
+
+    ASSERT_THROW(iris::ResourceArchive{path_}, iris::Exception);
+}
+
+TEST_F(ResourceArchiveTests, resource_manager)
+{
+    iris::ResourceArchiveWriter writer{};
+    writer.add("textures/a.png", as_bytes("png data"));
+    writer.write(path_);
+
+    iris::ArchiveResourceManager resource_manager{path_};
+
+    const auto view = resource_manager.load("textures/a.png");
+
+    ASSERT_EQ(to_string(view), "png data");
+    ASSERT_EQ(resource_manager.load("textures/a.png").data(), view.data());
+    ASSERT_THROW(resource_manager.load("textures/b.png"), iris::Exception);
+}
+
+TEST_F(ResourceArchiveTests, resource_manager_budget)
+{
+    const std::string repetitive(10000u, 'a');
+
+    iris::ResourceArchiveWriter writer{};
+    writer.add("mapped", as_bytes("mapped data"));
+    writer.add("compressed", as_bytes(repetitive), iris::ArchiveCompression::DEFLATE);
+    writer.write(path_);
+
+    iris::ArchiveResourceManager resource_manager{path_};
+
+    // uncompressed entries are views of the archive mapping, so they don't own their data or count towards the budget
+    const auto mapped = resource_manager.load("mapped");
+    ASSERT_FALSE(mapped.owns_data());
+    ASSERT_TRUE(resource_manager.load("compressed").owns_data());
+
+    auto stats = resource_manager.stats();
+    ASSERT_EQ(stats.resident_count, 2u);
+    ASSERT_EQ(stats.resident_bytes, repetitive.size());
+
+    // only the decompressed entry can be evicted
+    resource_manager.set_memory_budget(0u);
+
+    stats = resource_manager.stats();
+    ASSERT_EQ(stats.resident_count, 1u);
+    ASSERT_EQ(stats.resident_bytes, 0u);
+    ASSERT_EQ(stats.evictions, 1u);
+    ASSERT_EQ(resource_manager.load("mapped").data(), mapped.data());
+}
@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/data_buffer.h"
+#include "core/default_resource_manager.h"
+#include "core/exception.h"
+#include "core/mapped_file.h"
+#include "core/resource_cache_stats.h"
+#include "core/resource_view.h"
+#include "jobs/task.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+namespace
+{
+
+/**
+ * Fixture which creates a directory of files to load.
+ */
+class ResourceManagerTests : public ::testing::Test
+{
+  protected:
+    ResourceManagerTests()
+        : root_(std::filesystem::temp_directory_path() / "iris_resource_manager_tests")
+    {
+        std::filesystem::create_directories(root_);
+        write("hello.txt", "hello world");
+        write("empty.txt", "");
+        write("a.txt", std::string(100u, 'a'));
+        write("b.txt", std::string(100u, 'b'));
+        write("c.txt", std::string(100u, 'c'));
+    }
+
+    ~ResourceManagerTests() override
+    {
+        std::filesystem::remove_all(root_);
+    }
+
+    void write(const std::filesystem::path &name, std::string_view contents)
+    {
+        std::ofstream file{root_ / name, std::ios::out | std::ios::binary};
+        file.write(contents.data(), contents.size());
+    }
+
+    std::filesystem::path root_;
+};
+
+std::string to_string(std::span<const std::byte> data)
+{
+    return {reinterpret_cast<const char *>(data.data()), data.size()};
+}
+
+}
+
+TEST_F(ResourceManagerTests, mapped_file)
+{
+    const iris::MappedFile file{root_ / "hello.txt"};
+
+    ASSERT_EQ(file.size(), 11u);
+    ASSERT_EQ(to_string(file.data()), "hello world");
+}
+
+TEST_F(ResourceManagerTests, mapped_file_empty)
+{
+    const iris::MappedFile file{root_ / "empty.txt"};
+
+    ASSERT_EQ(file.size(), 0u);
+    ASSERT_TRUE(file.data().empty());
+}
+
+TEST_F(ResourceManagerTests, mapped_file_missing)
+{
+    ASSERT_THROW(iris::MappedFile{root_ / "missing.txt"}, iris::Exception);
+}
+
+TEST_F(ResourceManagerTests, view_from_buffer)
+{
+    const iris::DataBuffer buffer{std::byte{1}, std::byte{2}, std::byte{3}};
+    const iris::ResourceView view{buffer};
+
+    ASSERT_EQ(view.size(), 3u);
+    ASSERT_EQ(iris::DataBuffer(std::cbegin(view), std::cend(view)), buffer);
+}
+
+TEST_F(ResourceManagerTests, load)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+
+    const auto view = resource_manager.load("hello.txt");
+
+    ASSERT_EQ(to_string(view), "hello world");
+    ASSERT_TRUE(resource_manager.load("empty.txt").empty());
+}
+
+TEST_F(ResourceManagerTests, load_is_cached)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+
+    const auto first = resource_manager.load("hello.txt");
+    const auto second = resource_manager.load("hello.txt");
+
+    // both loads should be views of the same mapping
+    ASSERT_EQ(first.data(), second.data());
+}
+
+TEST_F(ResourceManagerTests, view_outlives_manager)
+{
+    iris::ResourceView view{};
+
+    {
+        iris::DefaultResourceManager resource_manager{};
+        resource_manager.set_root_directory(root_);
+        view = resource_manager.load("hello.txt");
+    }
+
+    ASSERT_EQ(to_string(view), "hello world");
+}
+
+TEST_F(ResourceManagerTests, load_missing)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+
+    ASSERT_THROW(resource_manager.load("missing.txt"), iris::Exception);
+}
+
+TEST_F(ResourceManagerTests, load_async)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+    iris::ThreadJobSystemManager jobs_manager{};
+    jobs_manager.create_job_system({.worker_count = 2u});
+
+    const auto view = iris::sync_wait(jobs_manager, resource_manager.load_async("hello.txt"));
+
+    ASSERT_EQ(to_string(view), "hello world");
+
+    // now cached, so should be the same data
+    ASSERT_EQ(iris::sync_wait(jobs_manager, resource_manager.load_async("hello.txt")).data(), view.data());
+    ASSERT_EQ(resource_manager.load("hello.txt").data(), view.data());
+}
+
+TEST_F(ResourceManagerTests, load_async_missing)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+    iris::ThreadJobSystemManager jobs_manager{};
+    jobs_manager.create_job_system({.worker_count = 2u});
+
+    ASSERT_THROW(iris::sync_wait(jobs_manager, resource_manager.load_async("missing.txt")), iris::Exception);
+
+    // failures are not cached
+    write("missing.txt", "found");
+    ASSERT_EQ(to_string(resource_manager.load("missing.txt")), "found");
+}
+
+TEST_F(ResourceManagerTests, concurrent_load)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+    iris::ThreadJobSystemManager jobs_manager{};
+    jobs_manager.create_job_system({.worker_count = 4u});
+
+    std::vector<iris::Task<iris::ResourceView>> tasks{};
+    for (auto i = 0u; i < 16u; ++i)
+    {
+        tasks.emplace_back(resource_manager.load_async("hello.txt"));
+    }
+
+    const auto load_all = [&]() -> iris::Task<>
+    {
+        co_await iris::when_all(jobs_manager, std::span{tasks});
+    };
+    iris::sync_wait(jobs_manager, load_all());
+
+    // every load should have shared the same mapping
+    const auto first = resource_manager.load("hello.txt");
+    for (auto &task : tasks)
+    {
+        ASSERT_TRUE(task.is_done());
+    }
+
+    const auto check_all = [&]() -> iris::Task<>
+    {
+        for (auto &task : tasks)
+        {
+            EXPECT_EQ((co_await task).data(), first.data());
+        }
+    };
+    iris::sync_wait(jobs_manager, check_all());
+}
+
+TEST_F(ResourceManagerTests, preload)
+{
+    std::vector<std::string> resources{};
+    for (auto i = 0u; i < 10u; ++i)
+    {
+        const auto name = "file" + std::to_string(i) + ".txt";
+        write(name, std::string(1000u * (i + 1u), 'x'));
+        resources.emplace_back(name);
+    }
+    resources.emplace_back("missing.txt");
+
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+
+    const auto handle = resource_manager.preload(resources);
+    handle.wait();
+
+    ASSERT_TRUE(handle.is_done());
+    ASSERT_EQ(handle.total(), 11u);
+    ASSERT_EQ(handle.completed(), 11u);
+    ASSERT_EQ(handle.failed(), 1u);
+    ASSERT_EQ(handle.bytes_loaded(), 55000u);
+    ASSERT_EQ(handle.progress(), 1.0f);
+    ASSERT_EQ(resource_manager.load("file9.txt").size(), 10000u);
+    ASSERT_THROW(resource_manager.load("missing.txt"), iris::Exception);
+}
+
+TEST_F(ResourceManagerTests, preload_empty)
+{
+    iris::DefaultResourceManager resource_manager{};
+
+    const auto handle = resource_manager.preload({});
+    handle.wait();
+
+    ASSERT_TRUE(handle.is_done());
+    ASSERT_EQ(handle.progress(), 1.0f);
+}
+
+TEST_F(ResourceManagerTests, stats)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+
+    resource_manager.load("a.txt");
+    resource_manager.load("a.txt");
+    resource_manager.load("b.txt");
+
+    const auto stats = resource_manager.stats();
+
+    ASSERT_EQ(stats.resident_bytes, 200u);
+    ASSERT_EQ(stats.resident_count, 2u);
+    ASSERT_EQ(stats.hits, 1u);
+    ASSERT_EQ(stats.misses, 2u);
+    ASSERT_EQ(stats.evictions, 0u);
+}
+
+TEST_F(ResourceManagerTests, evict_least_recently_used)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+    resource_manager.set_memory_budget(250u);
+
+    resource_manager.load("a.txt");
+    resource_manager.load("b.txt");
+    resource_manager.load("a.txt");
+    resource_manager.load("c.txt");
+
+    // b was least recently used
+    auto stats = resource_manager.stats();
+    ASSERT_EQ(stats.resident_bytes, 200u);
+    ASSERT_EQ(stats.evictions, 1u);
+
+    resource_manager.load("a.txt");
+    resource_manager.load("b.txt");
+
+    stats = resource_manager.stats();
+    ASSERT_EQ(stats.hits, 2u);
+    ASSERT_EQ(stats.misses, 4u);
+    ASSERT_EQ(stats.evictions, 2u);
+}
+
+TEST_F(ResourceManagerTests, in_use_not_evicted)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+
+    auto view = resource_manager.load("a.txt");
+    resource_manager.load("b.txt");
+    resource_manager.set_memory_budget(0u);
+
+    auto stats = resource_manager.stats();
+    ASSERT_EQ(stats.resident_count, 1u);
+    ASSERT_EQ(stats.resident_bytes, 100u);
+    ASSERT_EQ(resource_manager.load("a.txt").data(), view.data());
+
+    // once the view is gone it can be evicted
+    view = {};
+    resource_manager.set_memory_budget(0u);
+
+    ASSERT_EQ(resource_manager.stats().resident_count, 0u);
+}
+
+TEST_F(ResourceManagerTests, pinned_not_evicted)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+    resource_manager.set_memory_budget(0u);
+
+    const auto data = resource_manager.pin("a.txt").data();
+    resource_manager.pin("a.txt");
+    resource_manager.load("b.txt");
+
+    ASSERT_EQ(resource_manager.stats().resident_count, 1u);
+    ASSERT_EQ(resource_manager.load("a.txt").data(), data);
+
+    resource_manager.unpin("a.txt");
+    ASSERT_EQ(resource_manager.stats().resident_count, 1u);
+
+    resource_manager.unpin("a.txt");
+    ASSERT_EQ(resource_manager.stats().resident_count, 0u);
+}
+
+TEST_F(ResourceManagerTests, release)
+{
+    iris::DefaultResourceManager resource_manager{};
+    resource_manager.set_root_directory(root_);
+
+    const auto view = resource_manager.pin("a.txt");
+
+    ASSERT_TRUE(resource_manager.release("a.txt"));
+    ASSERT_FALSE(resource_manager.release("a.txt"));
+    ASSERT_FALSE(resource_manager.release("b.txt"));
+    ASSERT_EQ(resource_manager.stats().resident_bytes, 0u);
+
+    // existing views are still valid
+    ASSERT_EQ(to_string(view), std::string(100u, 'a'));
+}
@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "core/semaphore.h"
+
+TEST(semaphore, try_acquire_empty)
+{
+    iris::Semaphore semaphore{};
+
+    ASSERT_FALSE(semaphore.try_acquire());
+}
+
+TEST(semaphore, try_acquire_initial)
+{
+    iris::Semaphore semaphore{2};
+
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_FALSE(semaphore.try_acquire());
+}
+
+TEST(semaphore, try_acquire_after_release)
+{
+    iris::Semaphore semaphore{};
+
+    semaphore.release();
+
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_FALSE(semaphore.try_acquire());
+}
+
+TEST(semaphore, acquire_blocks_until_release)
+{
+    iris::Semaphore semaphore{};
+    std::atomic<bool> acquired = false;
+
+    std::thread thread{[&semaphore, &acquired]() {
+        semaphore.acquire();
+        acquired = true;
+    }};
+
+    semaphore.release();
+    thread.join();
+
+    ASSERT_TRUE(acquired);
+}
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/slot_map.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(slot_map, constructor)
+{
+    iris::SlotMap<int> map{};
+
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.size(), 0u);
+    ASSERT_EQ(map.begin(), map.end());
+    ASSERT_FALSE(map.contains(iris::SlotMapHandle{}));
+}
+
+TEST(slot_map, insert_and_get)
+{
+    iris::SlotMap<std::string> map{};
+
+    const auto h1 = map.insert("hello");
+    const auto h2 = map.emplace(3u, 'a');
+
+    ASSERT_EQ(map.size(), 2u);
+    ASSERT_NE(h1, h2);
+    ASSERT_TRUE(map.contains(h1));
+    ASSERT_TRUE(map.contains(h2));
+    ASSERT_EQ(map[h1], "hello");
+    ASSERT_EQ(*map.get(h2), "aaa");
+}
+
+TEST(slot_map, erase)
+{
+    iris::SlotMap<int> map{};
+
+    const auto h1 = map.insert(1);
+    const auto h2 = map.insert(2);
+    const auto h3 = map.insert(3);
+
+    ASSERT_TRUE(map.erase(h1));
+
+    ASSERT_EQ(map.size(), 2u);
+    ASSERT_FALSE(map.contains(h1));
+    ASSERT_EQ(map.get(h1), nullptr);
+    ASSERT_EQ(map[h2], 2);
+    ASSERT_EQ(map[h3], 3);
+
+    // erasing again does nothing
+    ASSERT_FALSE(map.erase(h1));
+    ASSERT_EQ(map.size(), 2u);
+}
+
+TEST(slot_map, erase_keeps_storage_packed)
+{
+    iris::SlotMap<int> map{};
+
+    const auto h1 = map.insert(1);
+    map.insert(2);
+    const auto h3 = map.insert(3);
+
+    map.erase(h1);
+
+    // last element is moved into the hole
+    ASSERT_EQ(std::vector<int>(map.begin(), map.end()), (std::vector<int>{3, 2}));
+    ASSERT_EQ(map.data(), &*map.begin());
+    ASSERT_EQ(map.position(h3), 0u);
+    ASSERT_EQ(map.handle(0u), h3);
+}
+
+TEST(slot_map, stale_handle_after_reuse)
+{
+    iris::SlotMap<int> map{};
+
+    const auto h1 = map.insert(1);
+    map.erase(h1);
+    const auto h2 = map.insert(2);
+
+    // slot is reused but the old handle is still detected as stale
+    ASSERT_EQ(h1.index, h2.index);
+    ASSERT_NE(h1.generation, h2.generation);
+    ASSERT_FALSE(map.contains(h1));
+    ASSERT_EQ(map.get(h1), nullptr);
+    ASSERT_EQ(map[h2], 2);
+}
+
+TEST(slot_map, move_only)
+{
+    iris::SlotMap<std::unique_ptr<int>> map{};
+
+    const auto h1 = map.insert(std::make_unique<int>(1));
+    const auto h2 = map.emplace(std::make_unique<int>(2));
+    map.erase(h1);
+
+    ASSERT_EQ(*map[h2], 2);
+}
+
+TEST(slot_map, swap_positions)
+{
+    iris::SlotMap<int> map{};
+
+    const auto h1 = map.insert(1);
+    const auto h2 = map.insert(2);
+    const auto h3 = map.insert(3);
+
+    map.swap_positions(h1, h3);
+
+    ASSERT_EQ(std::vector<int>(map.begin(), map.end()), (std::vector<int>{3, 2, 1}));
+    ASSERT_EQ(map[h1], 1);
+    ASSERT_EQ(map[h2], 2);
+    ASSERT_EQ(map[h3], 3);
+    ASSERT_EQ(map.position(h1), 2u);
+    ASSERT_EQ(map.handle(0u), h3);
+}
+
+TEST(slot_map, clear)
+{
+    iris::SlotMap<int> map{};
+
+    const auto h1 = map.insert(1);
+    const auto h2 = map.insert(2);
+    map.clear();
+
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contains(h1));
+    ASSERT_FALSE(map.contains(h2));
+
+    const auto h3 = map.insert(3);
+    ASSERT_EQ(map[h3], 3);
+}
+
+TEST(slot_map, throwing_constructor)
+{
+    struct Throws
+    {
+        Throws(bool should_throw)
+        {
+            if (should_throw)
+            {
+                throw std::runtime_error("");
+            }
+        }
+    };
+
+    iris::SlotMap<Throws> map{};
+    const auto h1 = map.emplace(false);
+
+    ASSERT_THROW(map.emplace(true), std::runtime_error);
+    ASSERT_EQ(map.size(), 1u);
+    ASSERT_TRUE(map.contains(h1));
+
+    const auto h2 = map.emplace(false);
+    ASSERT_EQ(map.size(), 2u);
+    ASSERT_TRUE(map.contains(h2));
+    ASSERT_EQ(map.position(h2), 1u);
+}
+
+TEST(slot_map, random_operations)
+{
+    // compare against a simple model, after every operation all live handles must find their value and all erased
+    // handles must be stale
+    iris::SlotMap<int> map{};
+    std::vector<std::pair<iris::SlotMapHandle, int>> live{};
+    std::vector<iris::SlotMapHandle> erased{};
+    std::mt19937 rng{42u};
+
+    for (auto i = 0; i < 2000; ++i)
+    {
+        if (live.empty() || (rng() % 3u != 0u))
+        {
+            live.emplace_back(map.insert(i), i);
+        }
+        else
+        {
+            const auto victim = rng() % live.size();
+            ASSERT_TRUE(map.erase(live[victim].first));
+            erased.emplace_back(live[victim].first);
+            live.erase(std::begin(live) + victim);
+        }
+
+        ASSERT_EQ(map.size(), live.size());
+    }
+
+    for (const auto &[handle, value] : live)
+    {
+        ASSERT_EQ(map[handle], value);
+        ASSERT_EQ(map.handle(map.position(handle)), handle);
+    }
+
+    for (const auto &handle : erased)
+    {
+        ASSERT_FALSE(map.contains(handle));
+    }
+}
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/transform.h"
+#include "core/transform_hierarchy.h"
+#include "core/vector3.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+namespace
+{
+
+iris::Transform translate(float x)
+{
+    return {{x, 0.0f, 0.0f}, {}, {1.0f}};
+}
+
+}
+
+TEST(transform_hierarchy, empty)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    ASSERT_EQ(hierarchy.size(), 0u);
+    ASSERT_FALSE(hierarchy.is_dirty());
+    ASSERT_FALSE(hierarchy.contains({}));
+}
+
+TEST(transform_hierarchy, create_root)
+{
+    iris::TransformHierarchy hierarchy{};
+    const iris::Transform local{{1.0f, 2.0f, 3.0f}, {{0.0f, 1.0f, 0.0f}, 0.5f}, {2.0f}};
+
+    const auto node = hierarchy.create(local);
+
+    ASSERT_TRUE(hierarchy.contains(node));
+    ASSERT_TRUE(hierarchy.is_dirty());
+    ASSERT_EQ(hierarchy.size(), 1u);
+    ASSERT_EQ(hierarchy.parent(node), iris::TransformNode{});
+    ASSERT_EQ(hierarchy.local(node), local);
+
+    hierarchy.update();
+
+    ASSERT_FALSE(hierarchy.is_dirty());
+    ASSERT_EQ(hierarchy.world(node), local.matrix());
+    ASSERT_EQ(hierarchy.normal(node), iris::Matrix4::make_normal_transform(local.matrix()));
+}
+
+TEST(transform_hierarchy, child_world)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto root = hierarchy.create(translate(1.0f));
+    const auto child = hierarchy.create(translate(2.0f), root);
+    const auto grandchild = hierarchy.create(translate(3.0f), child);
+
+    hierarchy.update();
+
+    ASSERT_EQ(hierarchy.parent(child), root);
+    ASSERT_EQ(hierarchy.parent(grandchild), child);
+    ASSERT_EQ(hierarchy.world(root), iris::Matrix4::make_translate({1.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(child), iris::Matrix4::make_translate({3.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(grandchild), iris::Matrix4::make_translate({6.0f, 0.0f, 0.0f}));
+}
+
+TEST(transform_hierarchy, set_local_propagates)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto root = hierarchy.create(translate(1.0f));
+    const auto child = hierarchy.create(translate(2.0f), root);
+    const auto other = hierarchy.create(translate(5.0f));
+    hierarchy.update();
+
+    hierarchy.set_local(root, translate(10.0f));
+
+    ASSERT_TRUE(hierarchy.is_dirty());
+
+    hierarchy.update();
+
+    ASSERT_EQ(hierarchy.world(root), iris::Matrix4::make_translate({10.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(child), iris::Matrix4::make_translate({12.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(other), iris::Matrix4::make_translate({5.0f, 0.0f, 0.0f}));
+}
+
+TEST(transform_hierarchy, world_before_update)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto root = hierarchy.create(translate(1.0f));
+    const auto child = hierarchy.create(translate(2.0f), root);
+    const auto grandchild = hierarchy.create(translate(3.0f), child);
+    hierarchy.update();
+
+    hierarchy.set_local(child, {{1.0f, 1.0f, 1.0f}, {{1.0f, 0.0f, 0.0f}, 0.3f}, {2.0f}});
+
+    const auto world = hierarchy.world(grandchild);
+    const auto normal = hierarchy.normal(grandchild);
+
+    hierarchy.update();
+
+    ASSERT_EQ(world, hierarchy.world(grandchild));
+    ASSERT_EQ(normal, hierarchy.normal(grandchild));
+}
+
+TEST(transform_hierarchy, world_before_update_skips_siblings)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto root = hierarchy.create(translate(1.0f));
+    const auto first = hierarchy.create(translate(2.0f), root);
+    hierarchy.create(translate(3.0f), first);
+    const auto second = hierarchy.create(translate(4.0f), root);
+    const auto grandchild = hierarchy.create(translate(5.0f), second);
+    hierarchy.update();
+
+    // walking down from the dirty root has to skip over the subtree of first
+    hierarchy.set_local(root, {{1.0f, 1.0f, 1.0f}, {{0.0f, 1.0f, 0.0f}, 0.5f}, {2.0f}});
+
+    const auto world = hierarchy.world(grandchild);
+
+    hierarchy.update();
+
+    ASSERT_EQ(world, hierarchy.world(grandchild));
+}
+
+TEST(transform_hierarchy, remove_reparents_children)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto root = hierarchy.create(translate(1.0f));
+    const auto child = hierarchy.create(translate(2.0f), root);
+    const auto grandchild1 = hierarchy.create(translate(3.0f), child);
+    const auto grandchild2 = hierarchy.create(translate(4.0f), child);
+    const auto other = hierarchy.create(translate(5.0f));
+    hierarchy.update();
+
+    hierarchy.remove(child);
+    hierarchy.update();
+
+    ASSERT_FALSE(hierarchy.contains(child));
+    ASSERT_EQ(hierarchy.size(), 4u);
+    ASSERT_EQ(hierarchy.parent(grandchild1), root);
+    ASSERT_EQ(hierarchy.parent(grandchild2), root);
+    ASSERT_EQ(hierarchy.world(grandchild1), iris::Matrix4::make_translate({4.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(grandchild2), iris::Matrix4::make_translate({5.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(other), iris::Matrix4::make_translate({5.0f, 0.0f, 0.0f}));
+
+    // removing again does nothing
+    hierarchy.remove(child);
+    ASSERT_EQ(hierarchy.size(), 4u);
+}
+
+TEST(transform_hierarchy, stale_handle_after_reuse)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto node1 = hierarchy.create(translate(1.0f));
+    hierarchy.remove(node1);
+    const auto node2 = hierarchy.create(translate(2.0f));
+
+    ASSERT_EQ(node1.id, node2.id);
+    ASSERT_FALSE(hierarchy.contains(node1));
+    ASSERT_TRUE(hierarchy.contains(node2));
+}
+
+TEST(transform_hierarchy, set_parent)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto a = hierarchy.create(translate(1.0f));
+    const auto a_child = hierarchy.create(translate(2.0f), a);
+    const auto b = hierarchy.create(translate(10.0f));
+    const auto b_child = hierarchy.create(translate(20.0f), b);
+    hierarchy.update();
+
+    // move a subtree forward
+    hierarchy.set_parent(a, b_child);
+    hierarchy.update();
+
+    ASSERT_EQ(hierarchy.parent(a), b_child);
+    ASSERT_EQ(hierarchy.world(a), iris::Matrix4::make_translate({31.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(a_child), iris::Matrix4::make_translate({33.0f, 0.0f, 0.0f}));
+
+    // move it back to being a root
+    hierarchy.set_parent(a, {});
+    hierarchy.update();
+
+    ASSERT_EQ(hierarchy.parent(a), iris::TransformNode{});
+    ASSERT_EQ(hierarchy.world(a), iris::Matrix4::make_translate({1.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(a_child), iris::Matrix4::make_translate({3.0f, 0.0f, 0.0f}));
+
+    // move a subtree backward
+    hierarchy.set_parent(b, a_child);
+    hierarchy.update();
+
+    ASSERT_EQ(hierarchy.world(b), iris::Matrix4::make_translate({13.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(b_child), iris::Matrix4::make_translate({33.0f, 0.0f, 0.0f}));
+
+    // new children go after existing ones
+    const auto c = hierarchy.create(translate(100.0f), a);
+    hierarchy.update();
+
+    ASSERT_EQ(hierarchy.world(c), iris::Matrix4::make_translate({101.0f, 0.0f, 0.0f}));
+    ASSERT_EQ(hierarchy.world(b_child), iris::Matrix4::make_translate({33.0f, 0.0f, 0.0f}));
+}
+
+TEST(transform_hierarchy, set_parent_to_descendant)
+{
+    iris::TransformHierarchy hierarchy{};
+
+    const auto root = hierarchy.create(translate(1.0f));
+    const auto child = hierarchy.create(translate(2.0f), root);
+
+    ASSERT_DEATH({ hierarchy.set_parent(root, child); }, "");
+    ASSERT_DEATH({ hierarchy.set_parent(root, root); }, "");
+}
+
+TEST(transform_hierarchy, parallel_update_matches_serial)
+{
+    iris::TransformHierarchy serial{};
+    iris::TransformHierarchy parallel{};
+    std::vector<iris::TransformNode> nodes{};
+
+    // a forest of small trees, with a mix of depths
+    for (auto i = 0u; i < 200u; ++i)
+    {
+        const iris::Transform local{
+            {static_cast<float>(i), 1.0f, 2.0f}, {{0.0f, 1.0f, 0.0f}, 0.01f * static_cast<float>(i)}, {1.1f}};
+        const auto parent = ((i % 5u) == 0u) ? iris::TransformNode{} : nodes[i - 1u - ((i % 5u) / 3u)];
+
+        nodes.emplace_back(serial.create(local, parent));
+        ASSERT_EQ(parallel.create(local, parent), nodes.back());
+    }
+
+    iris::ThreadJobSystemManager jobs_manager{};
+    jobs_manager.create_job_system({.worker_count = 4u});
+
+    for (auto frame = 0u; frame < 3u; ++frame)
+    {
+        for (auto i = frame; i < nodes.size(); i += 7u)
+        {
+            auto local = serial.local(nodes[i]);
+            local.set_translation(local.translation() + iris::Vector3{0.5f});
+
+            serial.set_local(nodes[i], local);
+            parallel.set_local(nodes[i], local);
+        }
+
+        serial.update();
+        parallel.update(jobs_manager);
+
+        ASSERT_FALSE(parallel.is_dirty());
+
+        for (const auto &node : nodes)
+        {
+            ASSERT_EQ(serial.world(node), parallel.world(node));
+            ASSERT_EQ(serial.normal(node), parallel.normal(node));
+        }
+    }
+}
@@ -17,6 +17,7 @@ TEST(concurrent_queue, constructor)
 {
     iris::ConcurrentQueue<int> q;
     ASSERT_TRUE(q.empty());
+    ASSERT_EQ(q.size(), 0u);
 }
 
 TEST(concurrent_queue, enqueue)
@@ -25,6 +26,7 @@ TEST(concurrent_queue, enqueue)
     q.enqueue(1);
 
     ASSERT_FALSE(q.empty());
+    ASSERT_EQ(q.size(), 1u);
 }
 
 TEST(concurrent_queue, try_dequeue)
@@ -6,11 +6,14 @@
 
 #include <gtest/gtest.h>
 
-#include <mutex>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
 #include <thread>
 
 #include "core/exception.h"
 #include "jobs/fiber/counter.h"
+#include "jobs/fiber/fiber.h"
 
 TEST(counter, constructor)
 {
@@ -59,3 +62,122 @@ TEST(counter, thread_safe)
 
     ASSERT_EQ(static_cast<int>(ctr), 0);
 }
+
+TEST(counter, decrement)
+{
+    iris::Counter ctr(2);
+
+    ASSERT_EQ(ctr.decrement(), nullptr);
+    ASSERT_EQ(static_cast<int>(ctr), 1);
+    ASSERT_EQ(ctr.decrement(), nullptr);
+    ASSERT_EQ(static_cast<int>(ctr), 0);
+}
+
+TEST(counter, add_waiter)
+{
+    iris::Counter ctr(1);
+    iris::Fiber fiber{nullptr};
+
+    ASSERT_TRUE(ctr.add_waiter(&fiber));
+}
+
+TEST(counter, add_waiter_zero)
+{
+    iris::Counter ctr(0);
+    iris::Fiber fiber{nullptr};
+
+    ASSERT_FALSE(ctr.add_waiter(&fiber));
+}
+
+TEST(counter, add_waiter_after_zero)
+{
+    iris::Counter ctr(1);
+    iris::Fiber fiber{nullptr};
+    ctr.decrement();
+
+    ASSERT_FALSE(ctr.add_waiter(&fiber));
+}
+
+TEST(counter, decrement_returns_waiters)
+{
+    iris::Counter ctr(2);
+    iris::Fiber fiber1{nullptr};
+    iris::Fiber fiber2{nullptr};
+
+    ASSERT_TRUE(ctr.add_waiter(&fiber1));
+    ASSERT_TRUE(ctr.add_waiter(&fiber2));
+    ASSERT_EQ(ctr.decrement(), nullptr);
+
+    auto *waiters = ctr.decrement();
+
+    ASSERT_EQ(waiters, &fiber2);
+    ASSERT_EQ(waiters->next_waiter(), &fiber1);
+    ASSERT_EQ(waiters->next_waiter()->next_waiter(), nullptr);
+}
+
+TEST(counter, waiters_thread_safe)
+{
+    static constexpr auto value = 10000;
+    iris::Counter ctr(value);
+    iris::Fiber fiber{nullptr};
+    std::atomic<int> woken = 0;
+
+    auto dec_thread = [&ctr, &woken]() {
+        for (auto i = 0; i < value / 4; ++i)
+        {
+            if (ctr.decrement() != nullptr)
+            {
+                ++woken;
+            }
+        }
+    };
+
+    std::thread thrd1{dec_thread};
+    std::thread thrd2{dec_thread};
+
+    const auto added = ctr.add_waiter(&fiber);
+
+    std::thread thrd3{dec_thread};
+    std::thread thrd4{dec_thread};
+
+    thrd1.join();
+    thrd2.join();
+    thrd3.join();
+    thrd4.join();
+
+    // the waiter is either handed back exactly once or the counter had already reached zero
+    ASSERT_EQ(woken, added ? 1 : 0);
+    ASSERT_EQ(static_cast<int>(ctr), 0);
+}
+
+TEST(counter, exception_none)
+{
+    iris::Counter ctr{1};
+    --ctr;
+
+    ASSERT_EQ(ctr.exception(), nullptr);
+}
+
+TEST(counter, exception_first_wins)
+{
+    iris::Counter ctr{2};
+
+    ctr.set_exception(std::make_exception_ptr(std::runtime_error("")));
+    --ctr;
+    ctr.set_exception(std::make_exception_ptr(std::logic_error("")));
+    --ctr;
+
+    ASSERT_THROW(std::rethrow_exception(ctr.exception()), std::runtime_error);
+}
+
+TEST(counter, increment)
+{
+    iris::Counter ctr{1};
+
+    ctr.increment(2);
+    ASSERT_EQ(ctr, 3);
+
+    --ctr;
+    --ctr;
+    ASSERT_EQ(ctr, 1);
+}
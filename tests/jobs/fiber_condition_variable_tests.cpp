@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/fiber/fiber_condition_variable.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_mutex.h"
+#include "jobs/job.h"
+
+TEST(fiber_condition_variable, notify_one)
+{
+    // single worker so the waiting fiber has to suspend for the notifying one to run
+    iris::FiberJobSystem js{1u};
+    iris::FiberMutex mutex{};
+    iris::FiberConditionVariable condition{};
+    auto ready = false;
+    auto value = 0;
+
+    js.wait_for_jobs(
+        {[&mutex, &condition, &ready, &value]()
+         {
+             std::unique_lock lock(mutex);
+             condition.wait(lock, [&ready]() { return ready; });
+             ++value;
+         },
+         [&mutex, &condition, &ready, &value]()
+         {
+             {
+                 std::unique_lock lock(mutex);
+                 value = 10;
+                 ready = true;
+             }
+
+             condition.notify_one();
+         }});
+
+    ASSERT_EQ(value, 11);
+}
+
+TEST(fiber_condition_variable, notify_all)
+{
+    iris::FiberJobSystem js{2u};
+    iris::FiberMutex mutex{};
+    iris::FiberConditionVariable condition{};
+    auto ready = false;
+    auto woken = 0;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < 10; ++i)
+    {
+        jobs.emplace_back(
+            [&mutex, &condition, &ready, &woken]()
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [&ready]() { return ready; });
+                ++woken;
+            });
+    }
+
+    jobs.emplace_back(
+        [&mutex, &condition, &ready]()
+        {
+            {
+                std::unique_lock lock(mutex);
+                ready = true;
+            }
+
+            condition.notify_all();
+        });
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(woken, 10);
+}
+
+TEST(fiber_condition_variable, thread_waits_on_fiber)
+{
+    iris::FiberJobSystem js{1u};
+    iris::FiberMutex mutex{};
+    iris::FiberConditionVariable condition{};
+    auto ready = false;
+
+    js.add_jobs({[&mutex, &condition, &ready]()
+                 {
+                     {
+                         std::unique_lock lock(mutex);
+                         ready = true;
+                     }
+
+                     condition.notify_one();
+                 }});
+
+    std::unique_lock lock(mutex);
+    condition.wait(lock, [&ready]() { return ready; });
+
+    ASSERT_TRUE(ready);
+}
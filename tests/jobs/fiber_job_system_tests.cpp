@@ -4,8 +4,206 @@
 //                 https://www.boost.org/LICENSE_1_0.txt)                     //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "jobs/job_system_manager_tests.h"
 #include "jobs/job_system_tests.h"
+#include "jobs/task_graph_tests.h"
+#include "jobs/task_tests.h"
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "allocation_counter.h"
 #include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_job_system_manager.h"
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/task_graph.h"
 
 INSTANTIATE_TYPED_TEST_SUITE_P(fiber, JobSystemTests, iris::FiberJobSystem);
+INSTANTIATE_TYPED_TEST_SUITE_P(fiber, JobSystemManagerTests, iris::FiberJobSystemManager);
+INSTANTIATE_TYPED_TEST_SUITE_P(fiber, TaskGraphTests, iris::FiberJobSystemManager);
+INSTANTIATE_TYPED_TEST_SUITE_P(fiber, TaskTests, iris::FiberJobSystemManager);
+
+TEST(fiber_job_system, fibers_are_recycled)
+{
+    iris::FiberJobSystem js{};
+    std::atomic<int> counter = 0;
+
+    js.wait_for_jobs({[&counter]() { ++counter; }});
+    js.wait_for_jobs({[&counter]() { ++counter; }});
+
+    const auto stats = js.fiber_pool_stats();
+
+    ASSERT_EQ(counter, 2);
+    ASSERT_GT(stats.hits, 0u);
+}
+
+TEST(fiber_job_system, wait_for_jobs_span_does_not_allocate)
+{
+    // a single worker means every child is acquired before any run, so the warm up fills the pool with enough fibers
+    iris::FiberJobSystem js{1u};
+    std::atomic<int> counter = 0;
+    std::size_t allocations = 0u;
+
+    js.wait_for_jobs({[&js, &counter, &allocations]() {
+        std::array<iris::InlineJob, 100u> jobs{};
+
+        const auto fill = [&jobs, &counter]()
+        {
+            for (auto &job : jobs)
+            {
+                job = [&counter]() { ++counter; };
+            }
+        };
+
+        fill();
+        js.wait_for_jobs(jobs);
+
+        fill();
+
+        AllocationCounter allocation_counter{};
+        js.wait_for_jobs(jobs);
+        allocations = allocation_counter.count();
+    }});
+
+    ASSERT_EQ(counter, 200);
+    ASSERT_EQ(allocations, 0u);
+}
+
+TEST(fiber_job_system, task_graph_run_does_not_allocate)
+{
+    iris::FiberJobSystemManager jsm{};
+    jsm.create_job_system();
+
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+    std::size_t allocations = 0u;
+
+    const auto source = graph.add_node([&counter]() { ++counter; });
+    const auto sink = graph.add_node([&counter]() { ++counter; });
+    for (auto i = 0; i < 4; ++i)
+    {
+        graph.add_edge(graph.add_continuation(source, [&counter]() { ++counter; }), sink);
+    }
+
+    jsm.wait({[&jsm, &graph, &allocations]() {
+        // fill the pool with more fibers than the graph can have live at once, then warm up the graph
+        std::vector<iris::Job> warm_up(64u, []() {});
+        jsm.wait(warm_up);
+        graph.run(jsm);
+
+        AllocationCounter allocation_counter{};
+        graph.run(jsm);
+        allocations = allocation_counter.count();
+    }});
+
+    ASSERT_EQ(counter, 12);
+    ASSERT_EQ(allocations, 0u);
+}
+
+TEST(fiber_job_system, higher_priority_jobs_run_first)
+{
+    // block the only worker whilst we queue jobs, so they are all waiting when it becomes free
+    iris::FiberJobSystem js{1u};
+    std::atomic<bool> started = false;
+    std::atomic<bool> release = false;
+    std::atomic<int> counter = 0;
+    std::vector<iris::JobPriority> order{};
+
+    js.add_jobs({[&started, &release]() {
+        started = true;
+        while (!release)
+        {
+        }
+    }});
+
+    while (!started)
+    {
+    }
+
+    const auto record = [&order, &counter](iris::JobPriority priority)
+    {
+        return [&order, &counter, priority]()
+        {
+            order.emplace_back(priority);
+            ++counter;
+        };
+    };
+
+    std::array<iris::InlineJob, 1u> background{{record(iris::JobPriority::BACKGROUND)}};
+    std::array<iris::InlineJob, 1u> normal{{record(iris::JobPriority::NORMAL)}};
+    std::array<iris::InlineJob, 1u> high{{record(iris::JobPriority::HIGH)}};
+
+    js.add_jobs(background, iris::JobPriority::BACKGROUND);
+    js.add_jobs(normal, iris::JobPriority::NORMAL);
+    js.add_jobs(high, iris::JobPriority::HIGH);
+
+    release = true;
+
+    while (counter != 3)
+    {
+    }
+
+    ASSERT_EQ(
+        order,
+        (std::vector<iris::JobPriority>{
+            iris::JobPriority::HIGH, iris::JobPriority::NORMAL, iris::JobPriority::BACKGROUND}));
+}
+
+TEST(fiber_job_system, worker_stats)
+{
+    iris::FiberJobSystem js{2u};
+    std::atomic<int> counter = 0;
+
+    js.wait_for_jobs({[&js, &counter]() {
+        js.wait_for_jobs({[&counter]() { ++counter; }, [&counter]() { ++counter; }});
+    }});
+
+    std::uint64_t jobs_run = 0u;
+    std::uint64_t suspended = 0u;
+    std::uint64_t resumed = 0u;
+    std::uint64_t queue_waits = 0u;
+
+    // the main thread is woken before the bootstrap job (which wraps the outer job) has finished and a suspend is
+    // counted after the fiber has switched out (so can briefly lag the resume), so wait for everything to be counted
+    do
+    {
+        jobs_run = suspended = resumed = queue_waits = 0u;
+
+        for (const auto &worker : js.worker_stats())
+        {
+            jobs_run += worker.jobs_run;
+            suspended += worker.fibers_suspended;
+            resumed += worker.fibers_resumed;
+
+            for (const auto bucket : worker.queue_wait)
+            {
+                queue_waits += bucket;
+            }
+        }
+    } while ((jobs_run != 4u) || (suspended != resumed));
+
+    ASSERT_EQ(js.worker_stats().size(), 2u);
+    ASSERT_EQ(counter, 2);
+    ASSERT_GE(suspended, 1u);
+    ASSERT_EQ(queue_waits, jobs_run + resumed);
+}
+
+TEST(fiber_job_system, chrome_trace)
+{
+    iris::FiberJobSystem js{1u};
+
+    js.start_trace();
+    js.wait_for_jobs({[]() {}, []() {}});
+    js.stop_trace();
+
+    const auto json = js.chrome_trace();
+
+    ASSERT_NE(json.find(R"("traceEvents":[)"), std::string::npos);
+    ASSERT_NE(json.find(R"("name":"job")"), std::string::npos);
+}
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_mutex.h"
+#include "jobs/job.h"
+
+TEST(fiber_mutex, try_lock)
+{
+    iris::FiberMutex mutex{};
+
+    ASSERT_TRUE(mutex.try_lock());
+    ASSERT_FALSE(mutex.try_lock());
+
+    mutex.unlock();
+    ASSERT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(fiber_mutex, contended)
+{
+    iris::FiberJobSystem js{4u};
+    iris::FiberMutex mutex{};
+    auto value = 0;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < 100; ++i)
+    {
+        jobs.emplace_back(
+            [&mutex, &value]()
+            {
+                for (auto j = 0; j < 100; ++j)
+                {
+                    std::unique_lock lock(mutex);
+                    ++value;
+                }
+            });
+    }
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(value, 10000);
+}
+
+TEST(fiber_mutex, waiting_does_not_block_worker)
+{
+    // with a single worker a blocking mutex would deadlock, as the job holding the lock waits on a child which can
+    // only run once the worker is free
+    iris::FiberJobSystem js{1u};
+    iris::FiberMutex mutex{};
+    std::vector<int> order{};
+
+    js.wait_for_jobs(
+        {[&js, &mutex, &order]()
+         {
+             std::unique_lock lock(mutex);
+             order.emplace_back(1);
+             js.wait_for_jobs({[&order]() { order.emplace_back(2); }});
+             order.emplace_back(3);
+         },
+         [&mutex, &order]()
+         {
+             std::unique_lock lock(mutex);
+             order.emplace_back(4);
+         }});
+
+    ASSERT_EQ(order.size(), 4u);
+
+    // whichever job got the lock first, the other's critical section must not have been interleaved with it
+    if (order.front() == 1)
+    {
+        ASSERT_EQ(order, (std::vector<int>{1, 2, 3, 4}));
+    }
+    else
+    {
+        ASSERT_EQ(order, (std::vector<int>{4, 1, 2, 3}));
+    }
+}
+
+TEST(fiber_mutex, thread_and_fiber)
+{
+    iris::FiberJobSystem js{2u};
+    iris::FiberMutex mutex{};
+    std::atomic<bool> started = false;
+    auto value = 0;
+
+    mutex.lock();
+
+    std::thread thrd{[&js, &mutex, &started, &value]()
+                     {
+                         js.wait_for_jobs({[&mutex, &started, &value]()
+                                           {
+                                               started = true;
+                                               std::unique_lock lock(mutex);
+                                               ++value;
+                                           }});
+                     }};
+
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    // the fiber is waiting on a lock held by a (non-fiber) thread
+    value = 10;
+    mutex.unlock();
+
+    thrd.join();
+
+    // and a (non-fiber) thread can lock once the fiber has finished
+    std::unique_lock lock(mutex);
+    ASSERT_EQ(value, 11);
+}
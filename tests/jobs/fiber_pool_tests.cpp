@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+#include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_pool.h"
+
+TEST(fiber_pool, constructor)
+{
+    iris::FiberPool pool{};
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(stats.hits, 0u);
+    ASSERT_EQ(stats.misses, 0u);
+    ASSERT_EQ(stats.live, 0u);
+    ASSERT_EQ(stats.peak_live, 0u);
+}
+
+TEST(fiber_pool, acquire_miss)
+{
+    iris::FiberPool pool{};
+    auto *fiber = pool.acquire([]() {});
+    const auto stats = pool.stats();
+
+    ASSERT_NE(fiber, nullptr);
+    ASSERT_EQ(fiber->stack_size(), iris::Fiber::default_stack_size);
+    ASSERT_EQ(stats.hits, 0u);
+    ASSERT_EQ(stats.misses, 1u);
+    ASSERT_EQ(stats.live, 1u);
+
+    pool.release(fiber);
+}
+
+TEST(fiber_pool, release_and_reuse)
+{
+    iris::FiberPool pool{};
+    auto *fiber1 = pool.acquire([]() {});
+    pool.release(fiber1);
+    auto *fiber2 = pool.acquire([]() {});
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(fiber1, fiber2);
+    ASSERT_EQ(stats.hits, 1u);
+    ASSERT_EQ(stats.misses, 1u);
+    ASSERT_EQ(stats.live, 1u);
+
+    pool.release(fiber2);
+}
+
+TEST(fiber_pool, peak_live)
+{
+    iris::FiberPool pool{};
+    auto *fiber1 = pool.acquire([]() {});
+    auto *fiber2 = pool.acquire([]() {});
+    auto *fiber3 = pool.acquire([]() {});
+    pool.release(fiber1);
+    pool.release(fiber2);
+    pool.release(fiber3);
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(stats.live, 0u);
+    ASSERT_EQ(stats.peak_live, 3u);
+}
+
+TEST(fiber_pool, max_pooled)
+{
+    iris::FiberPool pool{1u};
+    auto *fiber1 = pool.acquire([]() {});
+    auto *fiber2 = pool.acquire([]() {});
+    pool.release(fiber1);
+    pool.release(fiber2);
+
+    pool.acquire([]() {});
+    pool.acquire([]() {});
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(stats.hits, 1u);
+    ASSERT_EQ(stats.misses, 3u);
+}
+
+TEST(fiber_pool, stack_size_classes)
+{
+    iris::FiberPool pool{10u, {64u * 1024u, 16u * 1024u}};
+    auto *small = pool.acquire([]() {}, nullptr, 1024u);
+    auto *large = pool.acquire([]() {}, nullptr, 32u * 1024u);
+
+    ASSERT_EQ(small->stack_size(), 16u * 1024u);
+    ASSERT_EQ(large->stack_size(), 64u * 1024u);
+
+    pool.release(small);
+    pool.release(large);
+}
+
+TEST(fiber_pool, stack_size_too_large)
+{
+    iris::FiberPool pool{10u, {16u * 1024u}};
+
+    ASSERT_THROW(pool.acquire([]() {}, nullptr, 32u * 1024u), iris::Exception);
+}
+
+TEST(fiber_pool, thread_safe)
+{
+    static constexpr auto thread_count = 4u;
+    static constexpr auto iterations = 2000u;
+
+    // fewer slots than threads want at once, so the pool regularly fills and empties
+    iris::FiberPool pool{4u};
+    std::vector<std::thread> threads{};
+
+    for (auto i = 0u; i < thread_count; ++i)
+    {
+        threads.emplace_back(
+            [&pool]()
+            {
+                for (auto j = 0u; j < iterations; ++j)
+                {
+                    auto *fiber1 = pool.acquire([]() {});
+                    auto *fiber2 = pool.acquire([]() {});
+                    ASSERT_NE(fiber1, fiber2);
+
+                    pool.release(fiber1);
+                    pool.release(fiber2);
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto stats = pool.stats();
+    ASSERT_EQ(stats.live, 0u);
+    ASSERT_EQ(stats.hits + stats.misses, thread_count * iterations * 2u);
+}
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_semaphore.h"
+#include "jobs/job.h"
+
+TEST(fiber_semaphore, try_acquire)
+{
+    iris::FiberSemaphore semaphore{1};
+
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_FALSE(semaphore.try_acquire());
+
+    semaphore.release(2);
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_FALSE(semaphore.try_acquire());
+}
+
+TEST(fiber_semaphore, negative_initial_count)
+{
+    ASSERT_THROW(iris::FiberSemaphore{-1}, iris::Exception);
+}
+
+TEST(fiber_semaphore, waiting_does_not_block_worker)
+{
+    // single worker so if acquire blocked the thread the releasing job could never run
+    iris::FiberJobSystem js{1u};
+    iris::FiberSemaphore semaphore{};
+    std::atomic<int> acquired = 0;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < 5; ++i)
+    {
+        jobs.emplace_back(
+            [&semaphore, &acquired]()
+            {
+                semaphore.acquire();
+                ++acquired;
+            });
+    }
+
+    jobs.emplace_back([&semaphore]() { semaphore.release(5); });
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(acquired, 5);
+    ASSERT_FALSE(semaphore.try_acquire());
+}
+
+TEST(fiber_semaphore, thread_waits_on_fiber)
+{
+    iris::FiberJobSystem js{1u};
+    iris::FiberSemaphore semaphore{};
+
+    js.add_jobs({[&semaphore]() { semaphore.release(); }});
+
+    semaphore.acquire();
+
+    ASSERT_FALSE(semaphore.try_acquire());
+}
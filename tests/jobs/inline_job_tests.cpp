@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "allocation_counter.h"
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+
+static_assert(!std::is_copy_constructible_v<iris::InlineJob>);
+static_assert(std::is_nothrow_move_constructible_v<iris::InlineJob>);
+
+TEST(inline_job, constructor_empty)
+{
+    iris::InlineJob job{};
+
+    ASSERT_FALSE(job);
+}
+
+TEST(inline_job, constructor_nullptr)
+{
+    iris::InlineJob job{nullptr};
+
+    ASSERT_FALSE(job);
+}
+
+TEST(inline_job, constructor_callable)
+{
+    auto called = false;
+    iris::InlineJob job{[&called]() { called = true; }};
+
+    ASSERT_TRUE(job);
+
+    job();
+
+    ASSERT_TRUE(called);
+}
+
+TEST(inline_job, constructor_job)
+{
+    auto called = false;
+    iris::Job function = [&called]() { called = true; };
+    iris::InlineJob job{function};
+
+    job();
+
+    ASSERT_TRUE(called);
+}
+
+TEST(inline_job, move_constructor)
+{
+    auto called = false;
+    iris::InlineJob job1{[&called]() { called = true; }};
+    iris::InlineJob job2{std::move(job1)};
+
+    ASSERT_FALSE(job1);
+    ASSERT_TRUE(job2);
+
+    job2();
+
+    ASSERT_TRUE(called);
+}
+
+TEST(inline_job, move_assignment)
+{
+    auto value = 0;
+    auto capture = std::make_shared<int>(0);
+
+    iris::InlineJob job1{[&value]() { value = 1; }};
+    iris::InlineJob job2{[capture]() {}};
+
+    job2 = std::move(job1);
+
+    ASSERT_FALSE(job1);
+    ASSERT_EQ(capture.use_count(), 1);
+
+    job2();
+
+    ASSERT_EQ(value, 1);
+}
+
+TEST(inline_job, destructor_releases_capture)
+{
+    auto capture = std::make_shared<int>(0);
+
+    {
+        iris::InlineJob job{[capture]() {}};
+        ASSERT_EQ(capture.use_count(), 2);
+    }
+
+    ASSERT_EQ(capture.use_count(), 1);
+}
+
+TEST(inline_job, does_not_allocate)
+{
+    // largest capture that fits, including the reference to sum
+    std::array<std::uint64_t, (iris::InlineJob::capacity / sizeof(std::uint64_t)) - 1u> values{};
+    std::uint64_t sum = 0u;
+
+    AllocationCounter allocation_counter{};
+
+    iris::InlineJob job1{[values, &sum]() mutable {
+        values.back() = 1u;
+        sum = values.back();
+    }};
+
+    iris::InlineJob job2{std::move(job1)};
+    job2();
+
+    ASSERT_EQ(allocation_counter.count(), 0u);
+    ASSERT_EQ(sum, 1u);
+}
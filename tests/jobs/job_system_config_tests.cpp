@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+#include "jobs/job_system_config.h"
+
+TEST(job_system_config, parse_defaults)
+{
+    const auto config = iris::parse_job_system_config({"program", "--unrelated=1"});
+
+    ASSERT_EQ(config.worker_count, 0u);
+    ASSERT_TRUE(config.reserved_cores.empty());
+    ASSERT_TRUE(config.worker_affinity.empty());
+    ASSERT_TRUE(config.worker_names.empty());
+    ASSERT_FALSE(config.pin_workers);
+}
+
+TEST(job_system_config, parse_all)
+{
+    const auto config = iris::parse_job_system_config(
+        {"program",
+         "--jobs-workers=3",
+         "--jobs-reserve=0,1",
+         "--jobs-affinity=2,3//4",
+         "--jobs-names=render,,audio",
+         "--jobs-pin"});
+
+    ASSERT_EQ(config.worker_count, 3u);
+    ASSERT_EQ(config.reserved_cores, (std::vector<std::size_t>{0u, 1u}));
+    ASSERT_EQ(config.worker_affinity, (std::vector<std::vector<std::size_t>>{{2u, 3u}, {}, {4u}}));
+    ASSERT_EQ(config.worker_names, (std::vector<std::string>{"render", "", "audio"}));
+    ASSERT_TRUE(config.pin_workers);
+}
+
+TEST(job_system_config, parse_invalid_number)
+{
+    ASSERT_THROW(iris::parse_job_system_config({"--jobs-workers=two"}), iris::Exception);
+    ASSERT_THROW(iris::parse_job_system_config({"--jobs-reserve=0,x"}), iris::Exception);
+    ASSERT_THROW(iris::parse_job_system_config({"--jobs-workers=-1"}), iris::Exception);
+}
+
+TEST(job_system_config, resolve_default)
+{
+    const auto layout = iris::resolve_worker_layout({}, 8u);
+
+    ASSERT_EQ(layout.size(), 7u);
+    for (auto i = 0u; i < layout.size(); ++i)
+    {
+        ASSERT_EQ(layout[i].name, "iris worker " + std::to_string(i));
+        ASSERT_TRUE(layout[i].cores.empty());
+    }
+}
+
+TEST(job_system_config, resolve_single_core)
+{
+    const auto layout = iris::resolve_worker_layout({}, 1u);
+
+    ASSERT_EQ(layout.size(), 1u);
+}
+
+TEST(job_system_config, resolve_reserved)
+{
+    const auto layout = iris::resolve_worker_layout({.reserved_cores = {0u, 3u}}, 4u);
+
+    ASSERT_EQ(layout.size(), 2u);
+    for (const auto &worker : layout)
+    {
+        ASSERT_EQ(worker.cores, (std::vector<std::size_t>{1u, 2u}));
+    }
+}
+
+TEST(job_system_config, resolve_pinned)
+{
+    const auto layout =
+        iris::resolve_worker_layout({.worker_count = 3u, .reserved_cores = {0u}, .pin_workers = true}, 3u);
+
+    ASSERT_EQ(layout.size(), 3u);
+    ASSERT_EQ(layout[0].cores, (std::vector<std::size_t>{1u}));
+    ASSERT_EQ(layout[1].cores, (std::vector<std::size_t>{2u}));
+    ASSERT_EQ(layout[2].cores, (std::vector<std::size_t>{1u}));
+}
+
+TEST(job_system_config, resolve_explicit)
+{
+    const auto layout = iris::resolve_worker_layout(
+        {.worker_count = 2u, .worker_affinity = {{3u, 1u, 3u}}, .worker_names = {"", "audio"}, .pin_workers = true},
+        4u);
+
+    ASSERT_EQ(layout.size(), 2u);
+    ASSERT_EQ(layout[0].name, "iris worker 0");
+    ASSERT_EQ(layout[0].cores, (std::vector<std::size_t>{1u, 3u}));
+    ASSERT_EQ(layout[1].name, "audio");
+    ASSERT_EQ(layout[1].cores, (std::vector<std::size_t>{1u}));
+}
+
+TEST(job_system_config, resolve_invalid)
+{
+    ASSERT_THROW(iris::resolve_worker_layout({.reserved_cores = {4u}}, 4u), iris::Exception);
+    ASSERT_THROW(iris::resolve_worker_layout({.reserved_cores = {0u, 1u}}, 2u), iris::Exception);
+    ASSERT_THROW(iris::resolve_worker_layout({.worker_affinity = {{4u}}}, 4u), iris::Exception);
+    ASSERT_THROW(
+        iris::resolve_worker_layout({.reserved_cores = {1u}, .worker_affinity = {{1u}}}, 4u), iris::Exception);
+    ASSERT_THROW(iris::resolve_worker_layout({.worker_count = 1u, .worker_names = {"a", "b"}}, 4u), iris::Exception);
+}
+
+TEST(job_system_config, stream)
+{
+    std::stringstream strm{};
+    strm << iris::WorkerLayout{.name = "a", .cores = {}} << ' ' << iris::WorkerLayout{.name = "b", .cores = {1u, 2u}};
+
+    ASSERT_EQ(strm.str(), "a [any] b [1,2]");
+}
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <jobs/job_system_manager.h>
+
+#include <gtest/gtest.h>
+
+template <class T>
+class JobSystemManagerTests : public ::testing::Test
+{
+  protected:
+    JobSystemManagerTests()
+        : jsm_()
+    {
+        jsm_.create_job_system();
+    }
+
+    T jsm_;
+};
+
+TYPED_TEST_SUITE_P(JobSystemManagerTests);
+
+TYPED_TEST_P(JobSystemManagerTests, worker_count)
+{
+    ASSERT_GT(this->jsm_.worker_count(), 0u);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, worker_layout)
+{
+    TypeParam jsm{};
+    jsm.create_job_system({.worker_count = 2u, .worker_names = {"first"}, .pin_workers = true});
+
+    const auto layout = jsm.worker_layout();
+
+    ASSERT_EQ(jsm.worker_count(), 2u);
+    ASSERT_EQ(layout.size(), 2u);
+    ASSERT_EQ(layout[0].name, "first");
+    ASSERT_EQ(layout[0].cores, std::vector<std::size_t>{0u});
+    ASSERT_EQ(layout[1].name, "iris worker 1");
+    ASSERT_EQ(layout[1].cores.size(), 1u);
+
+    // check the pinned workers still run jobs
+    std::atomic<int> counter = 0;
+    jsm.parallel_for(0u, 100u, 1u, [&counter](std::size_t) { ++counter; });
+
+    ASSERT_EQ(counter, 100);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_for_empty)
+{
+    auto called = false;
+
+    this->jsm_.parallel_for(10u, 10u, 1u, [&called](std::size_t) { called = true; });
+
+    ASSERT_FALSE(called);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_for_index)
+{
+    std::vector<std::atomic<int>> visited(10000u);
+
+    this->jsm_.parallel_for(0u, visited.size(), 16u, [&visited](std::size_t index) { ++visited[index]; });
+
+    for (const auto &count : visited)
+    {
+        ASSERT_EQ(count, 1);
+    }
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_for_range)
+{
+    static constexpr std::size_t grain = 100u;
+    std::atomic<std::size_t> total = 0u;
+    std::atomic<bool> too_small = false;
+
+    this->jsm_.parallel_for(
+        5u,
+        10005u,
+        grain,
+        [&total, &too_small](std::size_t begin, std::size_t end)
+        {
+            // only the last chunk may be smaller than the grain
+            if (((end - begin) < grain) && (end != 10005u))
+            {
+                too_small = true;
+            }
+
+            total += end - begin;
+        });
+
+    ASSERT_EQ(total, 10000u);
+    ASSERT_FALSE(too_small);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_for_single_chunk)
+{
+    const auto caller = std::this_thread::get_id();
+    std::thread::id runner{};
+
+    this->jsm_.parallel_for(0u, 10u, 10u, [&runner](std::size_t, std::size_t) { runner = std::this_thread::get_id(); });
+
+    ASSERT_EQ(runner, caller);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_for_exception)
+{
+    ASSERT_THROW(
+        this->jsm_.parallel_for(
+            0u,
+            1000u,
+            1u,
+            [](std::size_t index)
+            {
+                if (index == 500u)
+                {
+                    throw std::runtime_error("");
+                }
+            }),
+        std::runtime_error);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_reduce_empty)
+{
+    const auto result = this->jsm_.parallel_reduce(
+        0u, 0u, 1u, 42, [](std::size_t) { return 1; }, [](int a, int b) { return a + b; });
+
+    ASSERT_EQ(result, 42);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_reduce_index)
+{
+    const auto result = this->jsm_.parallel_reduce(
+        0u,
+        10000u,
+        16u,
+        std::size_t{0u},
+        [](std::size_t index) { return index; },
+        [](std::size_t a, std::size_t b) { return a + b; });
+
+    ASSERT_EQ(result, 49995000u);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_reduce_range)
+{
+    const auto result = this->jsm_.parallel_reduce(
+        0u,
+        10000u,
+        16u,
+        std::size_t{0u},
+        [](std::size_t begin, std::size_t end) { return end - begin; },
+        [](std::size_t a, std::size_t b) { return a + b; });
+
+    ASSERT_EQ(result, 10000u);
+}
+
+TYPED_TEST_P(JobSystemManagerTests, parallel_reduce_ordered)
+{
+    // string concatenation is not commutative, so this checks chunks are combined in order
+    const auto result = this->jsm_.parallel_reduce(
+        0u,
+        26u,
+        1u,
+        std::string{},
+        [](std::size_t index) { return std::string(1u, static_cast<char>('a' + index)); },
+        [](std::string a, const std::string &b) { return a + b; });
+
+    ASSERT_EQ(result, "abcdefghijklmnopqrstuvwxyz");
+}
+
+REGISTER_TYPED_TEST_SUITE_P(
+    JobSystemManagerTests,
+    worker_count,
+    worker_layout,
+    parallel_for_empty,
+    parallel_for_index,
+    parallel_for_range,
+    parallel_for_single_chunk,
+    parallel_for_exception,
+    parallel_reduce_empty,
+    parallel_reduce_index,
+    parallel_reduce_range,
+    parallel_reduce_ordered);
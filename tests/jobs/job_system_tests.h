@@ -4,10 +4,15 @@
 //                 https://www.boost.org/LICENSE_1_0.txt)                     //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <array>
 #include <atomic>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 
+#include <jobs/idle_policy.h>
+#include <jobs/inline_job.h>
+#include <jobs/job_priority.h>
 #include <jobs/job_system.h>
 
 #include <gtest/gtest.h>
@@ -76,6 +81,76 @@ TYPED_TEST_P(JobSystemTests, wait_for_jobs_multiple)
     ASSERT_EQ(counter, 4);
 }
 
+TYPED_TEST_P(JobSystemTests, wait_for_jobs_fan_out)
+{
+    std::atomic<int> counter = 0;
+
+    this->js_.wait_for_jobs({[&counter, this]() {
+        std::vector<iris::Job> jobs{};
+
+        for (auto i = 0; i < 500; ++i)
+        {
+            jobs.emplace_back([&counter]() { ++counter; });
+        }
+
+        this->js_.wait_for_jobs(jobs);
+    }});
+
+    ASSERT_EQ(counter, 500);
+}
+
+TYPED_TEST_P(JobSystemTests, add_jobs_span)
+{
+    std::atomic<int> counter = 0;
+
+    std::array<iris::InlineJob, 4u> jobs{
+        {[&counter]() { ++counter; },
+         [&counter]() { ++counter; },
+         [&counter]() { ++counter; },
+         [&counter]() { ++counter; }}};
+
+    this->js_.add_jobs(jobs);
+
+    while (counter != 4)
+    {
+    }
+
+    ASSERT_EQ(counter, 4);
+}
+
+TYPED_TEST_P(JobSystemTests, wait_for_jobs_span)
+{
+    std::atomic<int> counter = 0;
+
+    std::array<iris::InlineJob, 4u> jobs{
+        {[&counter]() { ++counter; },
+         [&counter]() { ++counter; },
+         [&counter]() { ++counter; },
+         [&counter]() { ++counter; }}};
+
+    this->js_.wait_for_jobs(jobs);
+
+    ASSERT_EQ(counter, 4);
+}
+
+TYPED_TEST_P(JobSystemTests, wait_for_jobs_span_nested)
+{
+    std::atomic<int> counter = 0;
+
+    this->js_.wait_for_jobs({[&counter, this]() {
+        std::array<iris::InlineJob, 100u> jobs{};
+
+        for (auto &job : jobs)
+        {
+            job = [&counter]() { ++counter; };
+        }
+
+        this->js_.wait_for_jobs(jobs);
+    }});
+
+    ASSERT_EQ(counter, 100);
+}
+
 TYPED_TEST_P(JobSystemTests, wait_for_jobs_nested)
 {
     std::atomic<int> counter = 0;
@@ -132,14 +207,182 @@ TYPED_TEST_P(JobSystemTests, exceptions_propagate_first_job)
         std::runtime_error);
 }
 
+TYPED_TEST_P(JobSystemTests, exceptions_propagate_span)
+{
+    std::array<iris::InlineJob, 2u> jobs{{[]() {}, []() { throw std::runtime_error(""); }}};
+
+    ASSERT_THROW(this->js_.wait_for_jobs(jobs), std::runtime_error);
+}
+
+TYPED_TEST_P(JobSystemTests, add_jobs_priority)
+{
+    std::atomic<int> counter = 0;
+
+    std::array<iris::InlineJob, 1u> high{{[&counter]() { ++counter; }}};
+    std::array<iris::InlineJob, 1u> background{{[&counter]() { ++counter; }}};
+
+    this->js_.add_jobs(high, iris::JobPriority::HIGH);
+    this->js_.add_jobs(background, iris::JobPriority::BACKGROUND);
+
+    while (counter != 2)
+    {
+    }
+
+    ASSERT_EQ(counter, 2);
+}
+
+TYPED_TEST_P(JobSystemTests, wait_for_jobs_priority)
+{
+    std::atomic<int> counter = 0;
+
+    this->js_.wait_for_jobs({[&counter, this]() {
+        std::array<iris::InlineJob, 2u> jobs{{[&counter]() { ++counter; }, [&counter]() { ++counter; }}};
+        this->js_.wait_for_jobs(jobs, iris::JobPriority::BACKGROUND);
+    }});
+
+    std::array<iris::InlineJob, 1u> jobs{{[&counter]() { ++counter; }}};
+    this->js_.wait_for_jobs(jobs, iris::JobPriority::HIGH);
+
+    ASSERT_EQ(counter, 3);
+}
+
+TYPED_TEST_P(JobSystemTests, add_continuation_jobs)
+{
+    std::atomic<int> counter = 0;
+
+    this->js_.wait_for_jobs({[&counter, this]() {
+        std::array<iris::InlineJob, 2u> jobs{
+            {[&counter]() {
+                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                 ++counter;
+             },
+             [&counter]() { ++counter; }}};
+
+        this->js_.add_continuation_jobs(jobs);
+    }});
+
+    ASSERT_EQ(counter, 2);
+}
+
+TYPED_TEST_P(JobSystemTests, add_continuation_jobs_nested)
+{
+    std::atomic<int> counter = 0;
+
+    this->js_.wait_for_jobs({[&counter, this]() {
+        std::array<iris::InlineJob, 1u> jobs{{[&counter, this]() {
+            std::array<iris::InlineJob, 1u> jobs{{[&counter]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                ++counter;
+            }}};
+
+            this->js_.add_continuation_jobs(jobs);
+            ++counter;
+        }}};
+
+        this->js_.add_continuation_jobs(jobs);
+    }});
+
+    ASSERT_EQ(counter, 2);
+}
+
+TYPED_TEST_P(JobSystemTests, add_continuation_jobs_exception)
+{
+    ASSERT_THROW(
+        this->js_.wait_for_jobs({[this]() {
+            std::array<iris::InlineJob, 1u> jobs{{[]() { throw std::runtime_error(""); }}};
+            this->js_.add_continuation_jobs(jobs);
+        }}),
+        std::runtime_error);
+}
+
+TYPED_TEST_P(JobSystemTests, add_continuation_jobs_fire_and_forget)
+{
+    std::atomic<int> counter = 0;
+
+    std::array<iris::InlineJob, 1u> jobs{{[&counter]() { ++counter; }}};
+    this->js_.add_continuation_jobs(jobs);
+
+    while (counter != 1)
+    {
+    }
+
+    ASSERT_EQ(counter, 1);
+}
+
+TYPED_TEST_P(JobSystemTests, main_thread_jobs)
+{
+    std::atomic<int> counter = 0;
+    const auto main_thread = std::this_thread::get_id();
+    auto on_main_thread = false;
+
+    this->js_.wait_for_jobs({[&, this]() {
+        this->js_.add_main_thread_jobs({[&]() {
+            on_main_thread = std::this_thread::get_id() == main_thread;
+            ++counter;
+        }});
+    }});
+
+    ASSERT_EQ(counter, 0);
+    ASSERT_EQ(this->js_.queue_depths().main_thread, 1u);
+
+    ASSERT_EQ(this->js_.run_main_thread_jobs(), 1u);
+    ASSERT_EQ(counter, 1);
+    ASSERT_TRUE(on_main_thread);
+    ASSERT_EQ(this->js_.queue_depths().main_thread, 0u);
+}
+
+TYPED_TEST_P(JobSystemTests, queue_depths_idle)
+{
+    const auto depths = this->js_.queue_depths();
+
+    ASSERT_EQ(depths.high, 0u);
+    ASSERT_EQ(depths.normal, 0u);
+    ASSERT_EQ(depths.background, 0u);
+    ASSERT_EQ(depths.main_thread, 0u);
+}
+
+TYPED_TEST_P(JobSystemTests, idle_policy)
+{
+    for (const auto policy : {iris::IdlePolicy::low_power(), iris::IdlePolicy::low_latency()})
+    {
+        std::atomic<int> counter = 0;
+
+        this->js_.set_idle_policy(policy);
+
+        ASSERT_EQ(this->js_.idle_policy().spin_count, policy.spin_count);
+        ASSERT_EQ(this->js_.idle_policy().yield_count, policy.yield_count);
+
+        // give workers time to go idle under the new policy
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        this->js_.wait_for_jobs({[&counter]() { ++counter; }, [&counter]() { ++counter; }});
+
+        ASSERT_EQ(counter, 2);
+    }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     JobSystemTests,
     add_jobs_single,
     add_jobs_multiple,
     wait_for_jobs_single,
     wait_for_jobs_multiple,
+    wait_for_jobs_fan_out,
+    add_jobs_span,
+    wait_for_jobs_span,
+    wait_for_jobs_span_nested,
     wait_for_jobs_nested,
     wait_for_jobs_sequential,
     exceptions_propagate,
     exceptions_propagate_complex,
-    exceptions_propagate_first_job);
+    exceptions_propagate_first_job,
+    exceptions_propagate_span,
+    add_jobs_priority,
+    wait_for_jobs_priority,
+    add_continuation_jobs,
+    add_continuation_jobs_nested,
+    add_continuation_jobs_exception,
+    add_continuation_jobs_fire_and_forget,
+    main_thread_jobs,
+    queue_depths_idle,
+    idle_policy);
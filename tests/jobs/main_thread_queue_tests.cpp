@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/inline_job.h"
+#include "jobs/job.h"
+#include "jobs/main_thread_queue.h"
+
+TEST(main_thread_queue, constructor)
+{
+    iris::MainThreadQueue queue{};
+
+    ASSERT_EQ(queue.size(), 0u);
+    ASSERT_EQ(queue.run(), 0u);
+}
+
+TEST(main_thread_queue, run_in_order)
+{
+    iris::MainThreadQueue queue{};
+    std::vector<int> order{};
+
+    queue.enqueue({[&order]() { order.emplace_back(1); }, [&order]() { order.emplace_back(2); }});
+
+    std::array<iris::InlineJob, 1u> jobs{{[&order]() { order.emplace_back(3); }}};
+    queue.enqueue(jobs);
+
+    ASSERT_EQ(queue.size(), 3u);
+    ASSERT_EQ(queue.run(), 3u);
+    ASSERT_EQ(queue.size(), 0u);
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(main_thread_queue, jobs_queued_during_run_are_deferred)
+{
+    iris::MainThreadQueue queue{};
+    auto counter = 0;
+
+    queue.enqueue({[&queue, &counter]() {
+        ++counter;
+        queue.enqueue({[&counter]() { ++counter; }});
+    }});
+
+    ASSERT_EQ(queue.run(), 1u);
+    ASSERT_EQ(counter, 1);
+    ASSERT_EQ(queue.size(), 1u);
+
+    ASSERT_EQ(queue.run(), 1u);
+    ASSERT_EQ(counter, 2);
+}
+
+TEST(main_thread_queue, exception_rethrown_after_all_jobs_run)
+{
+    iris::MainThreadQueue queue{};
+    auto counter = 0;
+
+    queue.enqueue(
+        {[]() { throw std::runtime_error(""); },
+         [&counter]() { ++counter; },
+         []() { throw std::logic_error(""); }});
+
+    ASSERT_THROW(queue.run(), std::runtime_error);
+    ASSERT_EQ(counter, 1);
+    ASSERT_EQ(queue.size(), 0u);
+}
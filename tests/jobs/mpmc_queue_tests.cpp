@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+#include "jobs/mpmc_queue.h"
+
+TEST(mpmc_queue, constructor)
+{
+    iris::MpmcQueue<int> q{8u};
+    ASSERT_TRUE(q.empty());
+    ASSERT_EQ(q.size(), 0u);
+    ASSERT_EQ(q.capacity(), 8u);
+}
+
+TEST(mpmc_queue, constructor_invalid_capacity)
+{
+    ASSERT_THROW(iris::MpmcQueue<int>{0u}, iris::Exception);
+    ASSERT_THROW(iris::MpmcQueue<int>{1u}, iris::Exception);
+    ASSERT_THROW(iris::MpmcQueue<int>{6u}, iris::Exception);
+}
+
+TEST(mpmc_queue, enqueue)
+{
+    iris::MpmcQueue<int> q{8u};
+    q.enqueue(1);
+
+    ASSERT_FALSE(q.empty());
+    ASSERT_EQ(q.size(), 1u);
+}
+
+TEST(mpmc_queue, try_dequeue)
+{
+    iris::MpmcQueue<int> q{8u};
+    q.enqueue(1);
+    int value = 0;
+
+    ASSERT_TRUE(q.try_dequeue(value));
+    ASSERT_TRUE(q.empty());
+    ASSERT_EQ(value, 1);
+}
+
+TEST(mpmc_queue, try_dequeue_empty)
+{
+    iris::MpmcQueue<int> q{8u};
+    int value = 0;
+
+    ASSERT_FALSE(q.try_dequeue(value));
+    ASSERT_EQ(value, 0);
+}
+
+TEST(mpmc_queue, try_enqueue_full)
+{
+    iris::MpmcQueue<int> q{4u};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(q.try_enqueue(i));
+    }
+
+    ASSERT_FALSE(q.try_enqueue(4));
+    ASSERT_EQ(q.size(), 4u);
+
+    int value = 0;
+    ASSERT_TRUE(q.try_dequeue(value));
+    ASSERT_TRUE(q.try_enqueue(4));
+}
+
+TEST(mpmc_queue, fifo_across_laps)
+{
+    iris::MpmcQueue<int> q{4u};
+
+    // push more values than the capacity through so every slot is reused several times
+    for (auto i = 0; i < 100; ++i)
+    {
+        q.enqueue(i);
+        q.enqueue(i + 1000);
+
+        ASSERT_EQ(q.dequeue(), i);
+        ASSERT_EQ(q.dequeue(), i + 1000);
+    }
+
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue, destructor_destroys_remaining)
+{
+    auto value = std::make_shared<int>(1);
+
+    {
+        iris::MpmcQueue<std::shared_ptr<int>> q{4u};
+        q.enqueue(value);
+        q.enqueue(value);
+        q.enqueue(value);
+
+        std::shared_ptr<int> popped{};
+        ASSERT_TRUE(q.try_dequeue(popped));
+        ASSERT_EQ(value.use_count(), 4);
+    }
+
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(mpmc_queue, enqueue_thread_safe)
+{
+    static constexpr auto value_count = 10000;
+    iris::MpmcQueue<int> q{16384u};
+    std::vector<int> values(value_count);
+    std::iota(std::begin(values), std::end(values), 0);
+
+    const auto worker = [&q, &values](int start)
+    {
+        for (int i = start; i < start + (value_count / 4); i++)
+        {
+            q.enqueue(values[i]);
+        }
+    };
+
+    std::thread thrd1{worker, (value_count / 4) * 0};
+    std::thread thrd2{worker, (value_count / 4) * 1};
+    std::thread thrd3{worker, (value_count / 4) * 2};
+    std::thread thrd4{worker, (value_count / 4) * 3};
+
+    thrd1.join();
+    thrd2.join();
+    thrd3.join();
+    thrd4.join();
+
+    std::vector<int> popped;
+
+    for (int i = 0; i < value_count; ++i)
+    {
+        int element = 0;
+        ASSERT_TRUE(q.try_dequeue(element));
+        popped.emplace_back(element);
+    }
+
+    std::sort(std::begin(popped), std::end(popped));
+    ASSERT_EQ(popped, values);
+}
+
+TEST(mpmc_queue, enqueue_dequeue_thread_safe)
+{
+    static constexpr auto value_count = 10000;
+    static constexpr auto thread_count = 4;
+
+    // small capacity so producers regularly find the queue full
+    iris::MpmcQueue<int> q{64u};
+    std::atomic<std::int64_t> sum = 0;
+
+    std::vector<std::thread> threads{};
+
+    for (auto i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back(
+            [&q, i]()
+            {
+                for (int j = i; j < value_count; j += thread_count)
+                {
+                    q.enqueue(j);
+                }
+            });
+
+        threads.emplace_back(
+            [&q, &sum]()
+            {
+                std::int64_t local_sum = 0;
+
+                for (int j = 0; j < value_count / thread_count; ++j)
+                {
+                    local_sum += q.dequeue();
+                }
+
+                sum += local_sum;
+            });
+    }
+
+    for (auto &thrd : threads)
+    {
+        thrd.join();
+    }
+
+    ASSERT_TRUE(q.empty());
+    ASSERT_EQ(sum, (static_cast<std::int64_t>(value_count) * (value_count - 1)) / 2);
+}
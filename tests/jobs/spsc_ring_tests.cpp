@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+#include "jobs/spsc_ring.h"
+
+TEST(spsc_ring, constructor)
+{
+    iris::SpscRing<int> ring{8u};
+    ASSERT_TRUE(ring.empty());
+    ASSERT_EQ(ring.size(), 0u);
+    ASSERT_EQ(ring.capacity(), 8u);
+}
+
+TEST(spsc_ring, constructor_invalid_capacity)
+{
+    ASSERT_THROW(iris::SpscRing<int>{0u}, iris::Exception);
+    ASSERT_THROW(iris::SpscRing<int>{1u}, iris::Exception);
+    ASSERT_THROW(iris::SpscRing<int>{12u}, iris::Exception);
+}
+
+TEST(spsc_ring, try_push_try_pop)
+{
+    iris::SpscRing<std::string> ring{8u};
+    ASSERT_TRUE(ring.try_push("hello"));
+    ASSERT_TRUE(ring.try_push(5u, 'a'));
+    ASSERT_EQ(ring.size(), 2u);
+
+    std::string value{};
+    ASSERT_TRUE(ring.try_pop(value));
+    ASSERT_EQ(value, "hello");
+    ASSERT_TRUE(ring.try_pop(value));
+    ASSERT_EQ(value, "aaaaa");
+    ASSERT_FALSE(ring.try_pop(value));
+    ASSERT_TRUE(ring.empty());
+}
+
+TEST(spsc_ring, try_push_full)
+{
+    iris::SpscRing<int> ring{4u};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.try_push(i));
+    }
+
+    ASSERT_FALSE(ring.try_push(4));
+
+    int value = 0;
+    ASSERT_TRUE(ring.try_pop(value));
+    ASSERT_TRUE(ring.try_push(4));
+}
+
+TEST(spsc_ring, push_batch)
+{
+    iris::SpscRing<int> ring{4u};
+    std::array<int, 6u> values{{0, 1, 2, 3, 4, 5}};
+
+    ASSERT_EQ(ring.push(values), 4u);
+    ASSERT_EQ(ring.push(values), 0u);
+
+    std::array<int, 3u> popped{};
+    ASSERT_EQ(ring.pop(popped), 3u);
+    ASSERT_EQ(popped, (std::array<int, 3u>{{0, 1, 2}}));
+
+    // only the remaining values should go in, wrapping around the end of the ring
+    ASSERT_EQ(ring.push(std::span{values}.subspan(4u)), 2u);
+    ASSERT_EQ(ring.size(), 3u);
+
+    ASSERT_EQ(ring.pop(popped), 3u);
+    ASSERT_EQ(popped, (std::array<int, 3u>{{3, 4, 5}}));
+    ASSERT_EQ(ring.pop(popped), 0u);
+}
+
+TEST(spsc_ring, destructor_destroys_remaining)
+{
+    auto value = std::make_shared<int>(1);
+
+    {
+        iris::SpscRing<std::shared_ptr<int>> ring{4u};
+        ring.try_push(value);
+        ring.try_push(value);
+        ring.try_push(value);
+
+        std::shared_ptr<int> popped{};
+        ASSERT_TRUE(ring.try_pop(popped));
+        ASSERT_EQ(value.use_count(), 4);
+    }
+
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(spsc_ring, thread_safe)
+{
+    static constexpr auto value_count = 100000;
+
+    // small capacity so the producer regularly finds the ring full
+    iris::SpscRing<int> ring{16u};
+
+    std::thread producer{[&ring]()
+                         {
+                             std::vector<int> batch(7u);
+                             auto next = 0;
+
+                             while (next < value_count)
+                             {
+                                 auto pushed = 0;
+
+                                 // alternate between single and batch pushes
+                                 if ((next % 2) == 0)
+                                 {
+                                     pushed = ring.try_push(next) ? 1 : 0;
+                                 }
+                                 else
+                                 {
+                                     const auto count = std::min(static_cast<int>(batch.size()), value_count - next);
+                                     std::iota(std::begin(batch), std::begin(batch) + count, next);
+                                     pushed = static_cast<int>(ring.push(std::span{batch}.first(count)));
+                                 }
+
+                                 // ring is full, let the consumer run (which matters if we share a core)
+                                 if (pushed == 0)
+                                 {
+                                     std::this_thread::yield();
+                                 }
+
+                                 next += pushed;
+                             }
+                         }};
+
+    std::vector<int> popped{};
+    std::vector<int> batch(5u);
+
+    while (popped.size() < value_count)
+    {
+        const auto count = ring.pop(batch);
+        popped.insert(std::end(popped), std::begin(batch), std::begin(batch) + count);
+
+        // ring is empty, let the producer run
+        if (count == 0u)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    std::vector<int> expected(value_count);
+    std::iota(std::begin(expected), std::end(expected), 0);
+
+    ASSERT_EQ(popped, expected);
+    ASSERT_TRUE(ring.empty());
+}
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <core/exception.h>
+#include <jobs/task_graph.h>
+
+#include <gtest/gtest.h>
+
+template <class T>
+class TaskGraphTests : public ::testing::Test
+{
+  protected:
+    TaskGraphTests()
+        : jsm_()
+    {
+        jsm_.create_job_system();
+    }
+
+    T jsm_;
+};
+
+TYPED_TEST_SUITE_P(TaskGraphTests);
+
+TYPED_TEST_P(TaskGraphTests, empty)
+{
+    iris::TaskGraph graph{};
+
+    graph.run(this->jsm_);
+
+    ASSERT_EQ(graph.size(), 0u);
+}
+
+TYPED_TEST_P(TaskGraphTests, single_node)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+
+    graph.add_node([&counter]() { ++counter; });
+    graph.run(this->jsm_);
+
+    ASSERT_EQ(graph.size(), 1u);
+    ASSERT_EQ(counter, 1);
+}
+
+TYPED_TEST_P(TaskGraphTests, chain)
+{
+    iris::TaskGraph graph{};
+    std::vector<int> order{};
+
+    const auto a = graph.add_node([&order]() { order.emplace_back(1); });
+    const auto b = graph.add_continuation(a, [&order]() { order.emplace_back(2); });
+    graph.add_continuation(b, [&order]() { order.emplace_back(3); });
+
+    graph.run(this->jsm_);
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TYPED_TEST_P(TaskGraphTests, diamond)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+    auto sink_saw = 0;
+
+    const auto source = graph.add_node([&counter]() { ++counter; });
+    const auto left = graph.add_node([&counter]() { ++counter; });
+    const auto right = graph.add_node([&counter]() { ++counter; });
+    const auto sink = graph.add_node([&counter, &sink_saw]() { sink_saw = counter; });
+
+    graph.add_edge(source, left);
+    graph.add_edge(source, right);
+    graph.add_edge(left, sink);
+    graph.add_edge(right, sink);
+
+    graph.run(this->jsm_);
+
+    ASSERT_EQ(sink_saw, 3);
+}
+
+TYPED_TEST_P(TaskGraphTests, fan_out_fan_in)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+    auto sink_saw = 0;
+
+    const auto source = graph.add_node([]() {});
+    const auto sink = graph.add_node([&counter, &sink_saw]() { sink_saw = counter; });
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        const auto node = graph.add_continuation(source, [&counter]() { ++counter; });
+        graph.add_edge(node, sink);
+    }
+
+    graph.run(this->jsm_);
+
+    ASSERT_EQ(sink_saw, 100);
+}
+
+TYPED_TEST_P(TaskGraphTests, multiple_roots)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        graph.add_node([&counter]() { ++counter; });
+    }
+
+    graph.run(this->jsm_);
+
+    ASSERT_EQ(counter, 10);
+}
+
+TYPED_TEST_P(TaskGraphTests, run_repeatedly)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+    std::vector<int> sink_saw{};
+
+    const auto source = graph.add_node([&counter]() { ++counter; });
+    const auto left = graph.add_continuation(source, [&counter]() { ++counter; });
+    const auto right = graph.add_continuation(source, [&counter]() { ++counter; });
+    const auto sink = graph.add_node([&counter, &sink_saw]() { sink_saw.emplace_back(++counter); });
+    graph.add_edge(left, sink);
+    graph.add_edge(right, sink);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        graph.run(this->jsm_);
+    }
+
+    ASSERT_EQ(counter, 40);
+    ASSERT_EQ(sink_saw, (std::vector<int>{4, 8, 12, 16, 20, 24, 28, 32, 36, 40}));
+}
+
+TYPED_TEST_P(TaskGraphTests, modified_after_run)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+
+    const auto a = graph.add_node([&counter]() { ++counter; });
+    graph.run(this->jsm_);
+
+    graph.add_continuation(a, [&counter]() { ++counter; });
+    graph.run(this->jsm_);
+
+    ASSERT_EQ(counter, 3);
+}
+
+TYPED_TEST_P(TaskGraphTests, nested_in_job)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+
+    const auto a = graph.add_node([&counter]() { ++counter; });
+    graph.add_continuation(a, [&counter]() { ++counter; });
+    graph.add_continuation(a, [&counter]() { ++counter; });
+
+    this->jsm_.wait({[this, &graph]() { graph.run(this->jsm_); }});
+
+    ASSERT_EQ(counter, 3);
+}
+
+TYPED_TEST_P(TaskGraphTests, exception_skips_dependents)
+{
+    iris::TaskGraph graph{};
+    std::atomic<int> counter = 0;
+
+    const auto a = graph.add_node([]() { throw std::runtime_error(""); });
+    graph.add_continuation(a, [&counter]() { ++counter; });
+    graph.add_node([&counter]() { ++counter; });
+
+    ASSERT_THROW(graph.run(this->jsm_), std::runtime_error);
+    ASSERT_EQ(counter, 1);
+}
+
+TYPED_TEST_P(TaskGraphTests, cycle)
+{
+    iris::TaskGraph graph{};
+
+    const auto root = graph.add_node([]() {});
+    const auto a = graph.add_continuation(root, []() {});
+    const auto b = graph.add_continuation(a, []() {});
+    graph.add_edge(b, a);
+
+    ASSERT_THROW(graph.run(this->jsm_), iris::Exception);
+}
+
+TYPED_TEST_P(TaskGraphTests, invalid_edge)
+{
+    iris::TaskGraph graph{};
+
+    const auto a = graph.add_node([]() {});
+
+    ASSERT_THROW(graph.add_edge(a, a + 1u), iris::Exception);
+    ASSERT_THROW(graph.add_edge(a, a), iris::Exception);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(
+    TaskGraphTests,
+    empty,
+    single_node,
+    chain,
+    diamond,
+    fan_out_fan_in,
+    multiple_roots,
+    run_repeatedly,
+    modified_after_run,
+    nested_in_job,
+    exception_skips_dependents,
+    cycle,
+    invalid_edge);
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <jobs/job_system_manager.h>
+#include <jobs/task.h>
+
+#include <gtest/gtest.h>
+
+namespace task_tests
+{
+
+inline iris::Task<int> value(int x)
+{
+    co_return x;
+}
+
+inline iris::Task<int> add(iris::JobSystemManager &jobs, int a, int b)
+{
+    co_await iris::schedule_on(jobs);
+
+    const auto x = co_await value(a);
+    const auto y = co_await value(b);
+
+    co_return x + y;
+}
+
+inline iris::Task<> throws(iris::JobSystemManager &jobs)
+{
+    co_await iris::schedule_on(jobs);
+    throw std::runtime_error("error");
+}
+
+inline iris::Task<std::thread::id> thread_id(iris::JobSystemManager &jobs)
+{
+    co_await iris::schedule_on(jobs);
+    co_return std::this_thread::get_id();
+}
+
+inline iris::Task<std::thread::id> main_thread_id(iris::JobSystemManager &jobs)
+{
+    co_await iris::schedule_on(jobs);
+    co_await iris::switch_to_main_thread(jobs);
+    co_return std::this_thread::get_id();
+}
+
+inline iris::Task<std::string> pipeline(iris::JobSystemManager &jobs, std::vector<std::thread::id> &threads)
+{
+    // "load" on a worker
+    co_await iris::schedule_on(jobs);
+    threads.emplace_back(std::this_thread::get_id());
+    std::string data = "hello";
+
+    // "decode" in parallel
+    std::array<iris::Task<std::string>, 2u> parts{{
+        [](std::string part) -> iris::Task<std::string> { co_return part + "!"; }(data),
+        [](std::string part) -> iris::Task<std::string> { co_return part + "?"; }(data),
+    }};
+    co_await iris::when_all(jobs, std::span{parts});
+
+    const auto decoded = (co_await parts[0]) + (co_await parts[1]);
+
+    // "upload" on the main thread
+    co_await iris::switch_to_main_thread(jobs);
+    threads.emplace_back(std::this_thread::get_id());
+
+    co_return decoded;
+}
+
+}
+
+template <class T>
+class TaskTests : public ::testing::Test
+{
+  protected:
+    TaskTests()
+        : jsm_()
+    {
+        jsm_.create_job_system();
+    }
+
+    T jsm_;
+};
+
+TYPED_TEST_SUITE_P(TaskTests);
+
+TYPED_TEST_P(TaskTests, sync_wait_value)
+{
+    ASSERT_EQ(iris::sync_wait(this->jsm_, task_tests::value(3)), 3);
+}
+
+TYPED_TEST_P(TaskTests, await_children)
+{
+    ASSERT_EQ(iris::sync_wait(this->jsm_, task_tests::add(this->jsm_, 1, 2)), 3);
+}
+
+TYPED_TEST_P(TaskTests, schedule_on_worker)
+{
+    ASSERT_NE(iris::sync_wait(this->jsm_, task_tests::thread_id(this->jsm_)), std::this_thread::get_id());
+}
+
+TYPED_TEST_P(TaskTests, switch_to_main_thread)
+{
+    ASSERT_EQ(iris::sync_wait(this->jsm_, task_tests::main_thread_id(this->jsm_)), std::this_thread::get_id());
+}
+
+TYPED_TEST_P(TaskTests, when_all)
+{
+    auto &jobs = this->jsm_;
+
+    const auto sum = iris::sync_wait(
+        jobs,
+        [](iris::JobSystemManager &jobs) -> iris::Task<int>
+        {
+            std::vector<iris::Task<int>> tasks{};
+            for (auto i = 0; i < 100; ++i)
+            {
+                tasks.emplace_back(task_tests::add(jobs, i, 1));
+            }
+
+            co_await iris::when_all(jobs, std::span{tasks});
+
+            auto sum = 0;
+            for (auto &task : tasks)
+            {
+                EXPECT_TRUE(task.is_done());
+                sum += co_await task;
+            }
+
+            co_return sum;
+        }(jobs));
+
+    ASSERT_EQ(sum, 5050);
+}
+
+TYPED_TEST_P(TaskTests, when_all_empty)
+{
+    auto &jobs = this->jsm_;
+
+    iris::sync_wait(
+        jobs,
+        [](iris::JobSystemManager &jobs) -> iris::Task<>
+        {
+            std::vector<iris::Task<>> tasks{};
+            co_await iris::when_all(jobs, std::span{tasks});
+        }(jobs));
+}
+
+TYPED_TEST_P(TaskTests, exception)
+{
+    ASSERT_THROW(iris::sync_wait(this->jsm_, task_tests::throws(this->jsm_)), std::runtime_error);
+}
+
+TYPED_TEST_P(TaskTests, when_all_exception)
+{
+    auto &jobs = this->jsm_;
+
+    const auto task = [](iris::JobSystemManager &jobs) -> iris::Task<>
+    {
+        std::array<iris::Task<>, 3u> tasks{
+            {task_tests::throws(jobs), task_tests::throws(jobs), task_tests::throws(jobs)}};
+        co_await iris::when_all(jobs, std::span{tasks});
+    };
+
+    ASSERT_THROW(iris::sync_wait(jobs, task(jobs)), std::runtime_error);
+}
+
+TYPED_TEST_P(TaskTests, pipeline)
+{
+    std::vector<std::thread::id> threads{};
+
+    const auto result = iris::sync_wait(this->jsm_, task_tests::pipeline(this->jsm_, threads));
+
+    ASSERT_EQ(result, "hello!hello?");
+    ASSERT_EQ(threads.size(), 2u);
+    ASSERT_NE(threads[0], std::this_thread::get_id());
+    ASSERT_EQ(threads[1], std::this_thread::get_id());
+}
+
+REGISTER_TYPED_TEST_SUITE_P(
+    TaskTests,
+    sync_wait_value,
+    await_children,
+    schedule_on_worker,
+    switch_to_main_thread,
+    when_all,
+    when_all_empty,
+    exception,
+    when_all_exception,
+    pipeline);
@@ -4,8 +4,142 @@
 //                 https://www.boost.org/LICENSE_1_0.txt)                     //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "jobs/job_system_manager_tests.h"
 #include "jobs/job_system_tests.h"
+#include "jobs/task_graph_tests.h"
+#include "jobs/task_tests.h"
 
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "jobs/inline_job.h"
+#include "jobs/job_priority.h"
 #include "jobs/thread/thread_job_system.h"
+#include "jobs/thread/thread_job_system_manager.h"
 
 INSTANTIATE_TYPED_TEST_SUITE_P(thread, JobSystemTests, iris::ThreadJobSystem);
+INSTANTIATE_TYPED_TEST_SUITE_P(thread, JobSystemManagerTests, iris::ThreadJobSystemManager);
+INSTANTIATE_TYPED_TEST_SUITE_P(thread, TaskGraphTests, iris::ThreadJobSystemManager);
+INSTANTIATE_TYPED_TEST_SUITE_P(thread, TaskTests, iris::ThreadJobSystemManager);
+
+TEST(thread_job_system, worker_count)
+{
+    iris::ThreadJobSystem js{3u};
+
+    ASSERT_EQ(js.worker_count(), 3u);
+}
+
+TEST(thread_job_system, nested_wait_single_worker)
+{
+    // the only worker waits on jobs it queued, which it has to run itself
+    iris::ThreadJobSystem js{1u};
+    std::atomic<int> counter = 0;
+
+    js.wait_for_jobs({[&js, &counter]() {
+        js.wait_for_jobs({[&js, &counter]() {
+            js.wait_for_jobs({[&counter]() { ++counter; }, [&counter]() { ++counter; }});
+            ++counter;
+        }});
+        ++counter;
+    }});
+
+    ASSERT_EQ(counter, 4);
+}
+
+TEST(thread_job_system, fire_and_forget_exception)
+{
+    iris::ThreadJobSystem js{1u};
+    std::atomic<bool> done = false;
+
+    js.add_jobs({[]() { throw std::runtime_error(""); }});
+    js.wait_for_jobs({[&done]() { done = true; }});
+
+    ASSERT_TRUE(done);
+}
+
+TEST(thread_job_system, wait_does_not_run_other_jobs)
+{
+    // block the only worker, then queue a job that does not return until we release it, a wait on the main thread
+    // must only run its own job and not pick that one up
+    iris::ThreadJobSystem js{1u};
+    std::atomic<bool> started = false;
+    std::atomic<bool> release = false;
+    std::atomic<bool> done = false;
+
+    const auto block = [&release]()
+    {
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    js.add_jobs({[&started, &block]() {
+        started = true;
+        block();
+    }});
+
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    js.add_jobs({block});
+    js.wait_for_jobs({[&done]() { done = true; }});
+
+    release = true;
+
+    ASSERT_TRUE(done);
+}
+
+TEST(thread_job_system, higher_priority_jobs_run_first)
+{
+    // block the only worker whilst we queue jobs, so they are all waiting when it becomes free
+    iris::ThreadJobSystem js{1u};
+    std::atomic<bool> started = false;
+    std::atomic<bool> release = false;
+    std::atomic<int> counter = 0;
+    std::vector<iris::JobPriority> order{};
+
+    js.add_jobs({[&started, &release]() {
+        started = true;
+        while (!release)
+        {
+        }
+    }});
+
+    while (!started)
+    {
+    }
+
+    const auto record = [&order, &counter](iris::JobPriority priority)
+    {
+        return [&order, &counter, priority]()
+        {
+            order.emplace_back(priority);
+            ++counter;
+        };
+    };
+
+    std::array<iris::InlineJob, 1u> background{{record(iris::JobPriority::BACKGROUND)}};
+    std::array<iris::InlineJob, 1u> normal{{record(iris::JobPriority::NORMAL)}};
+    std::array<iris::InlineJob, 1u> high{{record(iris::JobPriority::HIGH)}};
+
+    js.add_jobs(background, iris::JobPriority::BACKGROUND);
+    js.add_jobs(normal, iris::JobPriority::NORMAL);
+    js.add_jobs(high, iris::JobPriority::HIGH);
+
+    release = true;
+
+    while (counter != 3)
+    {
+    }
+
+    ASSERT_EQ(
+        order,
+        (std::vector<iris::JobPriority>{
+            iris::JobPriority::HIGH, iris::JobPriority::NORMAL, iris::JobPriority::BACKGROUND}));
+}
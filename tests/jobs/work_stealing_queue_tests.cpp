@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/work_stealing_queue.h"
+
+TEST(work_stealing_queue, constructor)
+{
+    iris::WorkStealingQueue<int> q;
+    ASSERT_TRUE(q.empty());
+    ASSERT_EQ(q.size(), 0u);
+}
+
+TEST(work_stealing_queue, push)
+{
+    iris::WorkStealingQueue<int> q;
+    q.push(1);
+
+    ASSERT_FALSE(q.empty());
+    ASSERT_EQ(q.size(), 1u);
+}
+
+TEST(work_stealing_queue, pop_is_lifo)
+{
+    iris::WorkStealingQueue<int> q;
+    q.push(1);
+    q.push(2);
+    int value = 0;
+
+    ASSERT_TRUE(q.pop(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_TRUE(q.pop(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_FALSE(q.pop(value));
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_queue, steal_is_fifo)
+{
+    iris::WorkStealingQueue<int> q;
+    q.push(1);
+    q.push(2);
+    int value = 0;
+
+    ASSERT_TRUE(q.steal(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(q.steal(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_FALSE(q.steal(value));
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_queue, grow)
+{
+    iris::WorkStealingQueue<int> q{2u};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        q.push(i);
+    }
+
+    ASSERT_EQ(q.size(), 100u);
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        int value = -1;
+        ASSERT_TRUE(q.steal(value));
+        ASSERT_EQ(value, i);
+    }
+}
+
+TEST(work_stealing_queue, steal_thread_safe)
+{
+    static constexpr auto value_count = 10000;
+    iris::WorkStealingQueue<int> q{16u};
+    std::vector<int> values(value_count);
+    std::iota(std::begin(values), std::end(values), 0);
+
+    std::atomic<bool> done = false;
+    std::vector<int> popped;
+    std::vector<int> stolen[3];
+
+    const auto thief = [&q, &done](std::vector<int> &out)
+    {
+        int element = 0;
+        while (!done || !q.empty())
+        {
+            if (q.steal(element))
+            {
+                out.emplace_back(element);
+            }
+        }
+    };
+
+    std::thread thrd1{thief, std::ref(stolen[0])};
+    std::thread thrd2{thief, std::ref(stolen[1])};
+    std::thread thrd3{thief, std::ref(stolen[2])};
+
+    // owner interleaves pushes and pops whilst the thieves race it
+    for (const auto value : values)
+    {
+        q.push(value);
+
+        int element = 0;
+        if ((value % 3 == 0) && q.pop(element))
+        {
+            popped.emplace_back(element);
+        }
+    }
+
+    int element = 0;
+    while (q.pop(element))
+    {
+        popped.emplace_back(element);
+    }
+
+    done = true;
+
+    thrd1.join();
+    thrd2.join();
+    thrd3.join();
+
+    for (const auto &s : stolen)
+    {
+        popped.insert(std::end(popped), std::cbegin(s), std::cend(s));
+    }
+
+    std::sort(std::begin(popped), std::end(popped));
+    ASSERT_EQ(popped, values);
+}
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/fiber/worker_stats.h"
+
+using namespace std::chrono_literals;
+
+TEST(worker_stats, queue_wait_bucket_upper_bound)
+{
+    ASSERT_EQ(iris::queue_wait_bucket_upper_bound(0u), 1us);
+    ASSERT_EQ(iris::queue_wait_bucket_upper_bound(1u), 2us);
+    ASSERT_EQ(iris::queue_wait_bucket_upper_bound(10u), 1024us);
+    ASSERT_EQ(
+        iris::queue_wait_bucket_upper_bound(iris::queue_wait_bucket_count - 1u), std::chrono::nanoseconds::max());
+}
+
+TEST(worker_stats, counters_constructor)
+{
+    const iris::WorkerCounters counters{};
+    const auto stats = counters.snapshot();
+
+    ASSERT_EQ(stats.jobs_run, 0u);
+    ASSERT_EQ(stats.busy_time, 0ns);
+    ASSERT_EQ(stats.idle_time, 0ns);
+    ASSERT_EQ(stats.fibers_suspended, 0u);
+    ASSERT_EQ(stats.fibers_resumed, 0u);
+    ASSERT_EQ(stats.steals, 0u);
+
+    for (const auto bucket : stats.queue_wait)
+    {
+        ASSERT_EQ(bucket, 0u);
+    }
+}
+
+TEST(worker_stats, counters_add)
+{
+    iris::WorkerCounters counters{};
+
+    counters.add_job_run();
+    counters.add_job_run();
+    counters.add_busy_time(10ns);
+    counters.add_idle_time(20ns);
+    counters.add_suspend();
+    counters.add_resume();
+    counters.add_steal();
+
+    const auto stats = counters.snapshot();
+
+    ASSERT_EQ(stats.jobs_run, 2u);
+    ASSERT_EQ(stats.busy_time, 10ns);
+    ASSERT_EQ(stats.idle_time, 20ns);
+    ASSERT_EQ(stats.fibers_suspended, 1u);
+    ASSERT_EQ(stats.fibers_resumed, 1u);
+    ASSERT_EQ(stats.steals, 1u);
+}
+
+TEST(worker_stats, counters_queue_wait)
+{
+    iris::WorkerCounters counters{};
+
+    counters.add_queue_wait(500ns);
+    counters.add_queue_wait(1us);
+    counters.add_queue_wait(3us);
+    counters.add_queue_wait(10s);
+
+    const auto stats = counters.snapshot();
+
+    ASSERT_EQ(stats.queue_wait[0u], 1u);
+    ASSERT_EQ(stats.queue_wait[1u], 1u);
+    ASSERT_EQ(stats.queue_wait[2u], 1u);
+    ASSERT_EQ(stats.queue_wait[iris::queue_wait_bucket_count - 1u], 1u);
+}
+
+TEST(worker_stats, trace_record_and_clear)
+{
+    iris::WorkerTrace trace{};
+    const auto now = std::chrono::steady_clock::now();
+
+    trace.record({.fiber = 1u, .begin = now, .end = now + 1us, .resumed = false, .suspended = true});
+    trace.record({.fiber = 1u, .begin = now + 2us, .end = now + 3us, .resumed = true, .suspended = false});
+
+    ASSERT_EQ(trace.events().size(), 2u);
+
+    trace.clear();
+
+    ASSERT_TRUE(trace.events().empty());
+}
+
+TEST(worker_stats, chrome_trace)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const std::vector<std::vector<iris::JobTraceEvent>> traces{
+        {{.fiber = 0xabu, .begin = start + 1500ns, .end = start + 4us, .resumed = false, .suspended = false}}, {}};
+
+    const auto json = iris::to_chrome_trace(traces, start);
+
+    ASSERT_EQ(
+        json,
+        R"({"displayTimeUnit":"ns","traceEvents":[)"
+        R"({"name":"thread_name","ph":"M","pid":0,"tid":0,"args":{"name":"worker 0"}},)"
+        R"({"name":"job","cat":"job","ph":"X","pid":0,"tid":0,"ts":1.500,"dur":2.500,)"
+        R"("args":{"fiber":"ab","resumed":false,"suspended":false}},)"
+        R"({"name":"thread_name","ph":"M","pid":0,"tid":1,"args":{"name":"worker 1"}}]})");
+}
@@ -150,3 +150,33 @@ TEST(unreliable_unordered_channel, out_queue_multi_early_yield)
             std::cbegin(out_packets) + 2u, std::cend(out_packets)));
     ASSERT_TRUE(yielded_packets[3u].empty());
 }
+
+TEST(unreliable_unordered_channel, out_queue_reuse_storage)
+{
+    const auto out_packets = create_packets({
+        {0u, iris::PacketType::DATA},
+        {1u, iris::PacketType::DATA},
+    });
+    iris::UnreliableUnorderedChannel channel{};
+    std::vector<iris::Packet> queue{};
+
+    channel.enqueue_receive(out_packets[0u]);
+    channel.yield_receive_queue(queue);
+    ASSERT_EQ(queue, std::vector<iris::Packet>(std::cbegin(out_packets), std::cbegin(out_packets) + 1u));
+
+    // the channel now holds our old storage, so after a couple of yields the two buffers just swap back and forth
+    channel.enqueue_receive(out_packets[1u]);
+    channel.yield_receive_queue(queue);
+    ASSERT_EQ(queue, std::vector<iris::Packet>(std::cbegin(out_packets) + 1u, std::cend(out_packets)));
+    const auto *storage = queue.data();
+
+    channel.enqueue_receive(out_packets[0u]);
+    channel.yield_receive_queue(queue);
+    channel.enqueue_receive(out_packets[1u]);
+    channel.yield_receive_queue(queue);
+
+    ASSERT_EQ(queue.data(), storage);
+
+    channel.yield_receive_queue(queue);
+    ASSERT_TRUE(queue.empty());
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+// Packs a directory of resources into a single archive for ArchiveResourceManager.
+//
+// usage: iris_packer <resource directory> <archive> [--compress]
+//
+// Each file is added with its path relative to the resource directory (using '/' as a separator), which is the name
+// it should be loaded with. With --compress entries are deflated, unless that doesn't make them smaller.
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "core/data_buffer.h"
+#include "core/exception.h"
+#include "core/resource_archive.h"
+
+namespace
+{
+
+/**
+ * Read a whole file.
+ *
+ * @param path
+ *   File to read.
+ *
+ * @returns
+ *   File contents.
+ */
+iris::DataBuffer read_file(const std::filesystem::path &path)
+{
+    std::ifstream file{path, std::ios::in | std::ios::binary};
+    if (!file.good())
+    {
+        throw iris::Exception("could not open: " + path.string());
+    }
+
+    iris::DataBuffer data(std::filesystem::file_size(path));
+    file.read(reinterpret_cast<char *>(data.data()), data.size());
+
+    return data;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc != 3) && !((argc == 4) && (std::string_view{argv[3]} == "--compress")))
+    {
+        std::cerr << "usage: " << argv[0] << " <resource directory> <archive> [--compress]" << std::endl;
+        return 1;
+    }
+
+    const std::filesystem::path root{argv[1]};
+    const std::filesystem::path archive{argv[2]};
+    const auto compression = (argc == 4) ? iris::ArchiveCompression::DEFLATE : iris::ArchiveCompression::NONE;
+
+    try
+    {
+        iris::ResourceArchiveWriter writer{};
+        std::size_t total_size = 0u;
+
+        for (const auto &entry : std::filesystem::recursive_directory_iterator{root})
+        {
+            if (!entry.is_regular_file())
+            {
+                continue;
+            }
+
+            const auto data = read_file(entry.path());
+            total_size += data.size();
+
+            writer.add(std::filesystem::relative(entry.path(), root).generic_string(), data, compression);
+        }
+
+        writer.write(archive);
+
+        std::cout << "packed " << writer.size() << " files (" << total_size << " bytes) into " << archive.string()
+                  << " (" << std::filesystem::file_size(archive) << " bytes)" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}